@@ -95,6 +95,7 @@ void Sort_param::init_for_filesort(uint sortlen, TABLE *table,
   }
   rec_length= sort_length + (uint)addon_buf.length;
   max_rows= maxrows;
+  max_sort_threads= (uint) table->in_use->variables.max_sort_threads;
 }
 
 
@@ -328,6 +329,8 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
       goto err;
   }
 
+  tracker->report_sort_threads(param.sort_threads);
+
   if (num_rows > param.max_rows)
   {
     // If find_all_keys() produced more results than the query LIMIT.
@@ -2222,3 +2225,14 @@ SORT_INFO::~SORT_INFO()
   free_data();
   DBUG_VOID_RETURN;
 }
+
+
+/**
+   Sort filesort_buffer, and remember how many threads sorted it
+*/
+
+void SORT_INFO::sort_buffer(Sort_param *param, uint count)
+{
+  set_if_bigger(param->sort_threads,
+                filesort_buffer.sort_buffer(param, count));
+}
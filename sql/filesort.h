@@ -128,8 +128,7 @@ class SORT_INFO
   ha_rows   found_rows;         /* How many rows was accepted */
 
   /** Sort filesort_buffer */
-  void sort_buffer(Sort_param *param, uint count)
-  { filesort_buffer.sort_buffer(param, count); }
+  void sort_buffer(Sort_param *param, uint count);
 
   /**
      Accessors for Filesort_buffer (which @c).
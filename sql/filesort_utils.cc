@@ -19,6 +19,10 @@
 #include "sql_const.h"
 #include "sql_sort.h"
 #include "table.h"
+#include "mysqld.h"                             // key_thread_filesort
+#include "queues.h"
+#include "myisampack.h"                         // mi_uint8korr
+#include <atomic>
 
 
 namespace {
@@ -157,21 +161,457 @@ void Filesort_buffer::free_sort_buffer()
 }
 
 
-void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
+/*
+  Sorting of large sort buffers.
+
+  Sorting the pointer array with my_qsort2() visits a random place of the
+  sort buffer and calls a compare function for every comparison. For
+  large buffers, radixsort_for_sort_keys() copies the first 8 bytes of
+  every key next to its pointer, as a big-endian integer that compares
+  like the key. The entries are sorted in place by MSD radix sort on
+  the bytes of this prefix, so that a key is read only once until its
+  prefix is known to be equal to that of other keys. Keys with equal
+  prefixes are ordered by comparing the rest of the keys, and small
+  buckets by insertion sort.
+*/
+
+namespace {
+
+/** Buckets that are smaller than this are sorted by insertion sort */
+const size_t SORT_KEY_REFS_SMALL= 32;
+
+inline int cmp_key_refs(const Sort_key_ref *a, const Sort_key_ref *b,
+                        size_t tail_length)
+{
+  if (a->prefix != b->prefix)
+    return a->prefix < b->prefix ? -1 : 1;
+  return tail_length
+    ? memcmp(a->key + sizeof a->prefix, b->key + sizeof b->prefix,
+             tail_length)
+    : 0;
+}
+
+int cmp_key_ref_tails(const void *tail_length, const void *a, const void *b)
+{
+  return memcmp(static_cast<const Sort_key_ref*>(a)->key + sizeof(ulonglong),
+                static_cast<const Sort_key_ref*>(b)->key + sizeof(ulonglong),
+                *static_cast<const size_t*>(tail_length));
+}
+
+void insertion_sort_key_refs(Sort_key_ref *refs, size_t n,
+                             size_t tail_length)
+{
+  for (size_t i= 1; i < n; i++)
+  {
+    Sort_key_ref ref= refs[i];
+    size_t j= i;
+    for (; j && cmp_key_refs(&ref, &refs[j - 1], tail_length) < 0; j--)
+      refs[j]= refs[j - 1];
+    refs[j]= ref;
+  }
+}
+
+/**
+  Sort key references whose prefixes agree in the bytes before byte.
+
+  @param refs         key references
+  @param n            number of key references
+  @param byte         the most significant byte of the prefix that may differ
+  @param levels       number of prefix bytes that are part of the key
+  @param tail_length  number of bytes of the key after the prefix
+*/
+void sort_key_refs(Sort_key_ref *refs, size_t n, uint byte, uint levels,
+                   size_t tail_length)
+{
+  uint count[256], next[256];
+
+  if (n < SORT_KEY_REFS_SMALL)
+  {
+    insertion_sort_key_refs(refs, n, tail_length);
+    return;
+  }
+
+  /* Skip the bytes that are equal in all prefixes. */
+  for (;; byte++)
+  {
+    if (byte == levels)
+    {
+      if (tail_length)
+        my_qsort2(refs, n, sizeof *refs, cmp_key_ref_tails, &tail_length);
+      return;
+    }
+    const uint shift= 56 - 8 * byte;
+    bzero(count, sizeof count);
+    for (size_t i= 0; i < n; i++)
+      count[uchar(refs[i].prefix >> shift)]++;
+    if (count[uchar(refs[0].prefix >> shift)] != n)
+      break;
+  }
+
+  /* Permute the entries in place into their buckets. */
+  const uint shift= 56 - 8 * byte;
+  uint end[256];
+  for (uint b= 0, pos= 0; b < 256; b++)
+  {
+    next[b]= pos;
+    end[b]= pos+= count[b];
+  }
+  for (uint b= 0; b < 256; b++)
+  {
+    while (next[b] < end[b])
+    {
+      Sort_key_ref ref= refs[next[b]];
+      for (uint d; (d= uchar(ref.prefix >> shift)) != b; )
+        std::swap(ref, refs[next[d]++]);
+      refs[next[b]++]= ref;
+    }
+  }
+
+  for (uint b= 0, pos= 0; b < 256; pos+= count[b++])
+    if (count[b] > 1)
+      sort_key_refs(refs + pos, count[b], byte + 1, levels, tail_length);
+}
+
+} // namespace
+
+
+void radixsort_for_sort_keys(uchar **keys, uint count, size_t sort_length,
+                             Sort_key_ref *buffer)
+{
+  const size_t prefix_length= MY_MIN(sort_length, sizeof buffer->prefix);
+
+  for (uint i= 0; i < count; i++)
+  {
+    uchar prefix[sizeof buffer->prefix]= {0};
+    memcpy(prefix, keys[i], prefix_length);
+    buffer[i].prefix= mi_uint8korr(prefix);
+    buffer[i].key= keys[i];
+  }
+
+  sort_key_refs(buffer, count, 0, uint(prefix_length),
+                sort_length - prefix_length);
+
+  for (uint i= 0; i < count; i++)
+    keys[i]= buffer[i].key;
+}
+
+
+namespace {
+
+/** @return size of the scratch space that sort_keys() uses */
+size_t sort_keys_scratch_size(uint count, size_t sort_length)
+{
+  if (radixsort_is_appliccable(count, sort_length))
+    return count * sizeof(uchar*);
+  if (count >= MIN_KEYS_FOR_PREFIX_SORT)
+    return count * sizeof(Sort_key_ref);
+  return 0;
+}
+
+/**
+  Sort pointers to keys with the method that suits their number and length.
+  radixsort_for_str_ptr() is preferred where it applies, because it keeps
+  equal keys in their original order.
+
+  @param scratch  sort_keys_scratch_size() bytes, or NULL
+*/
+void sort_keys(uchar **keys, uint count, size_t sort_length, void *scratch)
+{
+  if (scratch && radixsort_is_appliccable(count, sort_length))
+    radixsort_for_str_ptr(keys, count, sort_length,
+                          static_cast<uchar**>(scratch));
+  else if (scratch && count >= MIN_KEYS_FOR_PREFIX_SORT)
+    radixsort_for_sort_keys(keys, count, sort_length,
+                            static_cast<Sort_key_ref*>(scratch));
+  else
+    my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(sort_length),
+              &sort_length);
+}
+
+} // namespace
+
+
+/*
+  Parallel sorting of the key pointer array.
+
+  The array is divided into one chunk per thread, and each thread sorts
+  its chunk. Then the key range is divided by splitter keys that are
+  sampled from the sorted chunks, and each thread merges the parts of
+  all chunks that fall into its key range into its own part of the
+  output. The keys are only compared by the threads, so they need
+  no THD.
+*/
+
+namespace {
+
+/** A sorted part of the key pointer array */
+struct Sort_chunk
+{
+  uchar **pos;
+  uchar **end;
+};
+
+/** Work of one thread of sort_keys_in_parallel() */
+struct Sort_thread
+{
+  void (*work)(Sort_thread *);
+  size_t sort_length;
+  /** Keys to sort */
+  uchar **keys;
+  uint count;
+  /** Scratch space for sort_keys() */
+  void *scratch;
+  /** The parts of all chunks that fall into the key range of the thread */
+  Sort_chunk *chunks;
+  uint n_chunks;
+  /** Output of the merge */
+  uchar **out;
+  QUEUE queue;
+};
+
+/** Samples taken from each sorted chunk for choosing the splitter keys */
+const uint SORT_THREAD_SAMPLES= 8;
+
+void sort_chunk(Sort_thread *t)
+{
+  sort_keys(t->keys, t->count, t->sort_length, t->scratch);
+}
+
+int sort_chunk_cmp(void *arg, uchar *a, uchar *b)
+{
+  return memcmp(*reinterpret_cast<Sort_chunk*>(a)->pos,
+                *reinterpret_cast<Sort_chunk*>(b)->pos,
+                *static_cast<size_t*>(arg));
+}
+
+void merge_chunks(Sort_thread *t)
+{
+  uchar **out= t->out;
+  for (uint i= 0; i < t->n_chunks; i++)
+    if (t->chunks[i].pos != t->chunks[i].end)
+      queue_insert(&t->queue, reinterpret_cast<uchar*>(&t->chunks[i]));
+
+  while (!queue_empty(&t->queue))
+  {
+    Sort_chunk *chunk= reinterpret_cast<Sort_chunk*>(queue_top(&t->queue));
+    *out++= *chunk->pos++;
+    if (chunk->pos == chunk->end)
+      queue_remove_top(&t->queue);
+    else
+      queue_replace_top(&t->queue);
+  }
+}
+
+/** @return the first key in [begin,end) that is not less than key */
+uchar **lower_bound(uchar **begin, uchar **end, const uchar *key,
+                    size_t sort_length)
+{
+  while (begin < end)
+  {
+    uchar **mid= begin + (end - begin) / 2;
+    if (memcmp(*mid, key, sort_length) < 0)
+      begin= mid + 1;
+    else
+      end= mid;
+  }
+  return begin;
+}
+
+void *sort_thread(void *arg)
+{
+  Sort_thread *t= static_cast<Sort_thread*>(arg);
+  my_thread_init();
+  t->work(t);
+  my_thread_end();
+  return NULL;
+}
+
+/**
+  Run work on n threads, the first of them being the caller.
+  If a thread cannot be created, the caller does its work.
+*/
+void run_sort_threads(Sort_thread *threads, uint n,
+                      void (*work)(Sort_thread *))
+{
+  pthread_t handles[MAX_SORT_THREADS];
+  bool started[MAX_SORT_THREADS];
+
+  for (uint i= 1; i < n; i++)
+  {
+    threads[i].work= work;
+    started[i]= !mysql_thread_create(key_thread_filesort, &handles[i],
+                                     &sort_thread_attrib, sort_thread,
+                                     &threads[i]);
+  }
+  work(&threads[0]);
+  for (uint i= 1; i < n; i++)
+  {
+    if (started[i])
+      pthread_join(handles[i], NULL);
+    else
+      work(&threads[i]);
+  }
+}
+
+/**
+  Sort keys with several threads.
+
+  @param keys         keys to sort
+  @param count        number of keys
+  @param sort_length  length of a key
+  @param scratch      scratch space for count keys
+  @param n            number of threads
+
+  @return whether the keys were sorted
+*/
+bool sort_keys_in_parallel(uchar **keys, uint count, size_t sort_length,
+                           Sort_key_ref *scratch, uint n)
+{
+  uchar **buffer= reinterpret_cast<uchar**>(scratch);
+  Sort_thread threads[MAX_SORT_THREADS];
+  uchar *samples[MAX_SORT_THREADS * SORT_THREAD_SAMPLES];
+  uchar **chunk_start[MAX_SORT_THREADS + 1];
+  Sort_chunk *chunks;
+
+  DBUG_ASSERT(n > 1);
+  DBUG_ASSERT(n <= MAX_SORT_THREADS);
+  DBUG_ASSERT(count >= n * SORT_THREAD_SAMPLES);
+
+  if (!(chunks= (Sort_chunk*) my_malloc(n * n * sizeof *chunks,
+                                        MYF(MY_THREAD_SPECIFIC))))
+    return false;
+
+  for (uint i= 0; i < n; i++)
+  {
+    threads[i].sort_length= sort_length;
+    threads[i].chunks= chunks + i * n;
+    threads[i].n_chunks= n;
+    if (init_queue(&threads[i].queue, n, 0, 0, sort_chunk_cmp,
+                   &threads[i].sort_length, 0, 0))
+    {
+      while (i--)
+        delete_queue(&threads[i].queue);
+      my_free(chunks);
+      return false;
+    }
+  }
+
+  /* Sort the chunks. */
+  for (uint i= 0; i <= n; i++)
+    chunk_start[i]= keys + ulonglong(count) * i / n;
+  for (uint i= 0; i < n; i++)
+  {
+    threads[i].keys= chunk_start[i];
+    threads[i].count= uint(chunk_start[i + 1] - chunk_start[i]);
+    threads[i].scratch= scratch + (chunk_start[i] - keys);
+  }
+  run_sort_threads(threads, n, sort_chunk);
+
+  /* Choose n-1 splitter keys from evenly spaced samples of the chunks. */
+  uint n_samples= 0;
+  for (uint i= 0; i < n; i++)
+    for (uint j= 0; j < SORT_THREAD_SAMPLES; j++)
+      samples[n_samples++]= threads[i].keys[ulonglong(threads[i].count) *
+                                            (2 * j + 1) /
+                                            (2 * SORT_THREAD_SAMPLES)];
+  my_qsort2(samples, n_samples, sizeof(uchar*),
+            get_ptr_compare(sort_length), &sort_length);
+
+  /* Assign to thread j the keys from splitter j-1 up to splitter j. */
+  uchar **out= buffer;
+  for (uint j= 0; j < n; j++)
+  {
+    threads[j].out= out;
+    for (uint i= 0; i < n; i++)
+    {
+      uchar **begin= chunk_start[i], **end= chunk_start[i + 1];
+      Sort_chunk *chunk= &threads[j].chunks[i];
+      chunk->pos= j ? threads[j - 1].chunks[i].end : begin;
+      chunk->end= j == n - 1
+        ? end
+        : lower_bound(chunk->pos, end,
+                      samples[(j + 1) * SORT_THREAD_SAMPLES], sort_length);
+      out+= chunk->end - chunk->pos;
+    }
+  }
+  DBUG_ASSERT(out == buffer + count);
+
+  run_sort_threads(threads, n, merge_chunks);
+  memcpy(keys, buffer, count * sizeof *keys);
+
+  for (uint i= 0; i < n; i++)
+    delete_queue(&threads[i].queue);
+  my_free(chunks);
+  return true;
+}
+
+/**
+  Helper threads of all parallel sorts of the server. max_sort_threads
+  limits one sort; the total is limited to the number of CPUs, as more
+  threads than that would not sort any faster.
+*/
+std::atomic<uint32> sort_helper_threads;
+
+/**
+  Reserve helper threads for a parallel sort.
+  @param wanted  number of threads wanted
+  @return number of threads reserved, to be passed to release_sort_threads()
+*/
+uint reserve_sort_threads(uint wanted)
+{
+  const uint32 limit= uint32(my_getncpus());
+  uint32 running= sort_helper_threads.load(std::memory_order_relaxed);
+  uint32 got;
+  do
+  {
+    if (running >= limit)
+      return 0;
+    got= MY_MIN(wanted, limit - running);
+  }
+  while (!sort_helper_threads.compare_exchange_weak(running, running + got,
+                                                    std::memory_order_relaxed));
+  return got;
+}
+
+void release_sort_threads(uint n)
+{
+  sort_helper_threads.fetch_sub(n, std::memory_order_relaxed);
+}
+
+} // namespace
+
+
+uint Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
 {
   size_t size= param->sort_length;
   if (count <= 1 || size == 0)
-    return;
+    return 1;
   uchar **keys= get_sort_keys();
-  uchar **buffer= NULL;
-  if (radixsort_is_appliccable(count, param->sort_length) &&
-      (buffer= (uchar**) my_malloc(count*sizeof(char*),
-                                   MYF(MY_THREAD_SPECIFIC))))
+  void *scratch;
+  uint threads= MY_MIN(param->max_sort_threads,
+                       count / MIN_KEYS_PER_SORT_THREAD);
+
+  if (threads > 1 && (threads= 1 + reserve_sort_threads(threads - 1)) > 1)
   {
-    radixsort_for_str_ptr(keys, count, param->sort_length, buffer);
-    my_free(buffer);
-    return;
+    bool sorted= false;
+    if ((scratch= my_malloc(count * sizeof(Sort_key_ref),
+                            MYF(MY_THREAD_SPECIFIC))))
+    {
+      sorted= sort_keys_in_parallel(keys, count, size,
+                                    static_cast<Sort_key_ref*>(scratch),
+                                    threads);
+      my_free(scratch);
+    }
+    release_sort_threads(threads - 1);
+    if (sorted)
+      return threads;
   }
-  
-  my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(size), &size);
+
+  size_t scratch_size= sort_keys_scratch_size(count, size);
+  scratch= scratch_size
+    ? my_malloc(scratch_size, MYF(MY_THREAD_SPECIFIC))
+    : NULL;
+  sort_keys(keys, count, size, scratch);
+  my_free(scratch);
+  return 1;
 }
@@ -20,6 +20,36 @@
 #include "sql_array.h"
 
 class Sort_param;
+
+/**
+  A key of a sort buffer, as sorted by radixsort_for_sort_keys():
+  the first bytes of the key as an integer that compares like the key,
+  followed by a pointer to the key.
+*/
+struct Sort_key_ref
+{
+  ulonglong prefix;
+  uchar *key;
+};
+
+/* Minimum number of keys for which radixsort_for_sort_keys() is used */
+#define MIN_KEYS_FOR_PREFIX_SORT 10000
+
+/*
+  Sort an array of pointers to keys of equal length, comparing the keys
+  with memcmp().
+
+    @param keys         pointers to the keys
+    @param count        number of keys
+    @param sort_length  length of a key
+    @param buffer       scratch space for count entries
+
+  @note
+    Declared here in order to be able to unit test it.
+*/
+void radixsort_for_sort_keys(uchar **keys, uint count, size_t sort_length,
+                             Sort_key_ref *buffer);
+
 /*
   Calculate cost of merge sort
 
@@ -77,8 +107,11 @@ class Filesort_buffer
     m_idx_array.reset();
   }
 
-  /** Sort me... */
-  void sort_buffer(const Sort_param *param, uint count);
+  /**
+    Sort me...
+    @return number of threads that were used
+  */
+  uint sort_buffer(const Sort_param *param, uint count);
 
   /// Initializes a record pointer.
   uchar *get_record_buffer(uint idx)
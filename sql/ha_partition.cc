@@ -77,7 +77,8 @@
                                         HA_DUPLICATE_POS | \
                                         HA_CAN_INSERT_DELAYED | \
                                         HA_READ_BEFORE_WRITE_REMOVAL |\
-                                        HA_CAN_TABLES_WITHOUT_ROLLBACK)
+                                        HA_CAN_TABLES_WITHOUT_ROLLBACK |\
+                                        HA_CAN_READ_BATCH)
 
 static const char *ha_par_ext= ".par";
 
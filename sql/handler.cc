@@ -2942,6 +2942,24 @@ int handler::ha_rnd_next(uchar *buf)
   DBUG_RETURN(result);
 }
 
+int handler::ha_read_next_batch(uchar *buf, uint max_rows, uint *n_rows)
+{
+  int result;
+  DBUG_ENTER("handler::ha_read_next_batch");
+  DBUG_ASSERT(table_share->tmp_table != NO_TMP_TABLE ||
+              m_lock_type != F_UNLCK);
+  DBUG_ASSERT(inited == RND || inited == INDEX);
+  DBUG_ASSERT(ha_table_flags() & HA_CAN_READ_BATCH);
+  DBUG_ASSERT(max_rows);
+
+  TABLE_IO_WAIT(tracker, m_psi, PSI_TABLE_FETCH_ROW,
+                inited == INDEX ? active_index : MAX_KEY, 0,
+    { result= read_next_batch(buf, max_rows, n_rows); })
+  DBUG_ASSERT(*n_rows <= max_rows);
+  DBUG_ASSERT(*n_rows || result);
+  DBUG_RETURN(result);
+}
+
 int handler::ha_rnd_pos(uchar *buf, uchar *pos)
 {
   int result;
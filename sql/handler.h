@@ -339,7 +339,13 @@ enum enum_alter_inplace_result {
 */
 #define HA_NON_COMPARABLE_ROWID (1ULL << 59)
 
-#define HA_LAST_TABLE_FLAG HA_NON_COMPARABLE_ROWID
+/*
+  The engine implements read_next_batch(), which returns several rows of
+  a table scan or a forward index scan in one call.
+*/
+#define HA_CAN_READ_BATCH (1ULL << 60)
+
+#define HA_LAST_TABLE_FLAG HA_CAN_READ_BATCH
 
 /* bits in index_flags(index_number) for what you can do with index */
 #define HA_READ_NEXT            1       /* TODO really use this flag */
@@ -3447,6 +3453,14 @@ class handler :public Sql_alloc
   */
   virtual int pre_records() { return 0; }
   virtual ha_rows records() { return stats.records; }
+  /**
+    Count the rows for SELECT COUNT(*) without a WHERE clause. Called
+    when records() is not exact, by engines that can count the rows
+    faster than reading them through the handler interface.
+
+    @return number of rows, or HA_POS_ERROR to read the rows
+  */
+  virtual ha_rows records_for_count() { return HA_POS_ERROR; }
   /**
     Return upper bound of current number of records in the table
     (max. of how many records one will retrieve when doing a full table scan)
@@ -3749,6 +3763,22 @@ class handler :public Sql_alloc
     return error;
   }
   virtual int read_first_row(uchar *buf, uint primary_key);
+  /**
+    Read the rows that follow the current row of a table scan (rnd_next())
+    or of a forward index scan (index_next()). Only used for engines
+    that set HA_CAN_READ_BATCH.
+
+    @param buf       buffer for max_rows rows, table->s->reclength apart
+    @param max_rows  maximum number of rows to read
+    @param n_rows    number of rows that were read into buf
+
+    @retval 0                    *n_rows > 0 rows were read
+    @retval HA_ERR_WRONG_COMMAND the scan cannot return rows in batches;
+                                 continue with rnd_next() or index_next()
+    @retval other                end of scan or error, after *n_rows rows
+  */
+  virtual int read_next_batch(uchar *buf, uint max_rows, uint *n_rows)
+  { *n_rows= 0; return HA_ERR_WRONG_COMMAND; }
 public:
 
   /* Same as above, but with statistics */
@@ -3758,6 +3788,13 @@ class handler :public Sql_alloc
   int ha_rnd_pos(uchar *buf, uchar *pos);
   inline int ha_rnd_pos_by_record(uchar *buf);
   inline int ha_read_first_row(uchar *buf, uint primary_key);
+  int ha_read_next_batch(uchar *buf, uint max_rows, uint *n_rows);
+  /**
+    Account for a row that ha_read_next_batch() returned when the caller
+    copies it to record[0], or for the error that ended the batch, as if
+    it had been returned by ha_rnd_next() or ha_index_next().
+  */
+  inline void ha_read_batch_row(int error);
 
   /**
     The following 2 function is only needed for tables that may be
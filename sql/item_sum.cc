@@ -2360,10 +2360,160 @@ void Item_sum_min_max::clear()
   DBUG_ENTER("Item_sum_min_max::clear");
   value->clear();
   null_value= 1;
+  if (window_deque)
+    clear_as_window();
   DBUG_VOID_RETURN;
 }
 
 
+/*
+  As a window function, MIN/MAX sees the frame as a queue: frame bounds
+  add rows in the order of the partition, and remove them in the same
+  order. Instead of scanning the whole frame for every row, keep a deque
+  of the rows that can still become the result: a value is dropped as
+  soon as a later value in the frame is better than it. The front of the
+  deque is the result, and every row enters and leaves it at most once.
+
+  Frames that start at UNBOUNDED PRECEDING never remove a row. The deque
+  would only grow with the partition there, so add() keeps the result
+  as it does for GROUP BY.
+*/
+
+void Item_sum_min_max::setup_window_func(THD *thd, Window_spec *window_spec)
+{
+  Window_frame *frame= window_spec->window_frame;
+
+  as_window_function= TRUE;
+  window_deque= FALSE;
+  if (!frame ||
+      (frame->top_bound->precedence_type == Window_frame_bound::PRECEDING &&
+       frame->top_bound->is_unbounded()))
+    return;
+
+  window_values= NULL;
+  window_rownums= NULL;
+  window_capacity= 0;
+  window_back= value;
+  if (!(window_cmp= new (thd->mem_root) Arg_comparator()))
+  {
+    /* Scan the frame for every row instead */
+    as_window_function= FALSE;
+    return;
+  }
+  window_cmp->set_cmp_func(this, (Item**) &arg_cache, (Item**) &window_back,
+                           FALSE);
+  window_deque= TRUE;
+  clear_as_window();
+}
+
+
+void Item_sum_min_max::clear_as_window()
+{
+  window_first= window_elements= 0;
+  window_added= window_removed= 0;
+}
+
+
+/* Make the value at the front of the deque the result */
+
+void Item_sum_min_max::set_window_result()
+{
+  value->store(window_values[window_first]);
+  value->cache_value();
+  null_value= 0;
+}
+
+
+/* Double the capacity of the deque, reusing the caches it has */
+
+bool Item_sum_min_max::grow_window()
+{
+  THD *thd= current_thd;
+  uint capacity= window_capacity ? window_capacity * 2 : 16;
+  Item_cache **values;
+  ulonglong *rownums;
+
+  if (!multi_alloc_root(thd->mem_root,
+                        &values, sizeof(Item_cache*) * capacity,
+                        &rownums, sizeof(ulonglong) * capacity,
+                        NullS))
+    return true;
+  for (uint i= 0; i < window_capacity; i++)
+  {
+    values[i]= window_values[window_slot(i)];
+    rownums[i]= window_rownums[window_slot(i)];
+  }
+  for (uint i= window_capacity; i < capacity; i++)
+  {
+    if (!(values[i]= args[0]->get_cache(thd)))
+      return true;
+    values[i]->setup(thd, args[0]);
+    /* See setup_hybrid() */
+    if (!args[0]->const_item())
+      values[i]->set_used_tables(RAND_TABLE_BIT);
+  }
+  window_values= values;
+  window_rownums= rownums;
+  window_capacity= capacity;
+  window_first= 0;
+  return false;
+}
+
+
+bool Item_sum_min_max::add_as_window()
+{
+  ulonglong rownum= window_added++;
+
+  arg_cache->cache_value();
+  /* A frame whose top is below its bottom may remove a row before adding it */
+  if (arg_cache->null_value || rownum < window_removed)
+    return false;
+  /* Drop the values that are worse than this one, they can't be a result */
+  while (window_elements)
+  {
+    window_back= window_values[window_slot(window_elements - 1)];
+    if (window_cmp->compare() * cmp_sign >= 0)
+      break;
+    window_elements--;
+  }
+  if (window_elements == window_capacity && grow_window())
+    return true;
+
+  uint slot= window_slot(window_elements++);
+  window_values[slot]->store(arg_cache);
+  window_values[slot]->cache_value();
+  window_rownums[slot]= rownum;
+  if (window_elements == 1)
+    set_window_result();
+  return false;
+}
+
+
+void Item_sum_min_max::remove_as_window()
+{
+  ulonglong rownum= window_removed++;
+
+  /* The front holds the earliest row of the deque */
+  if (!window_elements || window_rownums[window_first] != rownum)
+    return;
+  window_first= window_slot(1);
+  if (--window_elements)
+    set_window_result();
+  else
+  {
+    value->clear();
+    null_value= 1;
+  }
+}
+
+
+void Item_sum_min_max::remove()
+{
+  DBUG_ASSERT(window_deque);
+  remove_as_window();
+}
+
+
 bool
 Item_sum_min_max::get_date(THD *thd, MYSQL_TIME *ltime, date_mode_t fuzzydate)
 {
@@ -2455,6 +2605,7 @@ void Item_sum_min_max::cleanup()
   if (cmp)
     delete cmp;
   cmp= 0;
+  as_window_function= window_deque= FALSE;
   /*
     by default it is TRUE to avoid TRUE reporting by
     Item_func_not_all/Item_func_nop_all if this item was never called.
@@ -2504,6 +2655,9 @@ bool Item_sum_min::add()
   DBUG_ENTER("Item_sum_min::add");
   DBUG_PRINT("enter", ("this: %p", this));
 
+  if (window_deque)
+    DBUG_RETURN(add_as_window());
+
   if (unlikely(direct_added))
   {
     /* Change to use direct_item */
@@ -2544,6 +2698,9 @@ bool Item_sum_max::add()
   DBUG_ENTER("Item_sum_max::add");
   DBUG_PRINT("enter", ("this: %p", this));
 
+  if (window_deque)
+    DBUG_RETURN(add_as_window());
+
   if (unlikely(direct_added))
   {
     /* Change to use direct_item */
@@ -1117,17 +1117,41 @@ class Item_sum_min_max :public Item_sum_hybrid
   int cmp_sign;
   bool was_values;  // Set if we have found at least one row (for max/min only)
   bool was_null_value;
+  /*
+    Marks whether the function is to be computed as a window function.
+    If the frame start can move, the frame is a queue of rows, and
+    window_values keeps those of them that can still become the result,
+    see add_as_window().
+  */
+  bool as_window_function;
+  bool window_deque;
+  Item_cache *window_back;
+  Arg_comparator *window_cmp;   // Compares arg_cache with window_back
+  Item_cache **window_values;
+  ulonglong *window_rownums;
+  uint window_capacity, window_first, window_elements;
+  ulonglong window_added, window_removed;
+
+  uint window_slot(uint i) const
+  { return (window_first + i) & (window_capacity - 1); }
+  bool add_as_window();
+  void remove_as_window();
+  void clear_as_window();
+  bool grow_window();
+  void set_window_result();
 
 public:
   Item_sum_min_max(THD *thd, Item *item_par,int sign):
     Item_sum_hybrid(thd, item_par),
     direct_added(FALSE), value(0), arg_cache(0), cmp(0),
-    cmp_sign(sign), was_values(TRUE)
+    cmp_sign(sign), was_values(TRUE), as_window_function(FALSE),
+    window_deque(FALSE)
   { collation.set(&my_charset_bin); }
   Item_sum_min_max(THD *thd, Item_sum_min_max *item)
     :Item_sum_hybrid(thd, item),
     direct_added(FALSE), value(item->value), arg_cache(0),
-    cmp_sign(item->cmp_sign), was_values(item->was_values)
+    cmp_sign(item->cmp_sign), was_values(item->was_values),
+    as_window_function(FALSE), window_deque(FALSE)
   { }
   bool fix_fields(THD *, Item **);
   bool fix_length_and_dec();
@@ -1158,6 +1182,9 @@ class Item_sum_min_max :public Item_sum_hybrid
   void restore_to_before_no_rows_in_result();
   Field *create_tmp_field(bool group, TABLE *table);
   void setup_caches(THD *thd) { setup_hybrid(thd, arguments()[0], NULL); }
+  void setup_window_func(THD *thd, Window_spec *window_spec);
+  void remove();
+  bool supports_removal() const { return as_window_function; }
 };
 
 
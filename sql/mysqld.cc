@@ -731,6 +731,7 @@ mysql_prlock_t LOCK_system_variables_hash;
 mysql_cond_t COND_start_thread;
 pthread_t signal_thread;
 pthread_attr_t connection_attrib;
+pthread_attr_t sort_thread_attrib;
 mysql_mutex_t LOCK_server_started;
 mysql_cond_t COND_server_started;
 
@@ -1099,7 +1100,7 @@ PSI_thread_key key_thread_delayed_insert,
   key_thread_handle_manager, key_thread_main,
   key_thread_one_connection, key_thread_signal_hand,
   key_thread_slave_background, key_rpl_parallel_thread;
-PSI_thread_key key_thread_ack_receiver;
+PSI_thread_key key_thread_ack_receiver, key_thread_filesort;
 
 static PSI_thread_info all_server_threads[]=
 {
@@ -1110,7 +1111,8 @@ static PSI_thread_info all_server_threads[]=
   { &key_thread_signal_hand, "signal_handler", PSI_FLAG_GLOBAL},
   { &key_thread_slave_background, "slave_background", PSI_FLAG_GLOBAL},
   { &key_thread_ack_receiver, "Ack_receiver", PSI_FLAG_GLOBAL},
-  { &key_rpl_parallel_thread, "rpl_parallel_thread", 0}
+  { &key_rpl_parallel_thread, "rpl_parallel_thread", 0},
+  { &key_thread_filesort, "filesort", 0}
 };
 
 #ifdef HAVE_MMAP
@@ -4625,6 +4627,11 @@ static int init_thread_environment()
   (void) pthread_attr_setdetachstate(&connection_attrib,
 				     PTHREAD_CREATE_DETACHED);
   pthread_attr_setscope(&connection_attrib, PTHREAD_SCOPE_SYSTEM);
+  /* Parameter for the helper threads of a parallel filesort */
+  (void) pthread_attr_init(&sort_thread_attrib);
+  (void) pthread_attr_setdetachstate(&sort_thread_attrib,
+                                     PTHREAD_CREATE_JOINABLE);
+  pthread_attr_setscope(&sort_thread_attrib, PTHREAD_SCOPE_SYSTEM);
 
 #ifdef HAVE_REPLICATION
   rpl_init_gtid_slave_state();
@@ -5742,6 +5749,7 @@ int mysqld_main(int argc, char **argv)
                                          (size_t)my_thread_stack_size);
   if (new_thread_stack_size != my_thread_stack_size)
     SYSVAR_AUTOSIZE(my_thread_stack_size, new_thread_stack_size);
+  (void) my_setstacksize(&sort_thread_attrib, (size_t)my_thread_stack_size);
 
   (void) thr_setconcurrency(concurrency);	// 10 by default
 
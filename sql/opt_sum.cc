@@ -69,8 +69,8 @@ static int maxmin_in_range(bool max_fl, Field* field, COND *cond);
     tables		List of tables
 
   NOTES
-    When this is called, we know all table handlers supports HA_HAS_RECORDS
-    or HA_STATS_RECORDS_IS_EXACT
+    Table handlers that support neither HA_HAS_RECORDS nor
+    HA_STATS_RECORDS_IS_EXACT are asked for records_for_count()
 
   RETURN
     ULONGLONG_MAX	Error: Could not calculate number of rows
@@ -84,7 +84,10 @@ static ulonglong get_exact_record_count(List<TABLE_LIST> &tables)
   List_iterator<TABLE_LIST> ti(tables);
   while ((tl= ti++))
   {
-    ha_rows tmp= tl->table->file->records();
+    handler *file= tl->table->file;
+    ha_rows tmp= (file->ha_table_flags() &
+                  (HA_HAS_RECORDS | HA_STATS_RECORDS_IS_EXACT)) ?
+                 file->records() : file->records_for_count();
     if (tmp == HA_POS_ERROR)
       return ULONGLONG_MAX;
     count*= tmp;
@@ -298,9 +301,7 @@ int opt_sum_query(THD *thd,
     if (!(tl->table->file->ha_table_flags() & HA_STATS_RECORDS_IS_EXACT) ||
         tl->schema_table)
     {
-      maybe_exact_count&= MY_TEST(!tl->schema_table &&
-                                  (tl->table->file->ha_table_flags() &
-                                   HA_HAS_RECORDS));
+      maybe_exact_count&= MY_TEST(!tl->schema_table);
       is_exact_count= FALSE;
       count= 1;                                 // ensure count != 0
     }
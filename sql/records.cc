@@ -286,6 +286,7 @@ bool init_read_record(READ_RECORD *info,THD *thd, TABLE *table,
         table->file->print_error(error, MYF(0));
       DBUG_RETURN(1);
     }
+    info->init_batch();
   }
   else
   {
@@ -293,6 +294,7 @@ bool init_read_record(READ_RECORD *info,THD *thd, TABLE *table,
     info->read_record_func= rr_sequential;
     if (unlikely(table->file->ha_rnd_init_with_error(1)))
       DBUG_RETURN(1);
+    info->init_batch();
     /* We can use record cache if we don't update dynamic length tables */
     if (!table->no_cache &&
 	(use_record_cache > 0 ||
@@ -337,6 +339,109 @@ void free_cache(READ_RECORD *info)
     my_free_lock(info->cache);
     info->cache=0;
   }
+  info->batch_max= 0;
+}
+
+
+/**
+  Prepare to read the rows of a table scan or of a forward index scan in
+  batches, if the storage engine supports it.
+
+  The first MIN_ROWS_TO_USE_READ_BATCH rows are read one at a time, so
+  that short scans and scans that are stopped early do not read ahead.
+  Rows are not read ahead for tables that will be modified or locked by
+  the statement, because the handler must then be positioned on the
+  current row, nor for tables with virtual columns, which are computed
+  when each row is read.
+*/
+
+void READ_RECORD::init_batch()
+{
+  batch_max= batch_rows= batch_pos= 0;
+  batch_error= 0;
+  batch_countdown= MIN_ROWS_TO_USE_READ_BATCH;
+
+  if (!(table->file->ha_table_flags() & HA_CAN_READ_BATCH) ||
+      table->vfield ||
+      table->reginfo.lock_type > TL_READ_NO_INSERT)
+    return;
+
+  uint reclength= table->s->reclength;
+  uint max_rows= (uint) MY_MIN(READ_BATCH_MAX_ROWS,
+                               READ_BATCH_MAX_SIZE / reclength);
+  if (max_rows < 2)
+    return;
+
+  if (!table->read_batch_buf)
+  {
+    /* Rows keep the default values of the columns that are not read */
+    uchar *buf= (uchar*) alloc_root(&table->mem_root, max_rows * reclength);
+    if (!buf)
+      return;
+    for (uint i= 0; i < max_rows; i++)
+      memcpy(buf + i * reclength, table->s->default_values, reclength);
+    table->read_batch_buf= buf;
+  }
+
+  batch_max= max_rows;
+}
+
+
+/**
+  Copy the next row that was read ahead to record[0], after reading
+  ahead more rows if needed.
+
+  If the scan cannot be read in batches, read the next row directly
+  and stop reading ahead.
+
+  @return 0 or handler error code
+*/
+
+int READ_RECORD::read_batch_row()
+{
+  handler *file= table->file;
+  uint reclength= table->s->reclength;
+
+  DBUG_ASSERT(batch_ready());
+
+  if (batch_pos == batch_rows)
+  {
+    int error;
+    if (unlikely((error= batch_error)))
+    {
+      batch_error= 0;
+      file->ha_read_batch_row(error);
+      table->status= STATUS_NOT_FOUND;
+      return error;
+    }
+    batch_pos= 0;
+    error= file->ha_read_next_batch(table->read_batch_buf, batch_max,
+                                    &batch_rows);
+    if (unlikely(error))
+    {
+      if (batch_rows)
+        batch_error= error;
+      else if (error == HA_ERR_WRONG_COMMAND)
+      {
+        batch_max= 0;
+        return file->inited == handler::INDEX
+          ? file->ha_index_next(record())
+          : file->ha_rnd_next(record());
+      }
+      else
+      {
+        file->ha_read_batch_row(error);
+        table->status= STATUS_NOT_FOUND;
+        return error;
+      }
+    }
+  }
+
+  memcpy(record(), table->read_batch_buf + batch_pos++ * reclength,
+         reclength);
+  file->ha_read_batch_row(0);
+  table->status= 0;
+  return 0;
 }
 
 
@@ -447,7 +552,11 @@ static int rr_index_last(READ_RECORD *info)
 
 static int rr_index(READ_RECORD *info)
 {
-  int tmp= info->table->file->ha_index_next(info->record());
+  int tmp;
+  if (info->batch_ready())
+    tmp= info->read_batch_row();
+  else if (!(tmp= info->table->file->ha_index_next(info->record())))
+    info->batch_count_row();
   if (tmp)
     tmp= rr_handle_error(info, tmp);
   return tmp;
@@ -482,11 +591,12 @@ static int rr_index_desc(READ_RECORD *info)
 int rr_sequential(READ_RECORD *info)
 {
   int tmp;
-  while ((tmp= info->table->file->ha_rnd_next(info->record())))
-  {
+  if (info->batch_ready())
+    tmp= info->read_batch_row();
+  else if (!(tmp= info->table->file->ha_rnd_next(info->record())))
+    info->batch_count_row();
+  if (tmp)
     tmp= rr_handle_error(info, tmp);
-    break;
-  }
   return tmp;
 }
 
@@ -67,9 +67,26 @@ struct READ_RECORD
   bool print_error;
   void    (*unpack)(struct st_sort_addon_field *, uchar *, uchar *);
 
+  /*
+    Rows of a table or index scan that handler::ha_read_next_batch() read
+    ahead into TABLE::read_batch_buf. batch_max is the number of rows
+    that fit in the buffer, or 0 if rows are read one at a time.
+    The first batch_countdown rows of a scan are read one at a time.
+  */
+  uint batch_max, batch_countdown, batch_rows, batch_pos;
+  /* Error that ended the last batch, to be returned after its rows */
+  int batch_error;
+
   int read_record() { return read_record_func(this); }
   uchar *record() const { return table->record[0]; }
 
+  void init_batch();
+  /* @return whether the next row should be read by read_batch_row() */
+  bool batch_ready() const { return batch_max && !batch_countdown; }
+  /* Note that a row was read one at a time */
+  void batch_count_row() { if (batch_countdown) batch_countdown--; }
+  int read_batch_row();
+
   /* 
     SJ-Materialization runtime may need to read fields from the materialized
     table and unpack them into original table fields:
@@ -77,7 +94,7 @@ struct READ_RECORD
   Copy_field *copy_field;
   Copy_field *copy_field_end;
 public:
-  READ_RECORD() : table(NULL), cache(NULL) {}
+  READ_RECORD() : table(NULL), cache(NULL), batch_max(0) {}
   ~READ_RECORD() { end_read_record(this); }
 };
 
@@ -70,6 +70,9 @@ void Filesort_tracker::print_json_members(Json_writer *writer)
                         (longlong) rint((double)sort_passes / get_r_loops()));
   }
 
+  if (sort_threads > 1)
+    writer->add_member("r_sort_threads").add_ll(sort_threads);
+
   if (sort_buffer_size != 0)
   {
     writer->add_member("r_buffer_size");
@@ -181,7 +181,8 @@ class Filesort_tracker : public Sql_alloc
     time_tracker(do_timing), r_limit(0), r_used_pq(0),
     r_examined_rows(0), r_sorted_rows(0), r_output_rows(0),
     sort_passes(0),
-    sort_buffer_size(0)
+    sort_buffer_size(0),
+    sort_threads(0)
   {}
   
   /* Functions that filesort uses to report various things about its execution */
@@ -223,6 +224,11 @@ class Filesort_tracker : public Sql_alloc
     else
       sort_buffer_size= bufsize;
   }
+
+  inline void report_sort_threads(uint threads)
+  {
+    set_if_bigger(sort_threads, threads);
+  }
   
   /* Functions to get the statistics */
   void print_json_members(Json_writer *writer);
@@ -282,6 +288,9 @@ class Filesort_tracker : public Sql_alloc
     other          - value
   */
   ulonglong sort_buffer_size;
+
+  /* Maximum number of threads that sorted a buffer */
+  uint sort_threads;
 };
 
 
@@ -654,6 +654,7 @@ typedef struct system_variables
   ulong max_length_for_sort_data;
   ulong max_recursive_iterations;
   ulong max_sort_length;
+  ulong max_sort_threads;
   ulong max_tmp_tables;
   ulong max_insert_delayed_threads;
   ulong min_examined_row_limit;
@@ -6832,6 +6833,22 @@ inline void handler::increment_statistics(ulong SSV::*offset) const
   table->in_use->check_limit_rows_examined();
 }
 
+inline void handler::ha_read_batch_row(int error)
+{
+  if (inited == INDEX)
+  {
+    increment_statistics(&SSV::ha_read_next_count);
+    if (!error)
+      update_index_statistics();
+  }
+  else
+  {
+    increment_statistics(&SSV::ha_read_rnd_next_count);
+    if (!error)
+      update_rows_read();
+  }
+}
+
 inline void handler::decrement_statistics(ulong SSV::*offset) const
 {
   status_var_decrement(table->in_use->status_var.*offset);
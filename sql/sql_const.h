@@ -199,6 +199,14 @@
 #define MIN_ROWS_TO_USE_TABLE_CACHE	 100
 #define MIN_ROWS_TO_USE_BULK_INSERT	 100
 
+/*
+  The following parameters decide when and how many rows of a table or
+  index scan are read ahead with handler::ha_read_next_batch()
+*/
+#define MIN_ROWS_TO_USE_READ_BATCH	 32
+#define READ_BATCH_MAX_ROWS		 128
+#define READ_BATCH_MAX_SIZE		 (64L*1024)
+
 /**
   The following is used to decide if MySQL should use table scanning
   instead of reading with keys.  The number says how many evaluation of the
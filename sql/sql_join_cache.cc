@@ -2804,6 +2804,7 @@ int JOIN_CACHE_HASHED::init(bool for_explain)
   DBUG_ENTER("JOIN_CACHE_HASHED::init");
 
   hash_table= 0;
+  bloom_filter= 0;
   key_entries= 0;
 
   key_length= ref->key_length;
@@ -2834,7 +2835,7 @@ int JOIN_CACHE_HASHED::init(bool for_explain)
   ref_key_info= join_tab->get_keyinfo_by_key_no(join_tab->ref.key);
   ref_used_key_parts= join_tab->ref.key_parts;
 
-  hash_func= &JOIN_CACHE_HASHED::get_hash_idx_simple;
+  hash_func= &JOIN_CACHE_HASHED::get_hash_simple;
   hash_cmp_func= &JOIN_CACHE_HASHED::equal_keys_simple;
 
   KEY_PART_INFO *key_part= ref_key_info->key_part;
@@ -2843,7 +2844,7 @@ int JOIN_CACHE_HASHED::init(bool for_explain)
   {
     if (!key_part->field->eq_cmp_as_binary())
     {
-      hash_func= &JOIN_CACHE_HASHED::get_hash_idx_complex;
+      hash_func= &JOIN_CACHE_HASHED::get_hash_complex;
       hash_cmp_func= &JOIN_CACHE_HASHED::equal_keys_complex;
       break;
     }
@@ -2876,7 +2877,8 @@ int JOIN_CACHE_HASHED::init(bool for_explain)
   DESCRIPTION
     The function estimates the number of hash table entries in the hash
     table to be used and initializes this hash table within the join buffer
-    space.
+    space. If use_bloom_filter is set, the bloom filter is placed after
+    the hash table. It takes one byte per hash entry.
 
   RETURN VALUE
     Currently the function always returns 0;
@@ -2884,6 +2886,7 @@ int JOIN_CACHE_HASHED::init(bool for_explain)
 
 int JOIN_CACHE_HASHED::init_hash_table()
 {
+  uint hash_entry_space;
   hash_table= 0;
   key_entries= 0;
 
@@ -2898,10 +2901,11 @@ int JOIN_CACHE_HASHED::init_hash_table()
     key_entry_length= get_size_of_rec_offset() + // key chain header
                       size_of_key_ofs +          // reference to the next key 
                       (use_emb_key ?  get_size_of_rec_offset() : key_length);
+    hash_entry_space= size_of_key_ofs + MY_TEST(use_bloom_filter);
 
     size_t space_per_rec= avg_record_length +
                          avg_aux_buffer_incr +
-                         key_entry_length+size_of_key_ofs;
+                         key_entry_length+hash_entry_space;
     size_t n= buff_size / space_per_rec;
 
     /*
@@ -2909,7 +2913,7 @@ int JOIN_CACHE_HASHED::init_hash_table()
             the number of records in in the join buffer.
     */
     size_t max_n= buff_size / (pack_length-length+
-                             key_entry_length+size_of_key_ofs);
+                             key_entry_length+hash_entry_space);
 
     hash_entries= (uint) (n / 0.7);
     set_if_bigger(hash_entries, 1);
@@ -2920,7 +2924,8 @@ int JOIN_CACHE_HASHED::init_hash_table()
   }
    
   /* Initialize the hash table */ 
-  hash_table= buff + (buff_size-hash_entries*size_of_key_ofs);
+  hash_table= buff + (buff_size-hash_entries*hash_entry_space);
+  bloom_filter= use_bloom_filter ? hash_table+hash_entries*size_of_key_ofs : 0;
   cleanup_hash_table();
   curr_key_entry= hash_table;
 
@@ -2967,7 +2972,7 @@ int JOIN_CACHE_HASHED::realloc_buffer()
   
   DESCRIPTION
     The function returns the size of the space occupied by one key entry
-    and one hash table entry.
+    and one hash table entry, including its byte of the bloom filter.
 
   RETURN VALUE
     maximum size of the additional space per record that is used to store
@@ -2986,7 +2991,8 @@ uint JOIN_CACHE_HASHED::get_max_key_addon_space_per_record()
   len= (use_emb_key ?  get_size_of_rec_offset() : ref->key_length) +
         size_of_rec_ofs +    // size of the key chain header
         size_of_rec_ofs +    // >= size of the reference to the next key 
-        2*size_of_rec_ofs;   // >= 2*( size of hash table entry)
+        2*size_of_rec_ofs +  // >= 2*( size of hash table entry)
+        2*MY_TEST(use_bloom_filter); // 2*(byte of the bloom filter)
   return len; 
 }    
 
@@ -3038,6 +3044,7 @@ void JOIN_CACHE_HASHED::reset(bool for_writing)
     the record from the partial join.
     If the match flag field of a record contains MATCH_IMPOSSIBLE the key is
     not created for this record. 
+    The hash value of a new key is added to the bloom filter, if any.
     
   RETURN VALUE
     TRUE    if it has been decided that it should be the last record
@@ -3074,7 +3081,8 @@ bool JOIN_CACHE_HASHED::put_record()
   }
 
   /* Look for the key in the hash table */
-  if (key_search(key, key_len, &key_ref_ptr))
+  ulong hash= (this->*hash_func)(key, key_len);
+  if (key_search(key, key_len, hash, &key_ref_ptr))
   {
     uchar *last_next_ref_ptr;
     /* 
@@ -3118,6 +3126,8 @@ bool JOIN_CACHE_HASHED::put_record()
     }
     last_key_entry= cp;
     DBUG_ASSERT(last_key_entry >= end_pos);
+    if (bloom_filter)
+      add_to_bloom_filter(hash);
     /* Increment the counter of key_entries in the hash table */ 
     key_entries++;
   }  
@@ -3213,6 +3223,7 @@ bool JOIN_CACHE_HASHED::skip_if_not_needed_match()
     key_search()
       key             pointer to the key value
       key_len         key value length
+      hash            hash value of the key
       key_ref_ptr OUT position of the reference to the next key from 
                       the hash element for the found key , or
                       a position where the reference to the the hash 
@@ -3231,11 +3242,11 @@ bool JOIN_CACHE_HASHED::skip_if_not_needed_match()
     FALSE   otherwise
 */
 
-bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
+bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len, ulong hash,
                                    uchar **key_ref_ptr) 
 {
   bool is_found= FALSE;
-  uint idx= (this->*hash_func)(key, key_length);
+  uint idx= (uint) (hash % hash_entries);
   uchar *ref_ptr= hash_table+size_of_key_ofs*idx;
   while (!is_null_key_ref(ref_ptr))
   {
@@ -3259,21 +3270,22 @@ bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
   Hash function that considers a key in the hash table as byte array
 
   SYNOPSIS
-    get_hash_idx_simple()
+    get_hash_simple()
       key             pointer to the key value
       key_len         key value length
       
   DESCRIPTION
-    The function calculates an index of the hash entry in the hash table
-    of the join buffer for the given key. It considers the key just as
+    The function calculates a hash value for the given key, from which
+    the index of the hash entry in the hash table of the join buffer and
+    the bits of the bloom filter are taken. It considers the key just as
     a sequence of bytes of the length key_len.
 
   RETURN VALUE
-    the calculated index of the hash entry for the given key  
+    the calculated hash value of the given key  
 */
 
 inline
-uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
+ulong JOIN_CACHE_HASHED::get_hash_simple(uchar* key, uint key_len)
 {
   ulong nr= 1;
   ulong nr2= 4;
@@ -3284,7 +3296,7 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
     nr^= (ulong) ((((uint) nr & 63)+nr2)*((uint) *pos))+ (nr << 8);
     nr2+= 3;
   }
-  return nr % hash_entries;
+  return nr;
 }
 
 
@@ -3292,13 +3304,14 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
   Hash function that takes into account collations of the components of the key  
 
   SYNOPSIS
-    get_hash_idx_complex()
+    get_hash_complex()
       key             pointer to the key value
       key_len         key value length
       
   DESCRIPTION
-    The function calculates an index of the hash entry in the hash table
-    of the join buffer for the given key. It takes into account that the
+    The function calculates a hash value for the given key, from which
+    the index of the hash entry in the hash table of the join buffer and
+    the bits of the bloom filter are taken. It takes into account that the
     components of the key may be of a varchar type with different collations.
     The function guarantees that the same hash value for any two equal
     keys that may differ as byte sequences.
@@ -3308,14 +3321,13 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
     operation.
 
   RETURN VALUE
-    the calculated index of the hash entry for the given key  
+    the calculated hash value of the given key  
 */
 
 inline
-uint JOIN_CACHE_HASHED::get_hash_idx_complex(uchar *key, uint key_len)
+ulong JOIN_CACHE_HASHED::get_hash_complex(uchar *key, uint key_len)
 {
-  return 
-    (uint) (key_hashnr(ref_key_info, ref_used_key_parts, key) % hash_entries);
+  return key_hashnr(ref_key_info, ref_used_key_parts, key);
 }
 
 
@@ -3502,7 +3514,9 @@ int JOIN_TAB_SCAN::open()
     match some records in the buffer of the join cache 'cache'. To do
     this the function calls the function that scans table records and
     looks for the next one that meets the condition pushed to the
-    joined table join_tab.
+    joined table join_tab. The records that the join cache finds unable
+    to match any record in its buffer are skipped without evaluating
+    the condition.
 
   NOTES
     The function catches the signal that kills the query.
@@ -3515,7 +3529,6 @@ int JOIN_TAB_SCAN::open()
 int JOIN_TAB_SCAN::next()
 {
   int err= 0;
-  int skip_rc;
   READ_RECORD *info= &join_tab->read_record;
   SQL_SELECT *select= join_tab->cache_select;
   THD *thd= join->thd;
@@ -3530,13 +3543,18 @@ int JOIN_TAB_SCAN::next()
     join_tab->tracker->r_rows++;
   }
 
-  while (!err && select && (skip_rc= select->skip_record(thd)) <= 0)
+  while (!err)
   {
+    int skip_rc= 1;
+    if (!cache->skip_joined_record() &&
+        (!select || (skip_rc= select->skip_record(thd)) > 0))
+      break;
     if (unlikely(thd->check_killed()) || skip_rc < 0)
       return 1;
     /* 
-      Move to the next record if the last retrieved record does not
-      meet the condition pushed to the table join_tab.
+      Move to the next record if the last retrieved record cannot match
+      any record in the join buffer or does not meet the condition pushed
+      to the table join_tab.
     */
     err= info->read_record();
     if (!err)
@@ -3781,6 +3799,12 @@ int JOIN_CACHE_BNL::init(bool for_explain)
     the head of the chain of records in the join_buffer that match this
     key.
 
+  NOTES
+    The join key and its hash value are built here unless the function
+    skip_joined_record has already built them for the record in the record
+    buffer. The latter is called by JOIN_TAB_SCAN::next, but not by the
+    scan of JOIN_CACHE_BKAH.
+
   RETURN VALUE
     The pointer to the corresponding circular list of records if
     the key entry with the join key is found, 0 - otherwise.
@@ -3789,15 +3813,68 @@ int JOIN_CACHE_BNL::init(bool for_explain)
 uchar *JOIN_CACHE_BNLH::get_matching_chain_by_join_key()
 {
   uchar *key_ref_ptr;
+  if (!join_key_built)
+    build_join_key();
+  join_key_built= FALSE;
+  /* Look for this key in the join buffer */
+  if (!key_search(key_buff, key_length, key_buff_hash, &key_ref_ptr))
+    return 0;
+  return key_ref_ptr+get_size_of_key_offset();
+}
+
+
+/*
+  Build the join key out of the record of the joined table
+
+  SYNOPSIS
+    build_join_key()
+
+  DESCRIPTION
+    The function builds the join key in key_buff out of the fields of the
+    record of join_tab in the record buffer, and calculates its hash value
+    into key_buff_hash.
+
+  RETURN VALUE
+    none
+*/
+
+void JOIN_CACHE_BNLH::build_join_key()
+{
   TABLE *table= join_tab->table;
   TABLE_REF *ref= &join_tab->ref;
   KEY *keyinfo= join_tab->get_keyinfo_by_key_no(ref->key);
   /* Build the join key value out of the record in the record buffer */
   key_copy(key_buff, table->record[0], keyinfo, key_length, TRUE);
-  /* Look for this key in the join buffer */
-  if (!key_search(key_buff, key_length, &key_ref_ptr))
-    return 0;
-  return key_ref_ptr+get_size_of_key_offset();
+  key_buff_hash= (this->*hash_func)(key_buff, key_length);
+}
+
+
+/*
+  Check whether a record of the joined table cannot match any record in
+  the BNLH join cache buffer
+
+  SYNOPSIS
+    skip_joined_record()
+
+  DESCRIPTION
+    This implementation of the virtual method builds the join key out of
+    the fields of join_tab and calculates its hash value for the lookup in
+    the hash table by the method get_matching_chain_by_join_key. If the
+    bloom filter of the keys from the join buffer tells that the key is not
+    in the hash table, the record is skipped. This saves the evaluation of
+    the condition pushed to join_tab and a walk over the key chain of the
+    hash entry for most of the records that do not have matches.
+
+  RETURN VALUE
+    TRUE    the record cannot match any record from the join buffer
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::skip_joined_record()
+{
+  build_join_key();
+  join_key_built= TRUE;
+  return bloom_filter && !bloom_filter_may_contain(key_buff_hash);
 }
 
 
@@ -3936,7 +4013,9 @@ void JOIN_CACHE_BNLH::read_next_candidate_for_match(uchar *rec_ptr)
 
   NOTES
     The function first constructs a companion object of the type JOIN_TAB_SCAN,
-    then it calls the init method of the parent class.
+    then it calls the init method of the parent class. The cache builds a
+    bloom filter of its keys to skip the records of join_tab that cannot
+    match any record from the buffer.
     
   RETURN VALUE  
     0   initialization with buffer allocations has been succeeded
@@ -3950,6 +4029,8 @@ int JOIN_CACHE_BNLH::init(bool for_explain)
   if (!(join_tab_scan= new JOIN_TAB_SCAN(join, join_tab)))
     DBUG_RETURN(1);
 
+  use_bloom_filter= TRUE;
+
   DBUG_RETURN(JOIN_CACHE_HASHED::init(for_explain));
 }
 
@@ -481,6 +481,13 @@ class JOIN_CACHE :public Sql_alloc
   */  
   virtual uint get_number_of_ranges_for_mrr() { return 0; };
 
+  /*
+    Check whether the record of the joined table read into the record buffer
+    cannot match any record from the join cache buffer. The check is done
+    before the condition pushed to the joined table is evaluated.
+  */
+  virtual bool skip_joined_record() { return FALSE; }
+
   /* 
     Shall prepare to look for records from the join cache buffer that would
     match the record of the joined table read into the record buffer
@@ -772,7 +779,7 @@ class JOIN_CACHE :public Sql_alloc
 class JOIN_CACHE_HASHED: public JOIN_CACHE
 {
 
-  typedef uint (JOIN_CACHE_HASHED::*Hash_func) (uchar *key, uint key_len);
+  typedef ulong (JOIN_CACHE_HASHED::*Hash_func) (uchar *key, uint key_len);
   typedef bool (JOIN_CACHE_HASHED::*Hash_cmp_func) (uchar *key1, uchar *key2,
                                                     uint key_len);
   
@@ -800,17 +807,42 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   /* The offset of the data fields from the beginning of the record fields */
   uint data_fields_offset;
 
-  inline uint get_hash_idx_simple(uchar *key, uint key_len);
-  inline uint get_hash_idx_complex(uchar *key, uint key_len);
+  inline ulong get_hash_simple(uchar *key, uint key_len);
+  inline ulong get_hash_complex(uchar *key, uint key_len);
 
   inline bool equal_keys_simple(uchar *key1, uchar *key2, uint key_len);
   inline bool equal_keys_complex(uchar *key1, uchar *key2, uint key_len);
 
   int init_hash_table();
   void cleanup_hash_table();
+
+  /* Get the positions of the two bits of the bloom filter for a hash value */
+  void get_bloom_filter_bits(ulong hash, ulonglong *bit1, ulonglong *bit2)
+  {
+    ulonglong nr= (ulonglong) hash * 0x9E3779B97F4A7C15ULL;
+    ulonglong bits= (ulonglong) hash_entries * 8;
+    *bit1= (nr >> 32) % bits;
+    *bit2= (nr & 0xFFFFFFFF) % bits;
+  }
   
 protected:
 
+  /*
+    Whether a bloom filter is built over the keys of the records put into
+    the join buffer, usually set by the init() method of a derived class
+  */
+  bool use_bloom_filter;
+
+  /*
+    The bloom filter over the hash values of the keys in the hash table,
+    8 bits per hash entry, placed right after the hash table. It is 0 if
+    use_bloom_filter is not set.
+  */
+  uchar *bloom_filter;
+
+  /* The hash value of the key in key_buff */
+  ulong key_buff_hash;
+
   /* 
     Index info on the TABLE_REF object used by the hash join
     to look for matching records
@@ -979,7 +1011,25 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   bool skip_if_not_needed_match();
 
   /* Search for a key in the hash table of the join buffer */
-  bool key_search(uchar *key, uint key_len, uchar **key_ref_ptr);
+  bool key_search(uchar *key, uint key_len, ulong hash, uchar **key_ref_ptr);
+
+  /* Add the hash value of a key to the bloom filter */
+  void add_to_bloom_filter(ulong hash)
+  {
+    ulonglong bit1, bit2;
+    get_bloom_filter_bits(hash, &bit1, &bit2);
+    bloom_filter[bit1 / 8]|= (uchar) (1 << (bit1 % 8));
+    bloom_filter[bit2 / 8]|= (uchar) (1 << (bit2 % 8));
+  }
+
+  /* Check whether a key with the hash value may be in the hash table */
+  bool bloom_filter_may_contain(ulong hash)
+  {
+    ulonglong bit1, bit2;
+    get_bloom_filter_bits(hash, &bit1, &bit2);
+    return (bloom_filter[bit1 / 8] & (1 << (bit1 % 8))) &&
+           (bloom_filter[bit2 / 8] & (1 << (bit2 % 8)));
+  }
 
   /* Reallocate the join buffer of a hashed join cache */
   int realloc_buffer();
@@ -989,7 +1039,8 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
     used to join table 'tab' to the result of joining the previous tables 
     specified by the 'j' parameter.
   */   
-  JOIN_CACHE_HASHED(JOIN *j, JOIN_TAB *tab) :JOIN_CACHE(j, tab) {}
+  JOIN_CACHE_HASHED(JOIN *j, JOIN_TAB *tab)
+    :JOIN_CACHE(j, tab), use_bloom_filter(FALSE) {}
 
   /* 
     This constructor creates a linked hashed join cache. The cache is to be
@@ -998,7 +1049,7 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
     cache object to which this cache is linked.
   */   
   JOIN_CACHE_HASHED(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev) 
-		    :JOIN_CACHE(j, tab, prev) {}
+		    :JOIN_CACHE(j, tab, prev), use_bloom_filter(FALSE) {}
 
 public:
 
@@ -1173,12 +1224,23 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
   */
   uchar *next_matching_rec_ref_ptr;
 
+  /*
+    TRUE if key_buff and key_buff_hash have been built for the record of
+    join_tab in the record buffer by skip_joined_record
+  */
+  bool join_key_built;
+
+  /* Build the join key and its hash value out of the record of join_tab */
+  void build_join_key();
+
   /*
     Get the chain of records from buffer matching the current candidate
     record for join
   */
   uchar *get_matching_chain_by_join_key();
 
+  bool skip_joined_record();
+
   bool prepare_look_for_matches(bool skip_last);
 
   uchar *get_next_candidate_for_match();
@@ -1194,7 +1256,8 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     used to join table 'tab' to the result of joining the previous tables 
     specified by the 'j' parameter.
   */   
-  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab) : JOIN_CACHE_HASHED(j, tab) {}
+  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab)
+    : JOIN_CACHE_HASHED(j, tab), join_key_built(FALSE) {}
 
   /* 
     This constructor creates a linked BNLH join cache. The cache is to be 
@@ -1203,7 +1266,7 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     cache object to which this cache is linked.
   */   
   JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev) 
-    : JOIN_CACHE_HASHED(j, tab, prev) {}
+    : JOIN_CACHE_HASHED(j, tab, prev), join_key_built(FALSE) {}
 
   /* Initialize the BNLH cache */       
   int init(bool for_explain);
@@ -21971,6 +21971,7 @@ join_read_first(JOIN_TAB *tab)
       report_error(table, error);
     DBUG_RETURN(-1);
   }
+  tab->read_record.init_batch();
   DBUG_RETURN(0);
 }
 
@@ -21979,7 +21980,11 @@ static int
 join_read_next(READ_RECORD *info)
 {
   int error;
-  if (unlikely((error= info->table->file->ha_index_next(info->record()))))
+  if (info->batch_ready())
+    error= info->read_batch_row();
+  else if (!(error= info->table->file->ha_index_next(info->record())))
+    info->batch_count_row();
+  if (unlikely(error))
     return report_error(info->table, error);
 
   return 0;
@@ -22473,12 +22478,18 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
 	   bool end_of_records)
 {
   TABLE *const table= join_tab->table;
+  TMP_TABLE_PARAM *const tmp_param= join_tab->tmp_table_param;
+  AGGR_OP *const aggr= join_tab->aggr;
   ORDER   *group;
   int	  error;
+  bool    same_group;
   DBUG_ENTER("end_update");
 
   if (end_of_records)
+  {
+    aggr->last_group_updated= false;
     DBUG_RETURN(NESTED_LOOP_OK);
+  }
 
   join->found_records++;
   copy_fields(join_tab->tmp_table_param);	// Groups are copied twice.
@@ -22500,8 +22511,19 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
     if (item->maybe_null)
       group->buff[-1]= (char) group->field->is_null();
   }
-  if (!table->file->ha_index_read_map(table->record[1],
-                                      join_tab->tmp_table_param->group_buff,
+  /*
+    Input that arrives clustered by the group key (an index scan, a join
+    on the grouping column) updates one group many times in a row. The
+    row it updated last is still in record[1], so such a run needs no
+    index lookup. Keys that only compare equal in their collation fail
+    the memcmp() and take the lookup.
+  */
+  same_group= aggr->last_group_updated &&
+              !memcmp(aggr->last_group_key, tmp_param->group_buff,
+                      tmp_param->group_length);
+  if (same_group ||
+      !table->file->ha_index_read_map(table->record[1],
+                                      tmp_param->group_buff,
                                       HA_WHOLE_KEY,
                                       HA_READ_KEY_EXACT))
   {						/* Update old record */
@@ -22513,8 +22535,17 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
       table->file->print_error(error,MYF(0));	/* purecov: inspected */
       DBUG_RETURN(NESTED_LOOP_ERROR);            /* purecov: inspected */
     }
+    if (aggr->last_group_key)
+    {
+      store_record(table,record[1]);
+      if (!same_group)
+        memcpy(aggr->last_group_key, tmp_param->group_buff,
+               tmp_param->group_length);
+      aggr->last_group_updated= true;
+    }
     goto end;
   }
+  aggr->last_group_updated= false;
 
   init_tmptable_sum_functions(join->sum_funcs);
   if (unlikely(copy_funcs(join_tab->tmp_table_param->items_to_copy,
@@ -29647,6 +29678,21 @@ AGGR_OP::prepare_tmp_table()
       return true;
     (void) table->file->extra(HA_EXTRA_WRITE_CACHE);
   }
+  /*
+    HEAP keeps the handler positioned on the last updated row, which lets
+    end_update() skip the index lookup for a run of rows of one group.
+  */
+  last_group_updated= false;
+  if (table->s->db_type() != heap_hton)
+    last_group_key= NULL;
+  else if (!last_group_key && write_func == end_update)
+  {
+    TMP_TABLE_PARAM *tmp_param= join_tab->tmp_table_param;
+    if (!(last_group_key= (uchar*) join->thd->alloc(tmp_param->group_length)))
+      return true;
+    /* Unused tails of VARCHAR key parts are compared as well */
+    bzero(tmp_param->group_buff, tmp_param->group_length);
+  }
   /* If it wasn't already, start index scan for grouping using table index. */
   if (!table->file->inited && table->group &&
       join_tab->tmp_table_param->sum_func_count && table->s->keys)
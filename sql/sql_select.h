@@ -1078,8 +1078,17 @@ class AGGR_OP :public Sql_alloc
 {
 public:
   JOIN_TAB *join_tab;
+  /*
+    Group key of the row last updated by end_update(), NULL when the
+    tmp table can't be updated without positioning on the row first
+  */
+  uchar *last_group_key;
+  /* TRUE <=> last_group_key and record[1] hold the current group row */
+  bool last_group_updated;
 
-  AGGR_OP(JOIN_TAB *tab) : join_tab(tab), write_func(NULL)
+  AGGR_OP(JOIN_TAB *tab)
+    : join_tab(tab), last_group_key(NULL), last_group_updated(false),
+      write_func(NULL)
   {};
 
   enum_nested_loop_state put_record() { return put_record(false); };
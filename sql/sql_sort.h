@@ -32,6 +32,11 @@ struct TABLE;
 #define MERGEBUFF		7
 #define MERGEBUFF2		15
 
+/* Maximum value of max_sort_threads */
+#define MAX_SORT_THREADS	64
+/* Minimum number of keys that a thread of a parallel sort handles */
+#define MIN_KEYS_PER_SORT_THREAD	10000
+
 /*
    The structure SORT_ADDON_FIELD describes a fixed layout
    for field values appended to sorted values in records to be sorted
@@ -73,6 +78,8 @@ class Sort_param {
   uint res_length;            // Length of records in final sorted file/buffer.
   uint max_keys_per_buffer;   // Max keys / buffer.
   uint min_dupl_count;
+  uint max_sort_threads;      // Max threads to sort a buffer with.
+  uint sort_threads;          // Max threads that sorted a buffer.
   ha_rows max_rows;           // Select limit, or HA_POS_ERROR if unlimited.
   ha_rows examined_rows;      // Number of examined rows.
   TABLE *sort_form;           // For quicker make_sortkey.
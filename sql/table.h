@@ -1259,6 +1259,8 @@ struct TABLE
   handler *update_handler;  /* Handler used in case of update */
   uchar *write_row_record;		/* Used as optimisation in
 					   THD::write_row */
+  /* Rows read ahead by handler::ha_read_next_batch(), see READ_RECORD */
+  uchar *read_batch_buf;
   uchar *insert_values;                  /* used by INSERT ... UPDATE */
   /* 
     Map of keys that can be used to retrieve all data from this table 
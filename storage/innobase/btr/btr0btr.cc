@@ -1305,6 +1305,51 @@ void btr_free(const page_id_t page_id)
 	mtr.commit();
 }
 
+/** Remove all records from a persistent index tree, leaving an empty
+root page. This is used for rolling back TRX_UNDO_EMPTY, while the
+table is protected by an exclusive table lock.
+@param[in,out]	index	index tree to be emptied */
+void btr_clear(dict_index_t* index)
+{
+	ut_ad(!index->table->is_temporary());
+	ut_ad(!(index->type & (DICT_FTS | DICT_IBUF)));
+
+	mtr_t		mtr;
+	mtr.start();
+	index->set_modified(mtr);
+	mtr_x_lock_index(index, &mtr);
+
+	buf_block_t*	root = btr_root_block_get(index, RW_X_LATCH, &mtr);
+
+	if (!root) {
+		mtr.commit();
+		return;
+	}
+
+	btr_free_but_not_root(root, mtr.get_log_mode());
+
+	/* Both file segments were freed, except for the root page,
+	which is in the non-leaf segment. Re-create the leaf segment.
+	Like for a freshly allocated page, fseg_create() expects the
+	page type to be FIL_PAGE_TYPE_SYS; btr_page_empty() will
+	restore it to FIL_PAGE_INDEX or FIL_PAGE_RTREE. */
+	mlog_memset(root, PAGE_HEADER + PAGE_BTR_SEG_LEAF,
+		    FSEG_HEADER_SIZE, 0, &mtr);
+	if (!index->table->space->full_crc32()) {
+		mlog_write_ulint(root->frame + FIL_PAGE_TYPE,
+				 FIL_PAGE_TYPE_SYS, MLOG_2BYTES, &mtr);
+	}
+
+	if (!fseg_create(index->table->space,
+			 PAGE_HEADER + PAGE_BTR_SEG_LEAF, &mtr, false, root)) {
+		ib::error() << "Out of space while emptying index "
+			<< index->name << " of table " << index->table->name;
+	}
+
+	btr_page_empty(root, buf_block_get_page_zip(root), index, 0, &mtr);
+	mtr.commit();
+}
+
 /** Read the last used AUTO_INCREMENT value from PAGE_ROOT_AUTO_INC.
 @param[in,out]	index	clustered index
 @return	the last used AUTO_INCREMENT value
@@ -77,6 +77,11 @@ UNIV_INTERN byte		btr_sea_pad2[CACHE_LINE_SIZE];
 /** The adaptive hash index */
 btr_search_sys_t*	btr_search_sys;
 
+/** Number of threads that are executing btr_search_guess_latch_free().
+btr_search_disable() waits for this to reach 0 before freeing the hash
+tables. */
+static ib_counter_t<lint>	btr_search_readers;
+
 /** If the number of records on the page divided by this parameter
 would have been successfully accessed using a hash index, the index
 is then built on the page, assuming the global limit has been reached */
@@ -245,6 +250,9 @@ void btr_search_sys_create(ulint hash_size)
 		ut_malloc(sizeof(btr_search_sys_t), mem_key_ahi));
 
 	btr_search_sys->hash_tables = NULL;
+	btr_search_sys->part_stats = static_cast<btr_search_part_stats_t*>(
+		ut_zalloc(sizeof(btr_search_part_stats_t) * btr_ahi_parts,
+			  mem_key_ahi));
 
 	if (btr_search_enabled) {
 		btr_search_enable();
@@ -273,6 +281,7 @@ void btr_search_sys_free()
     ut_free(btr_search_sys->hash_tables);
   }
 
+  ut_free(btr_search_sys->part_stats);
   ut_free(btr_search_sys);
   btr_search_sys= NULL;
 
@@ -414,6 +423,15 @@ void btr_search_disable()
 	/* Set all block->index = NULL. */
 	buf_pool_clear_hash_index();
 
+	/* Wait for btr_search_guess_latch_free() in other threads,
+	which may still be accessing the hash tables. Pairs with the
+	fence in btr_search_guess_latch_free(). */
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	while (lint(btr_search_readers)) {
+		os_thread_yield();
+	}
+	std::atomic_thread_fence(std::memory_order_acquire);
+
 	/* Clear the adaptive hash index. */
 	for (ulint i = 0; i < btr_ahi_parts; ++i) {
 		mem_heap_free(btr_search_sys->hash_tables[i]->heap);
@@ -874,6 +892,142 @@ btr_search_failure(btr_search_t* info, btr_cur_t* cursor)
 	info->last_hash_succ = FALSE;
 }
 
+/** Outcome of btr_search_guess_latch_free() */
+enum btr_search_lf_t {
+	/** the page of the record was buffer-fixed and latched */
+	BTR_SEARCH_LF_FOUND,
+	/** no record was found, or the page could not be latched */
+	BTR_SEARCH_LF_MISS,
+	/** the partition was modified concurrently */
+	BTR_SEARCH_LF_RETRY
+};
+
+/** Look up a record in the adaptive hash index without acquiring
+btr_search_latches[], and latch its page.
+@param[in]	part		adaptive hash index partition
+@param[in]	fold		folded value of the search tuple
+@param[in]	latch_mode	BTR_SEARCH_LEAF or BTR_MODIFY_LEAF
+@param[in]	slot		reasonably thread-unique identifier
+@param[out]	rec		the record that was found
+@param[out]	block		the latched block, if BTR_SEARCH_LF_FOUND
+@param[in,out]	mtr		mini-transaction
+@return the outcome of the lookup */
+static
+btr_search_lf_t
+btr_search_guess_latch_free(
+	ulint		part,
+	ulint		fold,
+	ulint		latch_mode,
+	size_t		slot,
+	const rec_t**	rec,
+	buf_block_t**	block,
+	mtr_t*		mtr)
+{
+	btr_search_lf_t	ret = BTR_SEARCH_LF_RETRY;
+
+	btr_search_readers.inc(slot);
+	/* Either btr_search_disable() will wait for us, or we will
+	observe !btr_search_enabled. */
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (!btr_search_enabled) {
+		ret = BTR_SEARCH_LF_MISS;
+	} else {
+		hash_table_t*	table = btr_search_sys->hash_tables[part];
+		ulint		seq;
+
+		if (!ha_search_latch_free(table, fold, &seq, rec)) {
+			/* A writer got in the way; retry with the latch. */
+		} else if (!*rec) {
+			ret = BTR_SEARCH_LF_MISS;
+		} else if ((*block = buf_block_fix_from_ahi(
+				    *rec, table, seq, __FILE__, __LINE__))) {
+			/* The page latch is acquired without waiting, so
+			that btr_search_disable() cannot be blocked while
+			we are still counted in btr_search_readers and
+			the partition cannot be freed under us. */
+			const ulint	savepoint = mtr_set_savepoint(mtr);
+
+			if (!buf_page_get_fixed_nowait(
+				    latch_mode, *block, BUF_MAKE_YOUNG,
+				    __FILE__, __LINE__, mtr)) {
+				ret = BTR_SEARCH_LF_MISS;
+			} else if (!ha_search_validate(table, seq)) {
+				/* The record may have been moved or
+				freed before the page was latched. */
+				mtr_release_block_at_savepoint(
+					mtr, savepoint, *block);
+			} else {
+				ret = BTR_SEARCH_LF_FOUND;
+			}
+		}
+	}
+
+	std::atomic_thread_fence(std::memory_order_release);
+	btr_search_readers.add(slot, -1);
+
+	return(ret);
+}
+
+/** Look up a record in the adaptive hash index while holding
+btr_search_latches[part] in shared mode, and latch its page.
+@param[in]	index		index
+@param[in]	part		adaptive hash index partition of index
+@param[in]	fold		folded value of the search tuple
+@param[in]	latch_mode	BTR_SEARCH_LEAF or BTR_MODIFY_LEAF
+@param[out]	rec		the record that was found
+@param[in,out]	mtr		mini-transaction
+@return the latched block
+@retval NULL if no record was found or the page could not be latched */
+static
+buf_block_t*
+btr_search_guess_latched(
+	dict_index_t*	index,
+	ulint		part,
+	ulint		fold,
+	ulint		latch_mode,
+	const rec_t**	rec,
+	mtr_t*		mtr)
+{
+	rw_lock_t*	ahi_latch = btr_search_latches[part];
+
+	rw_lock_s_lock(ahi_latch);
+
+	if (!btr_search_enabled) {
+		goto fail;
+	}
+
+	*rec = ha_search_and_get_data(btr_search_sys->hash_tables[part],
+				      fold);
+
+	if (!*rec) {
+fail:
+		rw_lock_s_unlock(ahi_latch);
+		return(NULL);
+	}
+
+	buf_block_t*	block = buf_block_from_ahi(*rec);
+
+	if (!buf_page_get_known_nowait(latch_mode, block, BUF_MAKE_YOUNG,
+	      __FILE__, __LINE__, mtr)) {
+		goto fail;
+	}
+
+	const bool fail = index != block->index
+		&& index->id == block->index->id;
+	ut_a(!fail || block->index->freed());
+	ut_ad(fail || !block->page.file_page_was_freed);
+	rw_lock_s_unlock(ahi_latch);
+
+	buf_block_dbg_add_level(block, SYNC_TREE_NODE_FROM_HASH);
+	if (UNIV_UNLIKELY(fail)) {
+		btr_leaf_page_release(block, latch_mode, mtr);
+		return(NULL);
+	}
+
+	return(block);
+}
+
 /** Tries to guess the right search position based on the hash search info
 of the index. Note that if mode is PAGE_CUR_LE, which is used in inserts,
 and the function returns TRUE, then cursor->up_match and cursor->low_match
@@ -943,53 +1097,39 @@ btr_search_guess_on_hash(
 	cursor->fold = fold;
 	cursor->flag = BTR_CUR_HASH;
 
-	rw_lock_t* ahi_latch = btr_get_search_latch(index);
-	const rec_t* rec;
-
-		rw_lock_s_lock(ahi_latch);
-
-	if (!btr_search_enabled) {
-		goto fail;
-	}
-
-	rec = static_cast<const rec_t*>(
-		ha_search_and_get_data(btr_get_search_table(index), fold));
-
-	if (!rec) {
-fail:
-		rw_lock_s_unlock(ahi_latch);
-
-		btr_search_failure(info, cursor);
-		return false;
-	}
-
-	buf_block_t*	block = buf_block_from_ahi(rec);
+	const ulint	part = btr_get_search_part(index);
+	const size_t	slot = get_rnd_value();
+	btr_search_part_stats_t&	stats = btr_search_sys->part_stats[part];
+	const rec_t*	rec;
+	buf_block_t*	block;
 
-	if (!buf_page_get_known_nowait(latch_mode, block, BUF_MAKE_YOUNG,
-	      __FILE__, __LINE__, mtr)) {
+	switch (btr_search_guess_latch_free(part, fold, latch_mode, slot,
+					    &rec, &block, mtr)) {
+	case BTR_SEARCH_LF_FOUND:
+		buf_block_dbg_add_level(block, SYNC_TREE_NODE_FROM_HASH);
+		/* Without btr_search_latches[], block->index may be
+		reset concurrently. Do not dereference it. */
+		if (index != block->index) {
+			goto fail_and_release_page;
+		}
+		ut_ad(!block->page.file_page_was_freed);
+		break;
+	case BTR_SEARCH_LF_RETRY:
+		stats.latch_waits.inc(slot);
+		block = btr_search_guess_latched(index, part, fold, latch_mode,
+						 &rec, mtr);
+		if (block) {
+			break;
+		}
+		/* fall through */
+	case BTR_SEARCH_LF_MISS:
 		goto fail;
 	}
 
-	const bool fail = index != block->index
-		&& index_id == block->index->id;
-	ut_a(!fail || block->index->freed());
-	ut_ad(fail || !block->page.file_page_was_freed);
-	rw_lock_s_unlock(ahi_latch);
-
-	buf_block_dbg_add_level(block, SYNC_TREE_NODE_FROM_HASH);
-	if (UNIV_UNLIKELY(fail)) {
-		goto fail_and_release_page;
-	}
-
 	if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE) {
 
 		ut_ad(buf_block_get_state(block) == BUF_BLOCK_REMOVE_HASH);
-
-fail_and_release_page:
-		btr_leaf_page_release(block, latch_mode, mtr);
-
-		btr_search_failure(info, cursor);
-		return false;
+		goto fail_and_release_page;
 	}
 
 	ut_ad(page_rec_is_user_rec(rec));
@@ -1066,7 +1206,15 @@ btr_search_guess_on_hash(
 		++buf_pool->stat.n_page_gets;
 	}
 
+	stats.hits.inc(slot);
 	return true;
+
+fail_and_release_page:
+	btr_leaf_page_release(block, latch_mode, mtr);
+fail:
+	stats.misses.inc(slot);
+	btr_search_failure(info, cursor);
+	return false;
 }
 
 /** Drop any adaptive hash index entries that point to an index page.
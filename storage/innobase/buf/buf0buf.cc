@@ -3770,12 +3770,14 @@ buf_zip_decompress(
 }
 
 #ifdef BTR_CUR_HASH_ADAPT
-/** Get a buffer block from an adaptive hash index pointer.
+/** Get a buffer block from an adaptive hash index pointer,
+without checking the state of the block.
 This function does not return if the block is not identified.
 @param[in]	ptr	pointer to within a page frame
 @return pointer to block, never NULL */
+static
 buf_block_t*
-buf_block_from_ahi(const byte* ptr)
+buf_block_from_ahi_low(const byte* ptr)
 {
 	buf_pool_chunk_map_t::iterator it;
 
@@ -3805,6 +3807,17 @@ buf_block_from_ahi(const byte* ptr)
 	/* The function buf_chunk_init() invokes buf_block_init() so that
 	block[n].frame == block->frame + n * srv_page_size.  Check it. */
 	ut_ad(block->frame == page_align(ptr));
+	return(block);
+}
+
+/** Get a buffer block from an adaptive hash index pointer.
+This function does not return if the block is not identified.
+@param[in]	ptr	pointer to within a page frame
+@return pointer to block, never NULL */
+buf_block_t*
+buf_block_from_ahi(const byte* ptr)
+{
+	buf_block_t*	block = buf_block_from_ahi_low(ptr);
 	/* Read the state of the block without holding a mutex.
 	A state transition from BUF_BLOCK_FILE_PAGE to
 	BUF_BLOCK_REMOVE_HASH is possible during this execution. */
@@ -3812,6 +3825,44 @@ buf_block_from_ahi(const byte* ptr)
 	ut_ad(state == BUF_BLOCK_FILE_PAGE || state == BUF_BLOCK_REMOVE_HASH);
 	return(block);
 }
+
+/** Buffer-fix a block that was found by ha_search_latch_free()
+without holding the adaptive hash index latch.
+@param[in]	ptr	pointer to within a page frame
+@param[in]	table	adaptive hash index partition that ptr was read from
+@param[in]	seq	modification counter from ha_search_latch_free()
+@param[in]	file	file name
+@param[in]	line	line where called
+@return the buffer-fixed block
+@retval NULL if the partition was modified or the block is being freed */
+buf_block_t*
+buf_block_fix_from_ahi(
+	const byte*		ptr,
+	const hash_table_t*	table,
+	ulint			seq,
+	const char*		file,
+	unsigned		line)
+{
+	/* The chunk map cannot change, because buf_pool_resize()
+	invokes btr_search_disable(), which waits for latch-free
+	readers. The block may have been freed or reused since ptr
+	was read, but not before the entry pointing to it was removed
+	from the partition by btr_search_drop_page_hash_index(). */
+	buf_block_t*	block = buf_block_from_ahi_low(ptr);
+
+	buf_page_mutex_enter(block);
+
+	if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
+	    || !ha_search_validate(table, seq)) {
+		buf_page_mutex_exit(block);
+		return(NULL);
+	}
+
+	buf_block_buf_fix_inc(block, file, line);
+	buf_page_set_accessed(&block->page);
+	buf_page_mutex_exit(block);
+	return(block);
+}
 #endif /* BTR_CUR_HASH_ADAPT */
 
 /********************************************************************//**
@@ -4775,9 +4826,6 @@ buf_page_get_known_nowait(
 	unsigned	line,	/*!< in: line where called */
 	mtr_t*		mtr)	/*!< in: mini-transaction */
 {
-	buf_pool_t*	buf_pool;
-	ibool		success;
-
 	ut_ad(mtr->is_active());
 	ut_ad((rw_latch == RW_S_LATCH) || (rw_latch == RW_X_LATCH));
 
@@ -4808,7 +4856,32 @@ buf_page_get_known_nowait(
 
 	buf_page_mutex_exit(block);
 
-	buf_pool = buf_pool_from_block(block);
+	return(buf_page_get_fixed_nowait(rw_latch, block, mode,
+					 file, line, mtr));
+}
+
+/** Latch a buffer-fixed page without waiting.
+@param[in]	rw_latch	RW_S_LATCH or RW_X_LATCH
+@param[in,out]	block		buffer-fixed block; unfixed on failure
+@param[in]	mode		BUF_MAKE_YOUNG or BUF_KEEP_OLD
+@param[in]	file		file name
+@param[in]	line		line where called
+@param[in,out]	mtr		mini-transaction
+@return whether the page was latched and registered in mtr */
+bool
+buf_page_get_fixed_nowait(
+	ulint		rw_latch,
+	buf_block_t*	block,
+	ulint		mode,
+	const char*	file,
+	unsigned	line,
+	mtr_t*		mtr)
+{
+	buf_pool_t*	buf_pool = buf_pool_from_block(block);
+	bool		success;
+
+	ut_ad(mtr->is_active());
+	ut_ad(block->page.buf_fix_count > 0);
 
 #ifdef BTR_CUR_HASH_ADAPT
 	if (mode == BUF_MAKE_YOUNG) {
@@ -4837,7 +4910,7 @@ buf_page_get_known_nowait(
 
 	if (!success) {
 		buf_block_buf_fix_dec(block);
-		return(FALSE);
+		return(false);
 	}
 
 	mtr_memo_push(mtr, block, fix_type);
@@ -4850,7 +4923,7 @@ buf_page_get_known_nowait(
 
 	buf_pool->stat.n_page_gets++;
 
-	return(TRUE);
+	return(true);
 }
 
 /** Given a tablespace id and page number tries to get that page. If the
@@ -42,6 +42,15 @@ buf_dblwr_t*	buf_dblwr = NULL;
 /** Set to TRUE when the doublewrite buffer is being created */
 ibool	buf_dblwr_being_created = FALSE;
 
+/** The doublewrite files that replace the batch part of buf_dblwr
+(innodb_doublewrite_files>0), or NULL */
+static buf_dblwr_t*	buf_dblwr_files;
+/** Number of elements in buf_dblwr_files */
+static ulint		buf_dblwr_n_files;
+
+/** Contents of the doublewrite files that were read for crash recovery */
+static std::vector<byte*>	buf_dblwr_recv_bufs;
+
 #define TRX_SYS_DOUBLEWRITE_BLOCKS 2
 
 /****************************************************************//**
@@ -110,6 +119,207 @@ buf_dblwr_sync_datafiles()
 	os_aio_wait_until_no_pending_writes();
 }
 
+/** Generate the path of a doublewrite file.
+@param[out]	path	the path
+@param[in]	size	size of path, in bytes
+@param[in]	n	number of the file */
+static void buf_dblwr_file_path(char* path, size_t size, ulint n)
+{
+	snprintf(path, size, "%s%cib_dblwr" ULINTPF,
+		 *srv_data_home ? srv_data_home : fil_path_to_mysql_datadir,
+		 OS_PATH_SEPARATOR, n);
+	os_normalize_path(path);
+}
+
+/** Read the doublewrite files that were written before a shutdown or
+crash, so that buf_dblwr_process() can restore the pages from them.
+The files are read until the first missing one, regardless of the
+current value of innodb_doublewrite_files.
+@return DB_SUCCESS or error code */
+static dberr_t buf_dblwr_load_files()
+{
+	recv_dblwr_t&	recv_dblwr = recv_sys.dblwr;
+
+	for (ulint n = 0;; n++) {
+		char	path[FN_REFLEN];
+		bool	success;
+
+		buf_dblwr_file_path(path, sizeof path, n);
+
+		pfs_os_file_t	file = os_file_create_simple_no_error_handling(
+			innodb_data_file_key, path, OS_FILE_OPEN,
+			OS_FILE_READ_ONLY, true, &success);
+
+		if (!success) {
+			return(DB_SUCCESS);
+		}
+
+		const os_offset_t	size = os_file_get_size(file);
+		dberr_t			err = DB_SUCCESS;
+
+		if (size == os_offset_t(-1)) {
+			err = DB_IO_ERROR;
+		} else if (ulint len = ulint(size)
+			   & ~ulint(srv_page_size - 1)) {
+			byte*	buf = static_cast<byte*>(
+				aligned_malloc(len, srv_page_size));
+
+			err = os_file_read(IORequestRead, file, buf, 0, len);
+
+			buf_dblwr_recv_bufs.push_back(buf);
+
+			for (byte* page = buf; err == DB_SUCCESS
+			     && page < buf + len; page += srv_page_size) {
+				/* Each valid page header must contain
+				a nonzero FIL_PAGE_LSN field. */
+				if (memcmp(field_ref_zero,
+					   page + FIL_PAGE_LSN, 8)) {
+					recv_dblwr.add(page);
+				}
+			}
+		}
+
+		os_file_close(file);
+
+		if (err != DB_SUCCESS) {
+			ib::error() << "Failed to read the doublewrite file "
+				    << path;
+			return(err);
+		}
+	}
+}
+
+/** Free the contents of the doublewrite files that were read by
+buf_dblwr_load_files(). */
+static void buf_dblwr_free_recv_bufs()
+{
+	for (std::vector<byte*>::iterator it = buf_dblwr_recv_bufs.begin();
+	     it != buf_dblwr_recv_bufs.end(); ++it) {
+		aligned_free(*it);
+	}
+
+	buf_dblwr_recv_bufs.clear();
+}
+
+/** Free a doublewrite file descriptor.
+@param[in,out]	dblwr	doublewrite file */
+static void buf_dblwr_close_file(buf_dblwr_t* dblwr)
+{
+	ut_ad(dblwr->b_reserved == 0);
+
+	if (dblwr->write_buf_unaligned) {
+		os_file_close(dblwr->file);
+		ut_free(dblwr->write_buf_unaligned);
+		ut_free(dblwr->buf_block_arr);
+		os_event_destroy(dblwr->b_event);
+		mutex_free(&dblwr->mutex);
+	}
+
+	ut_free(dblwr->path);
+}
+
+/** Open or create the doublewrite files for batch flushing, that is,
+innodb_doublewrite_files for each buffer pool instance. Existing files
+are not truncated, because buf_dblwr_process() may not have restored
+the pages from them yet. If a file cannot be created, the doublewrite
+buffer in the system tablespace will be used. */
+static void buf_dblwr_create_files()
+{
+	const ulint	n_files = srv_buf_pool_instances
+		* srv_doublewrite_files;
+	const os_offset_t size = os_offset_t(srv_doublewrite_pages)
+		<< srv_page_size_shift;
+
+	ut_ad(srv_doublewrite_pages <= BUF_DBLWR_BATCH_MAX);
+
+	buf_dblwr_t*	files = static_cast<buf_dblwr_t*>(
+		ut_zalloc_nokey(n_files * sizeof *files));
+
+	for (ulint n = 0; n < n_files; n++) {
+		buf_dblwr_t*	dblwr = &files[n];
+		char		path[FN_REFLEN];
+		bool		success;
+
+		buf_dblwr_file_path(path, sizeof path, n);
+		dblwr->path = mem_strdup(path);
+
+		dblwr->file = os_file_create(
+			innodb_data_file_key, path,
+			OS_FILE_OPEN | OS_FILE_ON_ERROR_NO_EXIT
+			| OS_FILE_ON_ERROR_SILENT,
+			OS_FILE_NORMAL, OS_DATA_FILE, false, &success);
+
+		if (!success) {
+			dblwr->file = os_file_create(
+				innodb_data_file_key, path,
+				OS_FILE_CREATE | OS_FILE_ON_ERROR_NO_EXIT,
+				OS_FILE_NORMAL, OS_DATA_FILE, false,
+				&success);
+		}
+
+		if (!success) {
+			goto fail;
+		}
+
+		if (os_file_get_size(dblwr->file) < size
+		    && !os_file_set_size(path, dblwr->file, size)) {
+			os_file_close(dblwr->file);
+			goto fail;
+		}
+
+		mutex_create(LATCH_ID_BUF_DBLWR, &dblwr->mutex);
+		dblwr->b_event = os_event_create("dblwr_batch_event");
+		dblwr->batch_size = srv_doublewrite_pages;
+
+		/* One page for alignment, and one for
+		buf_dblwr_sort_batch(). */
+		dblwr->write_buf_unaligned = static_cast<byte*>(
+			ut_malloc_nokey((2 + srv_doublewrite_pages)
+					<< srv_page_size_shift));
+		dblwr->write_buf = static_cast<byte*>(
+			ut_align(dblwr->write_buf_unaligned,
+				 srv_page_size));
+		dblwr->reorder_buf = dblwr->write_buf
+			+ (srv_doublewrite_pages << srv_page_size_shift);
+		dblwr->buf_block_arr = static_cast<buf_page_t**>(
+			ut_zalloc_nokey(srv_doublewrite_pages
+					* sizeof(void*)));
+		continue;
+fail:
+		ib::error() << "Cannot create the doublewrite file " << path
+			    << "; using the doublewrite buffer in the"
+			    " system tablespace";
+		for (ulint i = 0; i <= n; i++) {
+			buf_dblwr_close_file(&files[i]);
+		}
+		ut_free(files);
+		return;
+	}
+
+	buf_dblwr_files = files;
+	buf_dblwr_n_files = n_files;
+
+	ib::info() << "Using " << n_files << " doublewrite files of "
+		   << srv_doublewrite_pages << " pages";
+}
+
+/** Determine which doublewrite buffer a page is written through
+in batch flushing.
+@param[in]	bpage	page that is being written
+@return the doublewrite file of the buffer pool instance of the page,
+or buf_dblwr */
+static buf_dblwr_t* buf_dblwr_for_batch(const buf_page_t* bpage)
+{
+	if (!buf_dblwr_files) {
+		return(buf_dblwr);
+	}
+
+	ut_ad(bpage->buf_pool_index < srv_buf_pool_instances);
+
+	return(&buf_dblwr_files[bpage->buf_pool_index * srv_doublewrite_files
+				+ bpage->id.fold() % srv_doublewrite_files]);
+}
+
 /****************************************************************//**
 Creates or initialializes the doublewrite buffer at a database start. */
 static
@@ -150,14 +360,23 @@ buf_dblwr_init(
 		ut_zalloc_nokey(buf_size * sizeof(bool)));
 
 	buf_dblwr->write_buf_unaligned = static_cast<byte*>(
-		ut_malloc_nokey((1 + buf_size) << srv_page_size_shift));
+		ut_malloc_nokey((2 + buf_size) << srv_page_size_shift));
 
 	buf_dblwr->write_buf = static_cast<byte*>(
 		ut_align(buf_dblwr->write_buf_unaligned,
 			 srv_page_size));
 
+	buf_dblwr->reorder_buf = buf_dblwr->write_buf
+		+ (buf_size << srv_page_size_shift);
+
 	buf_dblwr->buf_block_arr = static_cast<buf_page_t**>(
 		ut_zalloc_nokey(buf_size * sizeof(void*)));
+
+	buf_dblwr->batch_size = srv_doublewrite_batch_size;
+
+	if (srv_doublewrite_files && !srv_read_only_mode) {
+		buf_dblwr_create_files();
+	}
 }
 
 /** Create the doublewrite buffer if the doublewrite buffer header
@@ -411,6 +630,13 @@ buf_dblwr_init_or_load_pages(
 	    == TRX_SYS_DOUBLEWRITE_MAGIC_N) {
 		/* The doublewrite buffer has been created */
 
+		err = buf_dblwr_load_files();
+
+		if (err != DB_SUCCESS) {
+			ut_free(unaligned_read_buf);
+			return(err);
+		}
+
 		buf_dblwr_init(doublewrite);
 
 		block1 = buf_dblwr->block1;
@@ -668,6 +894,7 @@ buf_dblwr_process()
 	}
 
 	recv_dblwr.pages.clear();
+	buf_dblwr_free_recv_bufs();
 
 	fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
 	aligned_free(read_buf);
@@ -687,6 +914,7 @@ buf_dblwr_free()
 	os_event_destroy(buf_dblwr->s_event);
 	ut_free(buf_dblwr->write_buf_unaligned);
 	buf_dblwr->write_buf_unaligned = NULL;
+	buf_dblwr->reorder_buf = NULL;
 
 	ut_free(buf_dblwr->buf_block_arr);
 	buf_dblwr->buf_block_arr = NULL;
@@ -694,6 +922,15 @@ buf_dblwr_free()
 	ut_free(buf_dblwr->in_use);
 	buf_dblwr->in_use = NULL;
 
+	for (ulint i = 0; i < buf_dblwr_n_files; i++) {
+		buf_dblwr_close_file(&buf_dblwr_files[i]);
+	}
+
+	ut_free(buf_dblwr_files);
+	buf_dblwr_files = NULL;
+	buf_dblwr_n_files = 0;
+	buf_dblwr_free_recv_bufs();
+
 	mutex_free(&buf_dblwr->mutex);
 	ut_free(buf_dblwr);
 	buf_dblwr = NULL;
@@ -715,28 +952,33 @@ buf_dblwr_update(
 	switch (flush_type) {
 	case BUF_FLUSH_LIST:
 	case BUF_FLUSH_LRU:
-		mutex_enter(&buf_dblwr->mutex);
+		{
+			buf_dblwr_t*	dblwr = buf_dblwr_for_batch(bpage);
 
-		ut_ad(buf_dblwr->batch_running);
-		ut_ad(buf_dblwr->b_reserved > 0);
-		ut_ad(buf_dblwr->b_reserved <= buf_dblwr->first_free);
+			mutex_enter(&dblwr->mutex);
 
-		buf_dblwr->b_reserved--;
+			ut_ad(dblwr->batch_running);
+			ut_ad(dblwr->b_reserved > 0);
+			ut_ad(dblwr->b_reserved <= dblwr->first_free);
 
-		if (buf_dblwr->b_reserved == 0) {
-			mutex_exit(&buf_dblwr->mutex);
-			/* This will finish the batch. Sync data files
-			to the disk. */
-			fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
-			mutex_enter(&buf_dblwr->mutex);
+			dblwr->b_reserved--;
 
-			/* We can now reuse the doublewrite memory buffer: */
-			buf_dblwr->first_free = 0;
-			buf_dblwr->batch_running = false;
-			os_event_set(buf_dblwr->b_event);
-		}
+			if (dblwr->b_reserved == 0) {
+				mutex_exit(&dblwr->mutex);
+				/* This will finish the batch. Sync data
+				files to the disk. */
+				fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
+				mutex_enter(&dblwr->mutex);
 
-		mutex_exit(&buf_dblwr->mutex);
+				/* We can now reuse the doublewrite
+				memory buffer: */
+				dblwr->first_free = 0;
+				dblwr->batch_running = false;
+				os_event_set(dblwr->b_event);
+			}
+
+			mutex_exit(&dblwr->mutex);
+		}
 		break;
 	case BUF_FLUSH_SINGLE_PAGE:
 		{
@@ -918,39 +1160,111 @@ buf_dblwr_write_block_to_datafile(
 	}
 }
 
-/********************************************************************//**
-Flushes possible buffered writes from the doublewrite memory buffer to disk,
-and also wakes up the aio thread if simulated aio is used. It is very
-important to call this function after a batch of writes has been posted,
-and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
-void
-buf_dblwr_flush_buffered_writes()
+/** Sort the pages of a doublewrite batch by page identifier, so that
+pages that are adjacent in a data file will also be adjacent in
+write_buf and can be written to the data file with a single request.
+@param[in,out]	dblwr	doublewrite buffer
+@param[in]	n	number of pages in the batch */
+static void buf_dblwr_sort_batch(buf_dblwr_t* dblwr, ulint n)
 {
-	byte*		write_buf;
-	ulint		first_free;
-	ulint		len;
+	ulint		order[BUF_DBLWR_BATCH_MAX];
+	buf_page_t**	arr = dblwr->buf_block_arr;
+	byte*		buf = dblwr->write_buf;
 
-	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
-		/* Sync the writes to the disk. */
-		buf_dblwr_sync_datafiles();
-		/* Now we flush the data to disk (for example, with fsync) */
-		fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
-		return;
+	ut_ad(n <= dblwr->batch_size);
+	ut_ad(n <= BUF_DBLWR_BATCH_MAX);
+
+	for (ulint i = 0; i < n; i++) {
+		order[i] = i;
 	}
 
-	ut_ad(!srv_read_only_mode);
+	std::sort(order, order + n, [arr](ulint a, ulint b)
+		  {
+			  return arr[a]->id < arr[b]->id;
+		  });
+
+	/* Apply the permutation one cycle at a time: position j
+	receives the page that was at position order[j]. */
+	for (ulint i = 0; i < n; i++) {
+		if (order[i] == i) {
+			continue;
+		}
+
+		buf_page_t*	bpage = arr[i];
+		ulint		j = i;
+
+		memcpy(dblwr->reorder_buf,
+		       buf + (i << srv_page_size_shift), srv_page_size);
+
+		for (ulint k; (k = order[j]) != i; j = k) {
+			memcpy(buf + (j << srv_page_size_shift),
+			       buf + (k << srv_page_size_shift),
+			       srv_page_size);
+			arr[j] = arr[k];
+			order[j] = j;
+		}
+
+		memcpy(buf + (j << srv_page_size_shift),
+		       dblwr->reorder_buf, srv_page_size);
+		arr[j] = bpage;
+		order[j] = j;
+	}
+}
+
+/** Determine how many pages of a sorted doublewrite batch, starting at
+a given position, can be written to their data file with one request.
+@param[in]	dblwr	doublewrite buffer
+@param[in]	first	position of the first page in the batch
+@param[in]	n	number of pages in the batch
+@return number of consecutive pages of the same tablespace */
+static ulint buf_dblwr_run_length(const buf_dblwr_t* dblwr, ulint first,
+				  ulint n)
+{
+	const buf_page_t* const*	arr = dblwr->buf_block_arr;
+	const buf_page_t*		bpage = arr[first];
+
+	if (bpage->id.space() == TRX_SYS_SPACE
+	    || bpage->zip.data != NULL
+	    || bpage->real_size != srv_page_size) {
+		/* The system tablespace may consist of several files,
+		and compressed pages are not written from write_buf. */
+		return(1);
+	}
+
+	ulint	len = 1;
+
+	for (ulint i = first + 1; i < n; i++, len++) {
+		const buf_page_t*	next = arr[i];
+
+		if (next->id.space() != bpage->id.space()
+		    || next->id.page_no() != bpage->id.page_no() + len
+		    || next->zip.data != NULL
+		    || next->real_size != srv_page_size) {
+			break;
+		}
+	}
+
+	return(len);
+}
+
+/** Write a batch of pages to a doublewrite buffer and to the data files.
+@param[in,out]	dblwr	buf_dblwr or one of buf_dblwr_files */
+static void buf_dblwr_flush_batch(buf_dblwr_t* dblwr)
+{
+	byte*		write_buf;
+	ulint		first_free;
+	ulint		len;
 
 try_again:
-	mutex_enter(&buf_dblwr->mutex);
+	mutex_enter(&dblwr->mutex);
 
 	/* Write first to doublewrite buffer blocks. We use synchronous
 	aio and thus know that file write has been completed when the
 	control returns. */
 
-	if (buf_dblwr->first_free == 0) {
+	if (dblwr->first_free == 0) {
 
-		mutex_exit(&buf_dblwr->mutex);
+		mutex_exit(&dblwr->mutex);
 
 		/* Wake possible simulated aio thread as there could be
 		system temporary tablespace pages active for flushing.
@@ -961,38 +1275,40 @@ buf_dblwr_flush_buffered_writes()
 		return;
 	}
 
-	if (buf_dblwr->batch_running) {
+	if (dblwr->batch_running) {
 		/* Another thread is running the batch right now. Wait
 		for it to finish. */
-		int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		int64_t	sig_count = os_event_reset(dblwr->b_event);
+		mutex_exit(&dblwr->mutex);
 
 		os_aio_simulated_wake_handler_threads();
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
+		os_event_wait_low(dblwr->b_event, sig_count);
 		goto try_again;
 	}
 
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
+	ut_ad(dblwr->first_free == dblwr->b_reserved);
 
 	/* Disallow anyone else to post to doublewrite buffer or to
 	start another batch of flushing. */
-	buf_dblwr->batch_running = true;
-	first_free = buf_dblwr->first_free;
+	dblwr->batch_running = true;
+	first_free = dblwr->first_free;
 
 	/* Now safe to release the mutex. Note that though no other
 	thread is allowed to post to the doublewrite batch flushing
 	but any threads working on single page flushes are allowed
 	to proceed. */
-	mutex_exit(&buf_dblwr->mutex);
+	mutex_exit(&dblwr->mutex);
+
+	buf_dblwr_sort_batch(dblwr, first_free);
 
-	write_buf = buf_dblwr->write_buf;
+	write_buf = dblwr->write_buf;
 
 	for (ulint
 #if defined(UNIV_DEBUG) || !defined(DBUG_OFF)
 	     len2 = 0,
 #endif
 	     i = 0;
-	     i < buf_dblwr->first_free;
+	     i < dblwr->first_free;
 #if defined(UNIV_DEBUG) || !defined(DBUG_OFF)
 	     len2 += srv_page_size,
 #endif
@@ -1000,7 +1316,7 @@ buf_dblwr_flush_buffered_writes()
 
 		const buf_block_t*	block;
 
-		block = (buf_block_t*) buf_dblwr->buf_block_arr[i];
+		block = (buf_block_t*) dblwr->buf_block_arr[i];
 
 		if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
 		    || block->page.zip.data) {
@@ -1015,57 +1331,98 @@ buf_dblwr_flush_buffered_writes()
 		ut_d(buf_dblwr_check_page_lsn(block->page, write_buf + len2));
 	}
 
-	/* Write out the first block of the doublewrite buffer */
-	len = std::min<ulint>(TRX_SYS_DOUBLEWRITE_BLOCK_SIZE,
-			      buf_dblwr->first_free) << srv_page_size_shift;
+	if (dblwr->path) {
+		/* A doublewrite file holds the whole batch. */
+		if (os_file_write(IORequestWrite, dblwr->path, dblwr->file,
+				  write_buf, 0,
+				  first_free << srv_page_size_shift)
+		    != DB_SUCCESS) {
+			ib::fatal() << "Cannot write to the doublewrite file "
+				    << dblwr->path;
+		}
 
-	fil_io(IORequestWrite, true,
-	       page_id_t(TRX_SYS_SPACE, buf_dblwr->block1), 0,
-	       0, len, (void*) write_buf, NULL);
+		/* Now flush the doublewrite buffer data to disk */
+		os_file_flush(dblwr->file);
+	} else {
+		/* Write out the first block of the doublewrite buffer */
+		len = std::min<ulint>(TRX_SYS_DOUBLEWRITE_BLOCK_SIZE,
+				      first_free) << srv_page_size_shift;
+
+		fil_io(IORequestWrite, true,
+		       page_id_t(TRX_SYS_SPACE, dblwr->block1), 0,
+		       0, len, (void*) write_buf, NULL);
+
+		if (first_free > TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
+			/* Write out the second block of the
+			doublewrite buffer. */
+			len = (first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
+				<< srv_page_size_shift;
+
+			write_buf = dblwr->write_buf
+				+ (TRX_SYS_DOUBLEWRITE_BLOCK_SIZE
+				   << srv_page_size_shift);
+
+			fil_io(IORequestWrite, true,
+			       page_id_t(TRX_SYS_SPACE, dblwr->block2), 0,
+			       0, len, (void*) write_buf, NULL);
+		}
 
-	if (buf_dblwr->first_free <= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
-		/* No unwritten pages in the second block. */
-		goto flush;
+		/* Now flush the doublewrite buffer data to disk */
+		fil_flush(TRX_SYS_SPACE);
 	}
 
-	/* Write out the second block of the doublewrite buffer. */
-	len = (buf_dblwr->first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
-	       << srv_page_size_shift;
-
-	write_buf = buf_dblwr->write_buf
-		+ (TRX_SYS_DOUBLEWRITE_BLOCK_SIZE << srv_page_size_shift);
-
-	fil_io(IORequestWrite, true,
-	       page_id_t(TRX_SYS_SPACE, buf_dblwr->block2), 0,
-	       0, len, (void*) write_buf, NULL);
-
-flush:
 	/* increment the doublewrite flushed pages counter */
-	srv_stats.dblwr_pages_written.add(buf_dblwr->first_free);
+	srv_stats.dblwr_pages_written.add(first_free);
 	srv_stats.dblwr_writes.inc();
 
-	/* Now flush the doublewrite buffer data to disk */
-	fil_flush(TRX_SYS_SPACE);
-
 	/* We know that the writes have been flushed to disk now
 	and in recovery we will find them in the doublewrite buffer
 	blocks. Next do the writes to the intended positions. */
 
-	/* Up to this point first_free and buf_dblwr->first_free are
-	same because we have set the buf_dblwr->batch_running flag
+	/* Up to this point first_free and dblwr->first_free are
+	same because we have set the dblwr->batch_running flag
 	disallowing any other thread to post any request but we
-	can't safely access buf_dblwr->first_free in the loop below.
+	can't safely access dblwr->first_free in the loop below.
 	This is so because it is possible that after we are done with
 	the last iteration and before we terminate the loop, the batch
 	gets finished in the IO helper thread and another thread posts
-	a new batch setting buf_dblwr->first_free to a higher value.
-	If this happens and we are using buf_dblwr->first_free in the
+	a new batch setting dblwr->first_free to a higher value.
+	If this happens and we are using dblwr->first_free in the
 	loop termination condition then we'll end up dispatching
 	the same block twice from two different threads. */
-	ut_ad(first_free == buf_dblwr->first_free);
-	for (ulint i = 0; i < first_free; i++) {
-		buf_dblwr_write_block_to_datafile(
-			buf_dblwr->buf_block_arr[i], false);
+	ut_ad(first_free == dblwr->first_free);
+
+	/* Adjacent pages of a tablespace are written with one
+	synchronous request straight from write_buf. Their completion
+	is deferred until all writes of the batch have been posted,
+	because the completion of the last page of the batch allows
+	other threads to reuse dblwr->buf_block_arr. */
+	buf_page_t*	coalesced[BUF_DBLWR_BATCH_MAX];
+	ulint		n_coalesced = 0;
+
+	for (ulint i = 0; i < first_free; ) {
+		const ulint	n = buf_dblwr_run_length(dblwr, i, first_free);
+
+		if (n == 1) {
+			buf_dblwr_write_block_to_datafile(
+				dblwr->buf_block_arr[i++], false);
+			continue;
+		}
+
+		fil_io(IORequestWrite, true,
+		       dblwr->buf_block_arr[i]->id, 0, 0,
+		       n << srv_page_size_shift,
+		       dblwr->write_buf + (i << srv_page_size_shift),
+		       NULL);
+
+		memcpy(coalesced + n_coalesced,
+		       dblwr->buf_block_arr + i, n * sizeof *coalesced);
+		n_coalesced += n;
+		i += n;
+	}
+
+	for (ulint i = 0; i < n_coalesced; i++) {
+		buf_page_io_complete(coalesced[i], true);
 	}
 
 	/* Wake possible simulated aio thread to actually post the
@@ -1075,6 +1432,44 @@ buf_dblwr_flush_buffered_writes()
 	os_aio_simulated_wake_handler_threads();
 }
 
+/** Flushes possible buffered writes from the doublewrite memory buffer to disk,
+and also wakes up the aio thread if simulated aio is used. It is very
+important to call this function after a batch of writes has been posted,
+and also when we may have to wait for a page latch! Otherwise a deadlock
+of threads can occur.
+@param[in]	instance_no	buffer pool instance whose doublewrite
+files should be written (innodb_doublewrite_files>0) */
+void
+buf_dblwr_flush_buffered_writes(ulint instance_no)
+{
+	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
+		/* Sync the writes to the disk. */
+		buf_dblwr_sync_datafiles();
+		/* Now we flush the data to disk (for example, with fsync) */
+		fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
+		return;
+	}
+
+	ut_ad(!srv_read_only_mode);
+
+	if (!buf_dblwr_files) {
+		buf_dblwr_flush_batch(buf_dblwr);
+		return;
+	}
+
+	ut_ad(instance_no < srv_buf_pool_instances);
+
+	/* Each buffer pool instance writes and syncs its own files,
+	so that the page cleaner threads of different instances do not
+	wait for each other. */
+	buf_dblwr_t*	dblwr = &buf_dblwr_files[
+		instance_no * srv_doublewrite_files];
+
+	for (ulint i = 0; i < srv_doublewrite_files; i++) {
+		buf_dblwr_flush_batch(&dblwr[i]);
+	}
+}
+
 /********************************************************************//**
 Posts a buffer page for writing. If the doublewrite memory buffer is
 full, calls buf_dblwr_flush_buffered_writes and waits for for free
@@ -1086,12 +1481,14 @@ buf_dblwr_add_to_batch(
 {
 	ut_a(buf_page_in_file(bpage));
 
+	buf_dblwr_t*	dblwr = buf_dblwr_for_batch(bpage);
+
 try_again:
-	mutex_enter(&buf_dblwr->mutex);
+	mutex_enter(&dblwr->mutex);
 
-	ut_a(buf_dblwr->first_free <= srv_doublewrite_batch_size);
+	ut_a(dblwr->first_free <= dblwr->batch_size);
 
-	if (buf_dblwr->batch_running) {
+	if (dblwr->batch_running) {
 
 		/* This not nearly as bad as it looks. There is only
 		page_cleaner thread which does background flushing
@@ -1099,24 +1496,24 @@ buf_dblwr_add_to_batch(
 		point. The only exception is when a user thread is
 		forced to do a flush batch because of a sync
 		checkpoint. */
-		int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		int64_t	sig_count = os_event_reset(dblwr->b_event);
+		mutex_exit(&dblwr->mutex);
 		os_aio_simulated_wake_handler_threads();
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
+		os_event_wait_low(dblwr->b_event, sig_count);
 		goto try_again;
 	}
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (dblwr->first_free == dblwr->batch_size) {
+		mutex_exit(&dblwr->mutex);
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_batch(dblwr);
 
 		goto try_again;
 	}
 
-	byte*	p = buf_dblwr->write_buf
-		+ srv_page_size * buf_dblwr->first_free;
+	byte*	p = dblwr->write_buf
+		+ srv_page_size * dblwr->first_free;
 
 	/* We request frame here to get correct buffer in case of
 	encryption and/or page compression */
@@ -1133,24 +1530,24 @@ buf_dblwr_add_to_batch(
 		memcpy(p, frame, srv_page_size);
 	}
 
-	buf_dblwr->buf_block_arr[buf_dblwr->first_free] = bpage;
+	dblwr->buf_block_arr[dblwr->first_free] = bpage;
 
-	buf_dblwr->first_free++;
-	buf_dblwr->b_reserved++;
+	dblwr->first_free++;
+	dblwr->b_reserved++;
 
-	ut_ad(!buf_dblwr->batch_running);
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
-	ut_ad(buf_dblwr->b_reserved <= srv_doublewrite_batch_size);
+	ut_ad(!dblwr->batch_running);
+	ut_ad(dblwr->first_free == dblwr->b_reserved);
+	ut_ad(dblwr->b_reserved <= dblwr->batch_size);
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (dblwr->first_free == dblwr->batch_size) {
+		mutex_exit(&dblwr->mutex);
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_batch(dblwr);
 
 		return;
 	}
 
-	mutex_exit(&(buf_dblwr->mutex));
+	mutex_exit(&dblwr->mutex);
 }
 
 /********************************************************************//**
@@ -33,7 +33,10 @@ Created April 08, 2011 Vasil Dimov
 
 #include "buf0buf.h"
 #include "buf0dump.h"
+#include "buf0lru.h"
+#include "buf0rea.h"
 #include "dict0dict.h"
+#include "mach0data.h"
 #include "os0file.h"
 #include "os0thread.h"
 #include "srv0srv.h"
@@ -42,6 +45,8 @@ Created April 08, 2011 Vasil Dimov
 #include "ut0byte.h"
 
 #include <algorithm>
+#include <vector>
+#include <my_counter.h>
 
 #include "mysql/service_wsrep.h" /* wsrep_recovery */
 #include <my_service_manager.h>
@@ -58,7 +63,7 @@ take after being waked up. */
 static volatile bool	buf_dump_should_start;
 static volatile bool	buf_load_should_start;
 
-static ibool	buf_load_abort_flag = FALSE;
+static volatile ibool	buf_load_abort_flag = FALSE;
 
 /* Used to temporary store dump info in order to avoid IO while holding
 buffer pool mutex during dump and also to sort the contents of the dump
@@ -71,6 +76,30 @@ typedef ib_uint64_t	buf_dump_t;
 #define BUF_DUMP_SPACE(a)		((ulint) ((a) >> 32))
 #define BUF_DUMP_PAGE(a)		((ulint) ((a) & 0xFFFFFFFFUL))
 
+/** Start of a binary dump file (innodb_buffer_pool_dump_format=binary).
+It is followed by an entry for each page, in ascending (space, page) order:
+the compressed difference to the preceding space id; the compressed page
+number if the space id changed, or else the difference to the preceding
+page number; and the compressed position of the page in the LRU list of its
+buffer pool instance (0 = most recently used). A text dump cannot start
+with these bytes. */
+#define BUF_DUMP_MAGIC		"IBBPDUMP"
+/** Length of BUF_DUMP_MAGIC */
+#define BUF_DUMP_MAGIC_LEN	(sizeof BUF_DUMP_MAGIC - 1)
+
+/** A page of a binary dump */
+struct buf_dump_lru_t {
+	/** BUF_DUMP_CREATE(space, page) */
+	buf_dump_t	id;
+	/** position in the LRU list, 0 = most recently used */
+	ib_uint32_t	lru;
+
+	bool operator<(const buf_dump_lru_t& other) const
+	{
+		return(id < other.id);
+	}
+};
+
 /*****************************************************************//**
 Wakes up the buffer pool dump/load thread and instructs it to start
 a dump. This function is called by MySQL code via buffer_pool_dump_now()
@@ -243,6 +272,42 @@ static void buf_dump_generate_path(char *path, size_t path_size)
 	}
 }
 
+/** Write a binary buffer pool dump after BUF_DUMP_MAGIC.
+@param[in,out]	f	dump file
+@param[in,out]	pages	pages of all buffer pool instances; will be sorted
+@return whether the pages were written successfully */
+static bool buf_dump_write_binary(FILE* f, std::vector<buf_dump_lru_t>& pages)
+{
+	byte	buf[4096];
+	byte*	ptr = buf;
+	ulint	space_id = 0;
+	ulint	page_no = 0;
+
+	std::sort(pages.begin(), pages.end());
+
+	for (std::vector<buf_dump_lru_t>::const_iterator it = pages.begin();
+	     it != pages.end(); ++it) {
+		if (ptr > buf + sizeof buf - 3 * 5) {
+			if (fwrite(buf, ptr - buf, 1, f) != 1) {
+				return(false);
+			}
+			ptr = buf;
+		}
+
+		const ulint	s = BUF_DUMP_SPACE(it->id);
+		const ulint	p = BUF_DUMP_PAGE(it->id);
+
+		ptr += mach_write_compressed(ptr, s - space_id);
+		ptr += mach_write_compressed(ptr, s == space_id
+					     ? p - page_no : p);
+		ptr += mach_write_compressed(ptr, it->lru);
+		space_id = s;
+		page_no = p;
+	}
+
+	return(ptr == buf || fwrite(buf, ptr - buf, 1, f) == 1);
+}
+
 /*****************************************************************//**
 Perform a buffer pool dump into the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -274,7 +339,7 @@ buf_dump(
 			full_filename);
 
 #if defined(__GLIBC__) || defined(__WIN__) || O_CLOEXEC == 0
-	f = fopen(tmp_filename, "w" STR_O_CLOEXEC);
+	f = fopen(tmp_filename, "wb" STR_O_CLOEXEC);
 #else
 	{
 		int	fd;
@@ -295,6 +360,19 @@ buf_dump(
 	}
 	/* else */
 
+	const bool			binary
+		= srv_buf_dump_format == BUF_DUMP_BINARY;
+	std::vector<buf_dump_lru_t>	binary_pages;
+
+	if (binary && fwrite(BUF_DUMP_MAGIC, BUF_DUMP_MAGIC_LEN, 1, f) != 1) {
+		fclose(f);
+		buf_dump_status(STATUS_ERR,
+				"Cannot write to '%s': %s",
+				tmp_filename, strerror(errno));
+		/* leave tmp_filename to exist */
+		return;
+	}
+
 	/* walk through each buffer pool */
 	for (i = 0; i < srv_buf_pool_instances && !SHOULD_QUIT(); i++) {
 		buf_pool_t*		buf_pool;
@@ -375,6 +453,20 @@ buf_dump(
 		ut_a(j <= n_pages);
 		n_pages = j;
 
+		if (binary) {
+			/* The pages of all instances are sorted and
+			written by buf_dump_write_binary(). */
+			for (j = 0; j < n_pages; j++) {
+				const buf_dump_lru_t	page = {
+					dump[j], ib_uint32_t(j)
+				};
+				binary_pages.push_back(page);
+			}
+
+			ut_free(dump);
+			continue;
+		}
+
 		for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
 			ret = fprintf(f, ULINTPF "," ULINTPF "\n",
 				      BUF_DUMP_SPACE(dump[j]),
@@ -401,6 +493,16 @@ buf_dump(
 		ut_free(dump);
 	}
 
+	if (binary && !SHOULD_QUIT()
+	    && !buf_dump_write_binary(f, binary_pages)) {
+		fclose(f);
+		buf_dump_status(STATUS_ERR,
+				"Cannot write to '%s': %s",
+				tmp_filename, strerror(errno));
+		/* leave tmp_filename to exist */
+		return;
+	}
+
 	ret = fclose(f);
 	if (ret != 0) {
 		buf_dump_status(STATUS_ERR,
@@ -455,12 +557,14 @@ buf_load_throttle_if_needed(
 	ulint*	last_check_time,	/*!< in/out: milliseconds since epoch
 					of the last time we did check if
 					throttling is needed, we do the check
-					every srv_io_capacity IO ops. */
+					every io_capacity IO ops. */
 	ulint*	last_activity_count,
-	ulint	n_io)			/*!< in: number of IO ops done since
+	ulint	n_io,			/*!< in: number of IO ops done since
 					buffer pool load has started */
+	ulint	io_capacity)		/*!< in: IO ops per second that
+					may be done */
 {
-	if (n_io % srv_io_capacity < srv_io_capacity - 1) {
+	if (n_io % io_capacity < io_capacity - 1) {
 		return;
 	}
 
@@ -470,7 +574,7 @@ buf_load_throttle_if_needed(
 		return;
 	}
 
-	/* srv_io_capacity IO operations have been performed by buffer pool
+	/* io_capacity IO operations have been performed by buffer pool
 	load since the last time we were here. */
 
 	/* If no other activity, then keep going without any delay. */
@@ -510,52 +614,39 @@ buf_load_throttle_if_needed(
 	*last_activity_count = srv_get_activity_count();
 }
 
-/*****************************************************************//**
-Perform a buffer pool load from the file specified by
-innodb_buffer_pool_filename. If any errors occur then the value of
-innodb_buffer_pool_load_status will be set accordingly, see buf_load_status().
-The dump filename can be specified by (relative to srv_data_home):
-SET GLOBAL innodb_buffer_pool_filename='filename'; */
+/** Read a text buffer pool dump.
+@param[in,out]	f		dump file, positioned at the start
+@param[in]	full_filename	name of the dump file
+@param[in]	max_n		maximum number of pages to read
+@param[out]	dump		pages sorted by (space, page), to be freed
+				with ut_free(), or NULL if the file was empty
+@param[out]	dump_n		number of elements in dump[]
+@return whether the file was read successfully */
 static
-void
-buf_load()
-/*======*/
+bool
+buf_load_read_text(
+	FILE*		f,
+	const char*	full_filename,
+	ulint		max_n,
+	buf_dump_t**	dump,
+	ulint*		dump_n)
 {
-	char		full_filename[OS_FILE_MAX_PATH];
-	char		now[32];
-	FILE*		f;
-	buf_dump_t*	dump;
-	ulint		dump_n;
-	ulint		total_buffer_pools_pages;
-	ulint		i;
-	ulint		space_id;
-	ulint		page_no;
-	int		fscanf_ret;
-
-	/* Ignore any leftovers from before */
-	buf_load_abort_flag = FALSE;
-
-	buf_dump_generate_path(full_filename, sizeof(full_filename));
-
-	buf_load_status(STATUS_INFO,
-			"Loading buffer pool(s) from %s", full_filename);
+	ulint	n;
+	ulint	i;
+	ulint	space_id;
+	ulint	page_no;
+	int	fscanf_ret;
 
-	f = fopen(full_filename, "r" STR_O_CLOEXEC);
-	if (f == NULL) {
-		buf_load_status(STATUS_INFO,
-				"Cannot open '%s' for reading: %s",
-				full_filename, strerror(errno));
-		return;
-	}
-	/* else */
+	*dump = NULL;
+	*dump_n = 0;
 
 	/* First scan the file to estimate how many entries are in it.
 	This file is tiny (approx 500KB per 1GB buffer pool), reading it
 	two times is fine. */
-	dump_n = 0;
+	n = 0;
 	while (fscanf(f, ULINTPF "," ULINTPF, &space_id, &page_no) == 2
 	       && !SHUTTING_DOWN()) {
-		dump_n++;
+		n++;
 	}
 
 	if (!SHUTTING_DOWN() && !feof(f)) {
@@ -566,48 +657,36 @@ buf_load()
 		} else {
 			what = "parsing";
 		}
-		fclose(f);
 		buf_load_status(STATUS_ERR, "Error %s '%s',"
 				" unable to load buffer pool (stage 1)",
 				what, full_filename);
-		return;
+		return(false);
 	}
 
 	/* If dump is larger than the buffer pool(s), then we ignore the
 	extra trailing. This could happen if a dump is made, then buffer
 	pool is shrunk and then load is attempted. */
-	total_buffer_pools_pages = buf_pool_get_n_pages()
-		* srv_buf_pool_instances;
-	if (dump_n > total_buffer_pools_pages) {
-		dump_n = total_buffer_pools_pages;
+	if (n > max_n) {
+		n = max_n;
 	}
 
-	if(dump_n != 0) {
-		dump = static_cast<buf_dump_t*>(ut_malloc_nokey(
-				dump_n * sizeof(*dump)));
-	} else {
-		fclose(f);
-		ut_sprintf_timestamp(now);
-		buf_load_status(STATUS_INFO,
-				"Buffer pool(s) load completed at %s"
-				" (%s was empty)", now, full_filename);
-		return;
+	if (n == 0) {
+		return(true);
 	}
 
-	if (dump == NULL) {
-		fclose(f);
+	*dump = static_cast<buf_dump_t*>(ut_malloc_nokey(n * sizeof **dump));
+
+	if (*dump == NULL) {
 		buf_load_status(STATUS_ERR,
 				"Cannot allocate " ULINTPF " bytes: %s",
-				dump_n * sizeof(*dump),
+				n * sizeof **dump,
 				strerror(errno));
-		return;
+		return(false);
 	}
 
 	rewind(f);
 
-	export_vars.innodb_buffer_pool_load_incomplete = 1;
-
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
+	for (i = 0; i < n && !SHUTTING_DOWN(); i++) {
 		fscanf_ret = fscanf(f, ULINTPF "," ULINTPF,
 				    &space_id, &page_no);
 
@@ -617,18 +696,18 @@ buf_load()
 			}
 			/* else */
 
-			ut_free(dump);
-			fclose(f);
+			ut_free(*dump);
+			*dump = NULL;
 			buf_load_status(STATUS_ERR,
 					"Error parsing '%s', unable"
 					" to load buffer pool (stage 2)",
 					full_filename);
-			return;
+			return(false);
 		}
 
 		if (space_id > ULINT32_MASK || page_no > ULINT32_MASK) {
-			ut_free(dump);
-			fclose(f);
+			ut_free(*dump);
+			*dump = NULL;
 			buf_load_status(STATUS_ERR,
 					"Error parsing '%s': bogus"
 					" space,page " ULINTPF "," ULINTPF
@@ -637,129 +716,491 @@ buf_load()
 					full_filename,
 					space_id, page_no,
 					i);
-			return;
+			return(false);
 		}
 
-		dump[i] = BUF_DUMP_CREATE(space_id, page_no);
+		(*dump)[i] = BUF_DUMP_CREATE(space_id, page_no);
 	}
 
 	/* Set dump_n to the actual number of initialized elements,
-	i could be smaller than dump_n here if the file got truncated after
+	i could be smaller than n here if the file got truncated after
 	we read it the first time. */
-	dump_n = i;
+	if (i == 0) {
+		ut_free(*dump);
+		*dump = NULL;
+	} else if (!SHUTTING_DOWN()) {
+		std::sort(*dump, *dump + i);
+	}
 
-	fclose(f);
+	*dump_n = i;
+	return(true);
+}
 
-	if (dump_n == 0) {
-		ut_free(dump);
-		ut_sprintf_timestamp(now);
-		buf_load_status(STATUS_INFO,
-				"Buffer pool(s) load completed at %s"
-				" (%s was empty or had errors)", now, full_filename);
-		return;
+/** Read a binary buffer pool dump, written by buf_dump_write_binary().
+@param[in,out]	f		dump file, positioned after BUF_DUMP_MAGIC
+@param[in]	full_filename	name of the dump file
+@param[in]	max_n		maximum number of pages to read
+@param[out]	dump		pages sorted by (space, page), to be freed
+				with ut_free(), or NULL if the file was empty
+@param[out]	lru		LRU positions of dump[], to be freed
+				with ut_free(), or NULL if the file was empty
+@param[out]	dump_n		number of elements in dump[] and lru[]
+@return whether the file was read successfully */
+static
+bool
+buf_load_read_binary(
+	FILE*		f,
+	const char*	full_filename,
+	ulint		max_n,
+	buf_dump_t**	dump,
+	ib_uint32_t**	lru,
+	ulint*		dump_n)
+{
+	long	size;
+
+	*dump = NULL;
+	*lru = NULL;
+	*dump_n = 0;
+
+	if (fseek(f, 0, SEEK_END) || (size = ftell(f)) < 0
+	    || fseek(f, BUF_DUMP_MAGIC_LEN, SEEK_SET)) {
+		buf_load_status(STATUS_ERR, "Error reading '%s': %s,"
+				" unable to load buffer pool",
+				full_filename, strerror(errno));
+		return(false);
 	}
 
-	if (!SHUTTING_DOWN()) {
-		std::sort(dump, dump + dump_n);
+	size -= BUF_DUMP_MAGIC_LEN;
+
+	if (size == 0) {
+		return(true);
 	}
 
-	ulint		last_check_time = 0;
-	ulint		last_activity_cnt = 0;
+	/* Each entry occupies at least 3 bytes. */
+	const ulint	n = ulint(size) / 3;
+	byte*		buf = static_cast<byte*>(ut_malloc_nokey(ulint(size)));
+	*dump = static_cast<buf_dump_t*>(ut_malloc_nokey(n * sizeof **dump));
+	*lru = static_cast<ib_uint32_t*>(ut_malloc_nokey(n * sizeof **lru));
 
-	/* Avoid calling the expensive fil_space_acquire_silent() for each
-	page within the same tablespace. dump[] is sorted by (space, page),
-	so all pages from a given tablespace are consecutive. */
-	ulint		cur_space_id = BUF_DUMP_SPACE(dump[0]);
-	fil_space_t*	space = fil_space_acquire_silent(cur_space_id);
-	ulint		zip_size = space ? space->zip_size() : 0;
+	if (buf == NULL || *dump == NULL || *lru == NULL) {
+		buf_load_status(STATUS_ERR,
+				"Cannot allocate " ULINTPF " bytes: %s",
+				ulint(size) + n * (sizeof **dump
+						   + sizeof **lru),
+				strerror(errno));
+		goto err_exit;
+	}
 
-	/* JAN: TODO: MySQL 5.7 PSI
-#ifdef HAVE_PSI_STAGE_INTERFACE
-	PSI_stage_progress*	pfs_stage_progress
-		= mysql_set_stage(srv_stage_buffer_pool_load.m_key);
-	#endif*/ /* HAVE_PSI_STAGE_INTERFACE */
-	/*
-	mysql_stage_set_work_estimated(pfs_stage_progress, dump_n);
-	mysql_stage_set_work_completed(pfs_stage_progress, 0);
-	*/
+	if (fread(buf, size, 1, f) != 1) {
+		buf_load_status(STATUS_ERR, "Error reading '%s',"
+				" unable to load buffer pool",
+				full_filename);
+		goto err_exit;
+	}
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
+	{
+		const byte*	ptr = buf;
+		const byte*	end = buf + size;
+		ulint		space_id = 0;
+		ulint		page_no = 0;
+		ulint		i;
+
+		for (i = 0; ptr < end && !SHUTTING_DOWN(); i++) {
+			const ulint	space_delta
+				= mach_parse_compressed(&ptr, end);
+			const ulint	page = ptr
+				? mach_parse_compressed(&ptr, end) : 0;
+			const ulint	pos = ptr
+				? mach_parse_compressed(&ptr, end) : 0;
+
+			if (space_delta) {
+				space_id += space_delta;
+				page_no = page;
+			} else {
+				page_no += page;
+			}
 
-		/* space_id for this iteration of the loop */
-		const ulint	this_space_id = BUF_DUMP_SPACE(dump[i]);
+			if (ptr == NULL || i >= n
+			    || space_id > ULINT32_MASK
+			    || page_no > ULINT32_MASK) {
+				buf_load_status(STATUS_ERR,
+						"Error parsing '%s' at entry "
+						ULINTPF ", unable to load"
+						" buffer pool",
+						full_filename, i);
+				goto err_exit;
+			}
 
-		if (this_space_id >= SRV_LOG_SPACE_FIRST_ID) {
-			/* Ignore the innodb_temporary tablespace. */
-			continue;
+			(*dump)[i] = BUF_DUMP_CREATE(space_id, page_no);
+			(*lru)[i] = ib_uint32_t(pos);
+		}
+
+		if (i > max_n) {
+			/* The dump is larger than the buffer pool(s).
+			Keep the max_n most recently used pages. */
+			std::vector<ib_uint32_t>	order(*lru, *lru + i);
+			std::nth_element(order.begin(),
+					 order.begin() + (max_n - 1),
+					 order.end());
+			const ib_uint32_t	limit = order[max_n - 1];
+			ulint			j = 0;
+
+			for (ulint k = 0; k < i && j < max_n; k++) {
+				if ((*lru)[k] <= limit) {
+					(*dump)[j] = (*dump)[k];
+					(*lru)[j++] = (*lru)[k];
+				}
+			}
+
+			i = j;
+		}
+
+		*dump_n = i;
+	}
+
+	ut_free(buf);
+	return(true);
+
+err_exit:
+	ut_free(buf);
+	ut_free(*dump);
+	ut_free(*lru);
+	*dump = NULL;
+	*lru = NULL;
+	return(false);
+}
+
+#ifdef UNIV_PFS_THREAD
+mysql_pfs_key_t	buf_load_thread_key;
+#endif /* UNIV_PFS_THREAD */
+
+/** Number of consecutive elements of the sorted dump that a buffer pool
+load thread reads at a time */
+static const ulint	BUF_LOAD_CHUNK = 1024;
+
+/** Buffer pool load shared by buf_load_thread() */
+struct buf_load_t {
+	/** pages to read, sorted by (space, page) */
+	const buf_dump_t*	dump;
+	/** number of elements in dump[] */
+	ulint			dump_n;
+	/** innodb_io_capacity share of each thread */
+	ulint			io_capacity;
+	/** start of the next BUF_LOAD_CHUNK of dump[] to read */
+	Atomic_counter<ulint>	next;
+	/** number of elements of dump[] that have been processed */
+	Atomic_counter<ulint>	n_done;
+};
+
+/** Read chunks of the dump until all of them have been assigned to a thread.
+@param[in,out]	load	buffer pool load */
+static void buf_load_chunks(buf_load_t* load)
+{
+	ulint	last_check_time = 0;
+	ulint	last_activity_cnt = 0;
+	ulint	n_io = 0;
+
+	for (;;) {
+		const ulint	start = (load->next += BUF_LOAD_CHUNK)
+			- BUF_LOAD_CHUNK;
+
+		if (start >= load->dump_n) {
+			return;
 		}
 
-		if (this_space_id != cur_space_id) {
-			if (space != NULL) {
-				space->release();
+		const ulint	end = std::min(start + BUF_LOAD_CHUNK,
+					       load->dump_n);
+
+		/* Avoid calling the expensive fil_space_acquire_silent()
+		for each page within the same tablespace. dump[] is sorted
+		by (space, page), so all pages from a given tablespace are
+		consecutive, and each chunk is read in file order. */
+		ulint		cur_space_id = BUF_DUMP_SPACE(load->dump[start]);
+		fil_space_t*	space = fil_space_acquire_silent(cur_space_id);
+		ulint		zip_size = space ? space->zip_size() : 0;
+
+		for (ulint i = start; i < end; i++) {
+			if (SHUTTING_DOWN() || buf_load_abort_flag) {
+				if (space != NULL) {
+					space->release();
+				}
+				return;
 			}
 
-			cur_space_id = this_space_id;
-			space = fil_space_acquire_silent(cur_space_id);
+			/* space_id for this iteration of the loop */
+			const ulint	this_space_id
+				= BUF_DUMP_SPACE(load->dump[i]);
+
+			if (this_space_id != cur_space_id) {
+				if (space != NULL) {
+					space->release();
+				}
+
+				cur_space_id = this_space_id;
+				space = fil_space_acquire_silent(cur_space_id);
 
-			if (space != NULL) {
-				zip_size = space->zip_size();
+				if (space != NULL) {
+					zip_size = space->zip_size();
+				}
 			}
+
+			/* JAN: TODO: As we use background page read below,
+			if tablespace is encrypted we cant use it. Ignore
+			also the innodb_temporary tablespace. */
+			if (this_space_id < SRV_LOG_SPACE_FIRST_ID
+			    && space != NULL
+			    && (!space->crypt_data
+				|| space->crypt_data->encryption
+				== FIL_ENCRYPTION_OFF
+				|| space->crypt_data->type
+				== CRYPT_SCHEME_UNENCRYPTED)) {
+				buf_read_page_background(
+					page_id_t(this_space_id,
+						  BUF_DUMP_PAGE(
+							  load->dump[i])),
+					zip_size, true);
+
+				if (n_io % 64 == 63) {
+					os_aio_simulated_wake_handler_threads();
+				}
+
+				buf_load_throttle_if_needed(
+					&last_check_time, &last_activity_cnt,
+					n_io++, load->io_capacity);
+			}
+
+#ifdef UNIV_DEBUG
+			if (++load->n_done >= srv_buf_pool_load_pages_abort) {
+				buf_load_abort_flag = TRUE;
+			}
+#else
+			load->n_done++;
+#endif
 		}
 
-		/* JAN: TODO: As we use background page read below,
-		if tablespace is encrypted we cant use it. */
-		if (space == NULL ||
-		   (space && space->crypt_data &&
-		    space->crypt_data->encryption != FIL_ENCRYPTION_OFF &&
-		    space->crypt_data->type != CRYPT_SCHEME_UNENCRYPTED)) {
-			continue;
+		if (space != NULL) {
+			space->release();
 		}
+	}
+}
+
+/** Thread that reads pages on behalf of buf_load_pages().
+@param[in]	arg	buf_load_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(buf_load_thread)(void* arg)
+{
+	my_thread_init();
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(buf_load_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	buf_load_chunks(static_cast<buf_load_t*>(arg));
+
+	my_thread_end();
+	/* buf_load_pages() will join this thread. */
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Read the dumped pages into the buffer pool, using up to
+innodb_buffer_pool_load_threads threads.
+@param[in]	dump	pages sorted by (space, page)
+@param[in]	dump_n	number of elements in dump[]
+@return number of elements of dump[] that were processed */
+static ulint buf_load_pages(const buf_dump_t* dump, ulint dump_n)
+{
+	const ulint	n_threads = std::min<ulint>(
+		srv_buf_load_threads,
+		(dump_n + BUF_LOAD_CHUNK - 1) / BUF_LOAD_CHUNK);
+
+	buf_load_t	load;
+	load.dump = dump;
+	load.dump_n = dump_n;
+	load.io_capacity = std::max<ulint>(srv_io_capacity / n_threads, 1);
+	load.next = 0;
+	load.n_done = 0;
 
-		buf_read_page_background(
-			page_id_t(this_space_id, BUF_DUMP_PAGE(dump[i])),
-			zip_size, true);
+	std::vector<os_thread_id_t>	threads(n_threads);
 
-		if (i % 64 == 63) {
-			os_aio_simulated_wake_handler_threads();
+	for (ulint i = 1; i < n_threads; i++) {
+		os_thread_create(buf_load_thread, &load, &threads[i]);
+	}
+
+	buf_load_chunks(&load);
+
+	for (ulint i = 1; i < n_threads; i++) {
+		os_thread_join(threads[i]);
+	}
+
+	return(load.n_done);
+}
+
+/** Orders elements of a binary dump from the least recently used */
+struct buf_load_lru_cmp {
+	/** LRU positions */
+	const ib_uint32_t*	lru;
+
+	bool operator()(ulint a, ulint b) const
+	{
+		return(lru[a] > lru[b]);
+	}
+};
+
+/** Move the loaded pages to the start of the LRU lists in the order in
+which they were at the time of the dump. Pages read by buf_load_pages()
+are added to the old end of the LRU lists, like read-ahead pages.
+@param[in]	dump	pages sorted by (space, page)
+@param[in]	lru	positions of dump[] in the LRU lists at dump time
+@param[in]	dump_n	number of elements in dump[] and lru[] */
+static
+void
+buf_load_restore_lru(
+	const buf_dump_t*	dump,
+	const ib_uint32_t*	lru,
+	ulint			dump_n)
+{
+	std::vector<ulint>	order(dump_n);
+
+	for (ulint i = 0; i < dump_n; i++) {
+		order[i] = i;
+	}
+
+	/* Make the least recently used pages young first, so that
+	the most recently used ones will end up at the start of the
+	LRU lists. */
+	buf_load_lru_cmp	cmp = { lru };
+	std::sort(order.begin(), order.end(), cmp);
+
+	for (ulint i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
+		const buf_dump_t	d = dump[order[i]];
+		const page_id_t		page_id(BUF_DUMP_SPACE(d),
+						BUF_DUMP_PAGE(d));
+		buf_pool_t*		buf_pool = buf_pool_get(page_id);
+		rw_lock_t*		hash_lock;
+
+		/* The page cannot be evicted while we are holding
+		buf_pool->mutex. */
+		buf_pool_mutex_enter(buf_pool);
+
+		if (buf_page_t* bpage = buf_page_hash_get_s_locked(
+			    buf_pool, page_id, &hash_lock)) {
+			rw_lock_s_unlock(hash_lock);
+			buf_LRU_make_block_young(bpage);
 		}
 
-		if (buf_load_abort_flag) {
-			if (space != NULL) {
-				space->release();
-			}
-			buf_load_abort_flag = FALSE;
-			ut_free(dump);
-			buf_load_status(
-				STATUS_INFO,
-				"Buffer pool(s) load aborted on request");
-			/* Premature end, set estimated = completed = i and
-			end the current stage event. */
-			/*
-			mysql_stage_set_work_estimated(pfs_stage_progress, i);
-			mysql_stage_set_work_completed(pfs_stage_progress,
-			i);
-			*/
+		buf_pool_mutex_exit(buf_pool);
+	}
+}
+
+/*****************************************************************//**
+Perform a buffer pool load from the file specified by
+innodb_buffer_pool_filename. If any errors occur then the value of
+innodb_buffer_pool_load_status will be set accordingly, see buf_load_status().
+The dump filename can be specified by (relative to srv_data_home):
+SET GLOBAL innodb_buffer_pool_filename='filename'; */
+static
+void
+buf_load()
+/*======*/
+{
+	char		full_filename[OS_FILE_MAX_PATH];
+	char		now[32];
+	FILE*		f;
+	byte		magic[BUF_DUMP_MAGIC_LEN];
+	buf_dump_t*	dump;
+	ib_uint32_t*	lru = NULL;
+	ulint		dump_n;
+	ulint		total_buffer_pools_pages;
+	bool		success;
+
+	/* Ignore any leftovers from before */
+	buf_load_abort_flag = FALSE;
+
+	buf_dump_generate_path(full_filename, sizeof(full_filename));
+
+	buf_load_status(STATUS_INFO,
+			"Loading buffer pool(s) from %s", full_filename);
+
+	f = fopen(full_filename, "rb" STR_O_CLOEXEC);
+	if (f == NULL) {
+		buf_load_status(STATUS_INFO,
+				"Cannot open '%s' for reading: %s",
+				full_filename, strerror(errno));
+		return;
+	}
+	/* else */
+
+	total_buffer_pools_pages = buf_pool_get_n_pages()
+		* srv_buf_pool_instances;
+
+	if (fread(magic, sizeof magic, 1, f) == 1
+	    && !memcmp(magic, BUF_DUMP_MAGIC, sizeof magic)) {
+		success = buf_load_read_binary(f, full_filename,
+					       total_buffer_pools_pages,
+					       &dump, &lru, &dump_n);
+	} else {
+		rewind(f);
+		success = buf_load_read_text(f, full_filename,
+					     total_buffer_pools_pages,
+					     &dump, &dump_n);
+	}
+
+	fclose(f);
+
+	if (!success) {
+		return;
+	}
+
+	if (dump_n == 0) {
+		ut_sprintf_timestamp(now);
+		buf_load_status(STATUS_INFO,
+				"Buffer pool(s) load completed at %s"
+				" (%s was empty)", now, full_filename);
+		return;
+	}
+
+	export_vars.innodb_buffer_pool_load_incomplete = 1;
+
+	/* JAN: TODO: MySQL 5.7 PSI
 #ifdef HAVE_PSI_STAGE_INTERFACE
-			/* mysql_end_stage(); */
-#endif /* HAVE_PSI_STAGE_INTERFACE */
-			return;
-		}
+	PSI_stage_progress*	pfs_stage_progress
+		= mysql_set_stage(srv_stage_buffer_pool_load.m_key);
+	#endif*/ /* HAVE_PSI_STAGE_INTERFACE */
+	/*
+	mysql_stage_set_work_estimated(pfs_stage_progress, dump_n);
+	mysql_stage_set_work_completed(pfs_stage_progress, 0);
+	*/
 
-		buf_load_throttle_if_needed(
-			&last_check_time, &last_activity_cnt, i);
+	const ulint	i = buf_load_pages(dump, dump_n);
 
-#ifdef UNIV_DEBUG
-		if ((i+1) >= srv_buf_pool_load_pages_abort) {
-			buf_load_abort_flag = 1;
-		}
-#endif
+	if (buf_load_abort_flag) {
+		buf_load_abort_flag = FALSE;
+		ut_free(dump);
+		ut_free(lru);
+		buf_load_status(
+			STATUS_INFO,
+			"Buffer pool(s) load aborted on request");
+		/* Premature end, set estimated = completed = i and
+		end the current stage event. */
+		/*
+		mysql_stage_set_work_estimated(pfs_stage_progress, i);
+		mysql_stage_set_work_completed(pfs_stage_progress, i);
+		*/
+#ifdef HAVE_PSI_STAGE_INTERFACE
+		/* mysql_end_stage(); */
+#endif /* HAVE_PSI_STAGE_INTERFACE */
+		return;
 	}
 
-	if (space != NULL) {
-		space->release();
+	if (i == dump_n && lru != NULL) {
+		buf_load_restore_lru(dump, lru, dump_n);
 	}
 
 	ut_free(dump);
+	ut_free(lru);
 
 	ut_sprintf_timestamp(now);
 
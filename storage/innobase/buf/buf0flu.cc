@@ -1683,41 +1683,35 @@ buf_do_LRU_batch(
 	n->evicted += n->unzip_LRU_evicted;
 }
 
-/** This utility flushes dirty blocks from the end of the flush_list.
+/** Flush dirty blocks of the running flush_list batch, continuing from
+buf_pool->flush_hp. Several page cleaner threads may execute this
+concurrently on the same buffer pool instance: each of them claims the
+next block of the LSN-ordered flush_list by moving the hazard pointer,
+and the blocks are written while buf_pool->mutex is not being held.
 The calling thread is not allowed to own any latches on pages!
-@param[in]	buf_pool	buffer pool instance
-@param[in]	min_n		wished minimum mumber of blocks flushed (it is
-not guaranteed that the actual number is that big, though)
-@param[in]	lsn_limit	all blocks whose oldest_modification is smaller
-than this should be flushed (if their number does not exceed min_n)
-@return number of blocks for which the write request was queued;
-ULINT_UNDEFINED if there was a flush of the same type already
-running */
+@param[in,out]	buf_pool	buffer pool instance
+@return number of flush_list entries that were scanned */
 static
 ulint
-buf_do_flush_list_batch(
-	buf_pool_t*		buf_pool,
-	ulint			min_n,
-	lsn_t			lsn_limit)
+buf_flush_list_batch_scan(buf_pool_t* buf_pool)
 {
-	ulint		count = 0;
-	ulint		scanned = 0;
+	ulint	scanned = 0;
 
 	ut_ad(buf_pool_mutex_own(buf_pool));
 
-	/* Start from the end of the list looking for a suitable
-	block to be flushed. */
 	buf_flush_list_mutex_enter(buf_pool);
-	ulint len = UT_LIST_GET_LEN(buf_pool->flush_list);
 
 	/* In order not to degenerate this scan to O(n*n) we attempt
 	to preserve pointer of previous block in the flush list. To do
 	so we declare it a hazard pointer. Any thread working on the
 	flush list must check the hazard pointer and if it is removing
 	the same block then it must reset it. */
-	for (buf_page_t* bpage = UT_LIST_GET_LAST(buf_pool->flush_list);
-	     count < min_n && bpage != NULL && len > 0
-	     && bpage->oldest_modification < lsn_limit;
+	for (buf_page_t* bpage = buf_pool->flush_hp.get();
+	     buf_pool->flush_list_batch.count
+	     < buf_pool->flush_list_batch.min_n
+	     && bpage != NULL && buf_pool->flush_list_batch.len > 0
+	     && bpage->oldest_modification
+	     < buf_pool->flush_list_batch.lsn_limit;
 	     bpage = buf_pool->flush_hp.get(),
 	     ++scanned) {
 
@@ -1728,22 +1722,29 @@ buf_do_flush_list_batch(
 
 		prev = UT_LIST_GET_PREV(list, bpage);
 		buf_pool->flush_hp.set(prev);
+		buf_pool->flush_list_batch.len--;
 		buf_flush_list_mutex_exit(buf_pool);
 
+		/* The shared count may be updated by other threads
+		while buf_pool->mutex is released for the write. */
+		const ulint	count = buf_pool->flush_list_batch.count;
+		ulint		n = count;
+
 #ifdef UNIV_DEBUG
 		bool flushed =
 #endif /* UNIV_DEBUG */
 		buf_flush_page_and_try_neighbors(
-			bpage, BUF_FLUSH_LIST, min_n, &count);
+			bpage, BUF_FLUSH_LIST,
+			buf_pool->flush_list_batch.min_n, &n);
 
-		buf_flush_list_mutex_enter(buf_pool);
+		buf_pool->flush_list_batch.count += n - count;
 
-		ut_ad(flushed || buf_pool->flush_hp.is_hp(prev));
+		buf_flush_list_mutex_enter(buf_pool);
 
-		--len;
+		ut_ad(flushed || buf_pool->flush_list_batch.joined
+		      || buf_pool->flush_hp.is_hp(prev));
 	}
 
-	buf_pool->flush_hp.set(NULL);
 	buf_flush_list_mutex_exit(buf_pool);
 
 	if (scanned) {
@@ -1754,6 +1755,66 @@ buf_do_flush_list_batch(
 			scanned);
 	}
 
+	ut_ad(buf_pool_mutex_own(buf_pool));
+
+	return(scanned);
+}
+
+/** This utility flushes dirty blocks from the end of the flush_list.
+Idle page cleaner threads may join the batch by buf_flush_list_help().
+The calling thread is not allowed to own any latches on pages!
+@param[in]	buf_pool	buffer pool instance
+@param[in]	min_n		wished minimum mumber of blocks flushed (it is
+not guaranteed that the actual number is that big, though)
+@param[in]	lsn_limit	all blocks whose oldest_modification is smaller
+than this should be flushed (if their number does not exceed min_n)
+@return number of blocks for which the write request was queued;
+ULINT_UNDEFINED if there was a flush of the same type already
+running */
+static
+ulint
+buf_do_flush_list_batch(
+	buf_pool_t*		buf_pool,
+	ulint			min_n,
+	lsn_t			lsn_limit)
+{
+	ut_ad(buf_pool_mutex_own(buf_pool));
+	ut_ad(!buf_pool->flush_list_batch.active);
+	ut_ad(!buf_pool->flush_list_batch.n_helpers);
+
+	/* Start from the end of the list looking for a suitable
+	block to be flushed. */
+	buf_flush_list_mutex_enter(buf_pool);
+	buf_pool->flush_list_batch.min_n = min_n;
+	buf_pool->flush_list_batch.lsn_limit = lsn_limit;
+	buf_pool->flush_list_batch.count = 0;
+	buf_pool->flush_list_batch.joined = false;
+	buf_pool->flush_list_batch.len
+		= UT_LIST_GET_LEN(buf_pool->flush_list);
+	buf_pool->flush_hp.set(UT_LIST_GET_LAST(buf_pool->flush_list));
+	buf_flush_list_mutex_exit(buf_pool);
+
+	buf_pool->flush_list_batch.active = true;
+
+	buf_flush_list_batch_scan(buf_pool);
+
+	buf_pool->flush_list_batch.active = false;
+
+	/* Wait for the helpers to finish their last block. They will
+	not start any further ones, because the conditions that ended
+	our scan also hold for them. */
+	while (buf_pool->flush_list_batch.n_helpers) {
+		buf_pool_mutex_exit(buf_pool);
+		os_thread_yield();
+		buf_pool_mutex_enter(buf_pool);
+	}
+
+	const ulint	count = buf_pool->flush_list_batch.count;
+
+	buf_flush_list_mutex_enter(buf_pool);
+	buf_pool->flush_hp.set(NULL);
+	buf_flush_list_mutex_exit(buf_pool);
+
 	if (count) {
 		MONITOR_INC_VALUE_CUMULATIVE(
 			MONITOR_FLUSH_BATCH_TOTAL_PAGE,
@@ -1767,6 +1828,30 @@ buf_do_flush_list_batch(
 	return(count);
 }
 
+/** Join the flush_list batch that is running on a buffer pool instance.
+The calling thread is not allowed to own any latches on pages!
+@param[in,out]	buf_pool	buffer pool instance
+@return whether any flush_list entries were scanned */
+static
+bool
+buf_flush_list_help(buf_pool_t* buf_pool)
+{
+	ulint	scanned = 0;
+
+	buf_pool_mutex_enter(buf_pool);
+
+	if (buf_pool->flush_list_batch.active) {
+		buf_pool->flush_list_batch.n_helpers++;
+		buf_pool->flush_list_batch.joined = true;
+		scanned = buf_flush_list_batch_scan(buf_pool);
+		buf_pool->flush_list_batch.n_helpers--;
+	}
+
+	buf_pool_mutex_exit(buf_pool);
+
+	return(scanned > 0);
+}
+
 /** This utility flushes dirty blocks from the end of the LRU list or
 flush_list.
 NOTE 1: in the case of an LRU flush the calling thread may own latches to
@@ -1895,7 +1980,7 @@ buf_flush_end(
 	buf_pool_mutex_exit(buf_pool);
 
 	if (!srv_read_only_mode) {
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(buf_pool->instance_no);
 	} else {
 		os_aio_simulated_wake_handler_threads();
 	}
@@ -2800,6 +2885,45 @@ pc_flush_slot(void)
 	return(ret);
 }
 
+/**
+Help with the flush_list batch of the buffer pool instance that has the
+longest flush_list among the slots that are being flushed, so that a
+single hot instance can be flushed by several page cleaner threads.
+@return	whether any work was done */
+static
+bool
+pc_help_slot(void)
+{
+	buf_pool_t*	buf_pool = NULL;
+	ulint		max_len = 0;
+
+	mutex_enter(&page_cleaner.mutex);
+
+	if (page_cleaner.is_running && page_cleaner.requested) {
+		for (ulint i = 0; i < page_cleaner.n_slots; i++) {
+			if (page_cleaner.slots[i].state
+			    != PAGE_CLEANER_STATE_FLUSHING) {
+				continue;
+			}
+
+			buf_pool_t*	b = buf_pool_from_array(i);
+
+			/* Dirty reads; buf_flush_list_help() will
+			check the state under buf_pool->mutex. */
+			const ulint	len = UT_LIST_GET_LEN(b->flush_list);
+
+			if (b->flush_list_batch.active && len > max_len) {
+				buf_pool = b;
+				max_len = len;
+			}
+		}
+	}
+
+	mutex_exit(&page_cleaner.mutex);
+
+	return(buf_pool != NULL && buf_flush_list_help(buf_pool));
+}
+
 /**
 Wait until all flush requests are finished.
 @param n_flushed_lru	number of pages flushed from the end of the LRU list.
@@ -2817,6 +2941,8 @@ pc_wait_finished(
 	*n_flushed_lru = 0;
 	*n_flushed_list = 0;
 
+	while (pc_help_slot()) {}
+
 	os_event_wait(page_cleaner.is_finished);
 
 	mutex_enter(&page_cleaner.mutex);
@@ -3448,6 +3574,8 @@ DECLARE_THREAD(buf_flush_page_cleaner_worker)(
 		}
 
 		pc_flush_slot();
+
+		while (pc_help_slot()) {}
 	}
 
 	mutex_enter(&page_cleaner.mutex);
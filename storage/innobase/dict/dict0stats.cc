@@ -2207,6 +2207,128 @@ static index_stats_t dict_stats_analyze_index(dict_index_t* index)
 	DBUG_RETURN(result);
 }
 
+/** Set the statistics of an index.
+@param[in,out]	index	index
+@param[in]	stats	statistics calculated by dict_stats_analyze_index() */
+static void dict_stats_index_set(dict_index_t* index, const index_stats_t& stats)
+{
+	ut_ad(mutex_own(&dict_sys.mutex));
+
+	index->stat_index_size = stats.index_size;
+	index->stat_n_leaf_pages = stats.n_leaf_pages;
+	for (size_t i = 0; i < stats.stats.size(); ++i) {
+		index->stat_n_diff_key_vals[i] = stats.stats[i].n_diff_key_vals;
+		index->stat_n_sample_sizes[i] = stats.stats[i].n_sample_sizes;
+		index->stat_n_non_null_key_vals[i]
+			= stats.stats[i].n_non_null_key_vals;
+	}
+
+	index->stat_modified_counter = 0;
+}
+
+#ifdef UNIV_PFS_THREAD
+mysql_pfs_key_t	dict_stats_analyze_thread_key;
+#endif /* UNIV_PFS_THREAD */
+
+/** Indexes being analyzed by dict_stats_analyze_indexes() */
+struct dict_stats_analyze_t {
+	/** the table */
+	const dict_table_t*		table;
+	/** the indexes to analyze */
+	std::vector<dict_index_t*>	indexes;
+	/** the statistics of indexes[], or NULL if not analyzed */
+	std::vector<index_stats_t*>	stats;
+	/** the next element of indexes[] to analyze */
+	Atomic_counter<ulint>		next;
+};
+
+/** Analyze indexes until all of them have been assigned to a thread.
+@param[in,out]	analyze	indexes being analyzed */
+static void dict_stats_analyze_next(dict_stats_analyze_t* analyze)
+{
+	for (;;) {
+		ulint	i = analyze->next++;
+
+		if (i >= analyze->indexes.size()) {
+			break;
+		}
+
+		dict_index_t*	index = analyze->indexes[i];
+
+		/* Skip the secondary indexes if the table is about to
+		be dropped. */
+		if (!index->is_primary()
+		    && (analyze->table->stats_bg_flag & BG_STAT_SHOULD_QUIT)) {
+			continue;
+		}
+
+		analyze->stats[i] = UT_NEW_NOKEY(index_stats_t(
+			dict_stats_analyze_index(index)));
+	}
+}
+
+/** Thread that analyzes indexes on behalf of dict_stats_analyze_indexes().
+@param[in]	arg	dict_stats_analyze_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(dict_stats_analyze_thread)(void* arg)
+{
+	my_thread_init();
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(dict_stats_analyze_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	dict_stats_analyze_next(static_cast<dict_stats_analyze_t*>(arg));
+
+	my_thread_end();
+	/* dict_stats_analyze_indexes() will join this thread. */
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Analyze indexes of a table, using up to innodb_stats_analyze_threads
+threads.
+@param[in,out]	analyze	indexes to analyze; on return, the statistics */
+static void dict_stats_analyze_indexes(dict_stats_analyze_t* analyze)
+{
+	ut_ad(!mutex_own(&dict_sys.mutex));
+
+	analyze->stats.assign(analyze->indexes.size(), NULL);
+	analyze->next = 0;
+
+	const ulint	n_threads = std::min<ulint>(srv_stats_analyze_threads,
+						    analyze->indexes.size());
+	std::vector<os_thread_id_t>	threads(n_threads);
+
+	for (ulint i = 1; i < n_threads; i++) {
+		os_thread_create(dict_stats_analyze_thread, analyze,
+				 &threads[i]);
+	}
+
+	dict_stats_analyze_next(analyze);
+
+	for (ulint i = 1; i < n_threads; i++) {
+		os_thread_join(threads[i]);
+	}
+}
+
+/** Determine whether the statistics of an index can be kept by
+dict_stats_update_persistent(table, true).
+@param[in]	index		index
+@param[in]	threshold	number of modified records above which
+				the statistics must be recalculated
+@return whether the statistics are recent enough */
+static bool dict_stats_index_is_fresh(const dict_index_t* index,
+				      ib_uint64_t threshold)
+{
+	/* Statistics that were never calculated (or were emptied)
+	are all zero. */
+	return(index->stat_modified_counter <= threshold
+	       && index->stat_n_diff_key_vals[0]);
+}
+
 /*********************************************************************//**
 Calculates new estimates for table and index statistics. This function
 is relatively slow and is used to calculate persistent statistics that
@@ -2216,7 +2338,11 @@ static
 dberr_t
 dict_stats_update_persistent(
 /*=========================*/
-	dict_table_t*	table)		/*!< in/out: table */
+	dict_table_t*	table,		/*!< in/out: table */
+	bool		modified_only)	/*!< in: whether to keep the
+					statistics of indexes that were
+					modified less than 10% since they
+					were last calculated */
 {
 	dict_index_t*	index;
 
@@ -2239,30 +2365,23 @@ dict_stats_update_persistent(
 	}
 
 	ut_ad(!dict_index_is_ibuf(index));
-	mutex_enter(&dict_sys.mutex);
-	dict_stats_empty_index(index, false);
-	mutex_exit(&dict_sys.mutex);
 
-	index_stats_t stats = dict_stats_analyze_index(index);
+	dict_stats_analyze_t	analyze;
+	analyze.table = table;
 
 	mutex_enter(&dict_sys.mutex);
-	index->stat_index_size = stats.index_size;
-	index->stat_n_leaf_pages = stats.n_leaf_pages;
-	for (size_t i = 0; i < stats.stats.size(); ++i) {
-		index->stat_n_diff_key_vals[i] = stats.stats[i].n_diff_key_vals;
-		index->stat_n_sample_sizes[i] = stats.stats[i].n_sample_sizes;
-		index->stat_n_non_null_key_vals[i] = stats.stats[i].n_non_null_key_vals;
-	}
 
-	ulint	n_unique = dict_index_get_n_unique(index);
+	const ib_uint64_t	threshold = modified_only
+		&& table->stat_initialized
+		? dict_table_get_n_rows(table) / 10 /* 10% */
+		: 0;
+	const bool	keep_clust = threshold
+		&& dict_stats_index_is_fresh(index, threshold);
 
-	table->stat_n_rows = index->stat_n_diff_key_vals[n_unique - 1];
-
-	table->stat_clustered_index_size = index->stat_index_size;
-
-	/* analyze other indexes from the table, if any */
-
-	table->stat_sum_of_other_index_sizes = 0;
+	if (!keep_clust) {
+		dict_stats_empty_index(index, false);
+		analyze.indexes.push_back(index);
+	}
 
 	for (index = dict_table_get_next_index(index);
 	     index != NULL;
@@ -2274,27 +2393,54 @@ dict_stats_update_persistent(
 			continue;
 		}
 
-		dict_stats_empty_index(index, false);
-
 		if (dict_stats_should_ignore_index(index)) {
+			dict_stats_empty_index(index, false);
 			continue;
 		}
 
-		if (!(table->stats_bg_flag & BG_STAT_SHOULD_QUIT)) {
-			mutex_exit(&dict_sys.mutex);
-			stats = dict_stats_analyze_index(index);
-			mutex_enter(&dict_sys.mutex);
+		if (threshold && dict_stats_index_is_fresh(index, threshold)) {
+			DEBUG_PRINTF("  %s(): keeping the statistics of %s\n",
+				     __func__, index->name());
+			continue;
+		}
 
-			index->stat_index_size = stats.index_size;
-			index->stat_n_leaf_pages = stats.n_leaf_pages;
-			for (size_t i = 0; i < stats.stats.size(); ++i) {
-				index->stat_n_diff_key_vals[i]
-					= stats.stats[i].n_diff_key_vals;
-				index->stat_n_sample_sizes[i]
-					= stats.stats[i].n_sample_sizes;
-				index->stat_n_non_null_key_vals[i]
-					= stats.stats[i].n_non_null_key_vals;
-			}
+		dict_stats_empty_index(index, false);
+		analyze.indexes.push_back(index);
+	}
+
+	mutex_exit(&dict_sys.mutex);
+
+	/* The indexes are independent of each other, and may be
+	analyzed concurrently. */
+	dict_stats_analyze_indexes(&analyze);
+
+	mutex_enter(&dict_sys.mutex);
+
+	for (ulint i = 0; i < analyze.indexes.size(); i++) {
+		if (index_stats_t* stats = analyze.stats[i]) {
+			dict_stats_index_set(analyze.indexes[i], *stats);
+			UT_DELETE(stats);
+		}
+	}
+
+	index = dict_table_get_first_index(table);
+
+	if (!keep_clust) {
+		ulint	n_unique = dict_index_get_n_unique(index);
+
+		table->stat_n_rows = index->stat_n_diff_key_vals[n_unique - 1];
+	}
+
+	table->stat_clustered_index_size = index->stat_index_size;
+
+	table->stat_sum_of_other_index_sizes = 0;
+
+	for (index = dict_table_get_next_index(index);
+	     index != NULL;
+	     index = dict_table_get_next_index(index)) {
+
+		if (index->type & (DICT_FTS | DICT_SPATIAL)) {
+			continue;
 		}
 
 		table->stat_sum_of_other_index_sizes
@@ -3128,16 +3274,7 @@ dict_stats_update_for_index(
 		if (dict_stats_persistent_storage_check(false)) {
 			index_stats_t stats = dict_stats_analyze_index(index);
 			mutex_enter(&dict_sys.mutex);
-			index->stat_index_size = stats.index_size;
-			index->stat_n_leaf_pages = stats.n_leaf_pages;
-			for (size_t i = 0; i < stats.stats.size(); ++i) {
-				index->stat_n_diff_key_vals[i]
-					= stats.stats[i].n_diff_key_vals;
-				index->stat_n_sample_sizes[i]
-					= stats.stats[i].n_sample_sizes;
-				index->stat_n_non_null_key_vals[i]
-					= stats.stats[i].n_non_null_key_vals;
-			}
+			dict_stats_index_set(index, stats);
 			index->table->stat_sum_of_other_index_sizes
 				+= index->stat_index_size;
 			mutex_exit(&dict_sys.mutex);
@@ -3195,6 +3332,7 @@ dict_stats_update(
 
 	switch (stats_upd_option) {
 	case DICT_STATS_RECALC_PERSISTENT:
+	case DICT_STATS_RECALC_PERSISTENT_MODIFIED:
 
 		if (srv_read_only_mode) {
 			goto transient;
@@ -3218,7 +3356,9 @@ dict_stats_update(
 
 			dberr_t	err;
 
-			err = dict_stats_update_persistent(table);
+			err = dict_stats_update_persistent(
+				table, stats_upd_option
+				== DICT_STATS_RECALC_PERSISTENT_MODIFIED);
 
 			if (err != DB_SUCCESS) {
 				return(err);
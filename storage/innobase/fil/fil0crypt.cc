@@ -39,6 +39,7 @@ Modified           Jan Lindström jan.lindstrom@mariadb.com
 #include "btr0scrub.h"
 #include "fsp0fsp.h"
 #include "fil0pagecompress.h"
+#include "buf0rea.h"
 #include <my_crypt.h>
 
 static bool fil_crypt_threads_inited = false;
@@ -1236,6 +1237,8 @@ struct rotate_thread_t {
 	ulint offset;		    /*!< current offset */
 	ulint batch;		    /*!< #pages to rotate */
 	uint  min_key_version_found;/*!< min key version found but not rotated */
+	uint  extent_min_key_version;/*!< min key version of the pages
+				    of the current extent after rotation */
 	lsn_t end_lsn;		    /*!< max lsn when rotating this space */
 
 	uint estimated_max_iops;   /*!< estimation of max iops */
@@ -1416,6 +1419,7 @@ fil_crypt_update_total_stat(
 		state->crypt_stat.pages_read_from_disk;
 	crypt_stat.pages_modified += state->crypt_stat.pages_modified;
 	crypt_stat.pages_flushed += state->crypt_stat.pages_flushed;
+	crypt_stat.pages_skipped += state->crypt_stat.pages_skipped;
 	// remote old estimate
 	crypt_stat.estimated_iops -= state->crypt_stat.estimated_iops;
 	// add new estimate
@@ -1775,6 +1779,50 @@ static bool fil_crypt_find_space_to_rotate(
 
 }
 
+/** Prepare the per-extent key version summary for a new rotation.
+The summary is only maintained while encrypting, because pages are
+then never written with a key version older than the latest one.
+@param[in]	key_state	key state
+@param[in,out]	crypt_data	tablespace encryption information
+@param[in]	size		current size of the tablespace in pages */
+static
+void
+fil_crypt_init_extent_summary(
+	const key_state_t*	key_state,
+	fil_space_crypt_t*	crypt_data,
+	ulint			size)
+{
+	fil_space_rotate_state_t& rotate_state = crypt_data->rotate_state;
+
+	ut_ad(mutex_own(&crypt_data->mutex));
+	ut_ad(rotate_state.active_threads == 0);
+
+	if (!key_state->key_version || !crypt_data->is_encrypted()) {
+		ut_free(rotate_state.extent_min_key_version);
+		rotate_state.extent_min_key_version = NULL;
+		rotate_state.n_extents = 0;
+		return;
+	}
+
+	const ulint n_extents = ut_calc_align<ulint>(size, FSP_EXTENT_SIZE)
+		/ FSP_EXTENT_SIZE;
+
+	if (n_extents <= rotate_state.n_extents) {
+		return;
+	}
+
+	/* Extents that were added since the previous rotation are
+	unknown. On allocation failure, keep using the old summary. */
+	if (uint* summary = static_cast<uint*>(
+		    ut_realloc(rotate_state.extent_min_key_version,
+			       n_extents * sizeof *summary))) {
+		memset(summary + rotate_state.n_extents, 0,
+		       (n_extents - rotate_state.n_extents) * sizeof *summary);
+		rotate_state.extent_min_key_version = summary;
+		rotate_state.n_extents = n_extents;
+	}
+}
+
 /***********************************************************************
 Start rotating a space
 @param[in]	key_state		Key state
@@ -1804,6 +1852,11 @@ fil_crypt_start_rotate_space(
 			key_state->key_version;
 
 		crypt_data->rotate_state.start_time = time(0);
+		crypt_data->rotate_state.pages_modified = 0;
+		crypt_data->rotate_state.pages_skipped = 0;
+
+		fil_crypt_init_extent_summary(key_state, crypt_data,
+					      state->space->size);
 
 		if (crypt_data->type == CRYPT_SCHEME_UNENCRYPTED &&
 			crypt_data->is_encrypted() &&
@@ -1853,19 +1906,20 @@ fil_crypt_find_page_to_rotate(
 	bool found = crypt_data->rotate_state.max_offset >=
 		crypt_data->rotate_state.next_offset;
 
+	/* End each batch at an extent boundary, so that every extent
+	is rotated by a single thread. */
+	const ulint next_offset = ut_calc_align<ulint>(
+		crypt_data->rotate_state.next_offset + batch,
+		FSP_EXTENT_SIZE);
+
 	if (found) {
 		state->offset = crypt_data->rotate_state.next_offset;
-		ulint remaining = crypt_data->rotate_state.max_offset -
-			crypt_data->rotate_state.next_offset;
-
-		if (batch <= remaining) {
-			state->batch = batch;
-		} else {
-			state->batch = remaining;
-		}
+		state->batch = std::min(next_offset,
+					crypt_data->rotate_state.max_offset)
+			- state->offset;
 	}
 
-	crypt_data->rotate_state.next_offset += batch;
+	crypt_data->rotate_state.next_offset = next_offset;
 	mutex_exit(&crypt_data->mutex);
 	return found;
 }
@@ -2060,6 +2114,7 @@ fil_crypt_rotate_page(
 		if (space->is_stopping()) {
 			/* The tablespace is closing (in DROP TABLE or
 			TRUNCATE TABLE or similar): avoid further access */
+			state->extent_min_key_version = 0;
 		} else if (!kv && !*reinterpret_cast<uint16_t*>
 			   (&frame[FIL_PAGE_TYPE])) {
 			/* It looks like this page is not
@@ -2101,6 +2156,12 @@ fil_crypt_rotate_page(
 
 			/* statistics */
 			state->crypt_stat.pages_modified++;
+
+			if (key_state->key_version
+			    < state->extent_min_key_version) {
+				state->extent_min_key_version =
+					key_state->key_version;
+			}
 		} else {
 			if (crypt_data->is_encrypted()) {
 				if (kv < state->min_key_version_found) {
@@ -2108,6 +2169,10 @@ fil_crypt_rotate_page(
 				}
 			}
 
+			if (kv < state->extent_min_key_version) {
+				state->extent_min_key_version = kv;
+			}
+
 			needs_scrubbing = btr_page_needs_scrubbing(
 				&state->scrub_data, block,
 				BTR_SCRUB_PAGE_ALLOCATION_UNKNOWN);
@@ -2188,6 +2253,9 @@ fil_crypt_rotate_page(
 			}
 		}
 	} else {
+		/* The key version of this page remains unknown. */
+		state->extent_min_key_version = 0;
+
 		/* If block read failed mtr memo and log should be empty. */
 		ut_ad(!mtr.has_modifications());
 		ut_ad(!mtr.is_dirty());
@@ -2203,8 +2271,93 @@ fil_crypt_rotate_page(
 	}
 }
 
+/** Check whether the per-extent summary shows that no page of an
+extent needs key rotation.
+@param[in]	key_state	key state
+@param[in,out]	state		rotation state
+@param[in]	extent		extent number
+@return whether the extent can be skipped */
+static
+bool
+fil_crypt_extent_is_rotated(
+	const key_state_t*	key_state,
+	rotate_thread_t*	state,
+	ulint			extent)
+{
+	const fil_space_crypt_t* crypt_data = state->space->crypt_data;
+	const fil_space_rotate_state_t& rotate_state
+		= crypt_data->rotate_state;
+
+	/* Scrubbing must visit every page. */
+	if (state->scrub_data.scrubbing
+	    || extent >= rotate_state.n_extents) {
+		return false;
+	}
+
+	const uint kv = rotate_state.extent_min_key_version[extent];
+
+	if (!kv || fil_crypt_needs_rotation(crypt_data, kv,
+					    key_state->key_version,
+					    key_state->rotate_key_age)) {
+		return false;
+	}
+
+	if (kv < state->min_key_version_found) {
+		state->min_key_version_found = kv;
+	}
+
+	return true;
+}
+
+/** Read the pages of an extent that are not in the buffer pool
+asynchronously, instead of waiting for one page read at a time in
+fil_crypt_get_page_throttle().
+@param[in,out]	state	rotation state
+@param[in]	end	end of the extent (exclusive) */
+static
+void
+fil_crypt_read_extent(
+	rotate_thread_t*	state,
+	ulint			end)
+{
+	fil_space_t* space = state->space;
+	const ulint zip_size = space->zip_size();
+	ulint n_reads = 0;
+
+	for (ulint offset = state->offset; offset < end; offset++) {
+		if (space->id == TRX_SYS_SPACE
+		    && (offset == TRX_SYS_PAGE_NO
+			|| buf_dblwr_page_inside(offset))) {
+			continue;
+		}
+
+		if (space->is_stopping()) {
+			break;
+		}
+
+		const page_id_t page_id(space->id, offset);
+
+		if (!buf_page_peek(page_id)) {
+			buf_read_page_background(page_id, zip_size, false);
+			n_reads++;
+		}
+	}
+
+	if (!n_reads) {
+		return;
+	}
+
+	os_aio_simulated_wake_handler_threads();
+	state->crypt_stat.pages_read_from_disk += n_reads;
+
+	/* Stay within the allocated iops while the reads complete. */
+	os_event_reset(fil_crypt_throttle_sleep_event);
+	os_event_wait_time(fil_crypt_throttle_sleep_event,
+			   n_reads * 1000000 / state->allocated_iops);
+}
+
 /***********************************************************************
-Rotate a batch of pages
+Rotate a batch of pages, one extent at a time
 @param[in,out]		key_state		Key state
 @param[in,out]		state			Rotation state */
 static
@@ -2213,35 +2366,76 @@ fil_crypt_rotate_pages(
 	const key_state_t*	key_state,
 	rotate_thread_t*	state)
 {
-	ulint space = state->space->id;
+	fil_space_t* space = state->space;
+	fil_space_crypt_t* crypt_data = space->crypt_data;
 	ulint end = std::min(state->offset + state->batch,
-			     state->space->free_limit);
+			     space->free_limit);
+	const ulint pages_modified = state->crypt_stat.pages_modified;
+	ulint pages_skipped = 0;
 
-	ut_ad(state->space->referenced());
+	ut_ad(space->referenced());
 
-	for (; state->offset < end; state->offset++) {
+	while (state->offset < end) {
+		const ulint extent = state->offset / FSP_EXTENT_SIZE;
+		const ulint extent_end = std::min(
+			ut_calc_align<ulint>(state->offset + 1, FSP_EXTENT_SIZE),
+			end);
 
-		/* we can't rotate pages in dblwr buffer as
-		* it's not possible to read those due to lots of asserts
-		* in buffer pool.
-		*
-		* However since these are only (short-lived) copies of
-		* real pages, they will be updated anyway when the
-		* real page is updated
-		*/
-		if (space == TRX_SYS_SPACE &&
-		    buf_dblwr_page_inside(state->offset)) {
+		if (fil_crypt_extent_is_rotated(key_state, state, extent)) {
+			pages_skipped += extent_end - state->offset;
+			state->offset = extent_end;
 			continue;
 		}
 
-		/* If space is marked as stopping, stop rotating
-		pages. */
-		if (state->space->is_stopping()) {
+		fil_crypt_read_extent(state, extent_end);
+		state->extent_min_key_version = UINT_MAX;
+
+		for (; state->offset < extent_end; state->offset++) {
+
+			/* we can't rotate pages in dblwr buffer as
+			* it's not possible to read those due to lots of
+			* asserts in buffer pool.
+			*
+			* However since these are only (short-lived) copies
+			* of real pages, they will be updated anyway when
+			* the real page is updated
+			*/
+			if (space->id == TRX_SYS_SPACE &&
+			    buf_dblwr_page_inside(state->offset)) {
+				continue;
+			}
+
+			/* If space is marked as stopping, stop rotating
+			pages. */
+			if (space->is_stopping()) {
+				break;
+			}
+
+			fil_crypt_rotate_page(key_state, state);
+		}
+
+		if (state->offset < extent_end) {
 			break;
 		}
 
-		fil_crypt_rotate_page(key_state, state);
+		/* Pages beyond the end of the batch were not allocated
+		when the rotation started. They will be written with the
+		latest key version, so the summary remains a lower bound. */
+		if (extent < crypt_data->rotate_state.n_extents) {
+			crypt_data->rotate_state.extent_min_key_version[extent]
+				= state->extent_min_key_version == UINT_MAX
+				? key_state->key_version
+				: state->extent_min_key_version;
+		}
 	}
+
+	state->crypt_stat.pages_skipped += pages_skipped;
+
+	mutex_enter(&crypt_data->mutex);
+	crypt_data->rotate_state.pages_modified +=
+		state->crypt_stat.pages_modified - pages_modified;
+	crypt_data->rotate_state.pages_skipped += pages_skipped;
+	mutex_exit(&crypt_data->mutex);
 }
 
 /***********************************************************************
@@ -2804,6 +2998,19 @@ fil_space_crypt_get_status(
 				crypt_data->rotate_state.next_offset;
 			status->rotate_max_page_number =
 				crypt_data->rotate_state.max_offset;
+			status->rotate_pages_modified =
+				crypt_data->rotate_state.pages_modified;
+			status->rotate_pages_skipped =
+				crypt_data->rotate_state.pages_skipped;
+
+			/* pages covered so far, including skipped ones */
+			const ulint n_pages = std::min(
+				crypt_data->rotate_state.next_offset,
+				crypt_data->rotate_state.max_offset) - 1;
+			const time_t elapsed = time(0)
+				- crypt_data->rotate_state.start_time;
+			status->rotate_pages_per_second = elapsed > 0
+				? n_pages / ulint(elapsed) : n_pages;
 		}
 
 		mutex_exit(&crypt_data->mutex);
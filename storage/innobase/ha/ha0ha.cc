@@ -199,6 +199,30 @@ static const ulint MAX_N_POINTERS
 	= UNIV_PAGE_SIZE_MAX / REC_N_NEW_EXTRA_BYTES;
 # endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
 
+/** Announce to ha_search_latch_free() that chain nodes are about to be
+modified or unlinked. The caller must hold the partition latch in
+exclusive mode.
+@param[in,out]	table	adaptive hash index partition */
+static void ha_modify_begin(hash_table_t* table)
+{
+	const ulint	seq = table->ahi_seq;
+	ut_ad(!(seq & 1));
+	table->ahi_seq = seq + 1;
+	/* Order the counter update before the modification. */
+	std::atomic_thread_fence(std::memory_order_release);
+}
+
+/** Complete a modification that was started by ha_modify_begin().
+@param[in,out]	table	adaptive hash index partition */
+static void ha_modify_end(hash_table_t* table)
+{
+	const ulint	seq = table->ahi_seq;
+	ut_ad(seq & 1);
+	/* Order the modification before the counter update. */
+	std::atomic_thread_fence(std::memory_order_release);
+	table->ahi_seq = seq + 1;
+}
+
 /*************************************************************//**
 Inserts an entry into a hash table. If an entry with the same fold number
 is found, its node is updated to point to the new data, and no new node
@@ -251,7 +275,9 @@ ha_insert_for_fold_func(
 
 			prev_node->block = block;
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
+			ha_modify_begin(table);
 			prev_node->data = data;
+			ha_modify_end(table);
 
 			return(TRUE);
 		}
@@ -285,6 +311,11 @@ ha_insert_for_fold_func(
 
 	node->next = NULL;
 
+	/* Appending a node does not invalidate concurrent
+	ha_search_latch_free(), but the node must be initialized
+	before it becomes reachable. */
+	std::atomic_thread_fence(std::memory_order_release);
+
 	prev_node = static_cast<ha_node_t*>(cell->node);
 
 	if (prev_node == NULL) {
@@ -342,7 +373,9 @@ ha_delete_hash_node(
 	}
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
 
+	ha_modify_begin(table);
 	HASH_DELETE_AND_COMPACT(ha_node_t, next, table, del_node);
+	ha_modify_end(table);
 }
 
 /*********************************************************//**
@@ -386,7 +419,9 @@ ha_search_and_update_if_found_func(
 
 		node->block = new_block;
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
+		ha_modify_begin(table);
 		node->data = new_data;
+		ha_modify_end(table);
 
 		return(TRUE);
 	}
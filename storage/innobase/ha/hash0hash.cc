@@ -118,6 +118,7 @@ hash_create(
 # if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
 	table->adaptive = FALSE;
 # endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
+	table->ahi_seq = 0;
 #endif /* BTR_CUR_HASH_ADAPT */
 	table->n_sync_obj = 0;
 	table->sync_obj.mutexes = NULL;
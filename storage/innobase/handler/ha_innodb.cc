@@ -641,7 +641,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	PSI_KEY(trx_pool_mutex),
 	PSI_KEY(trx_pool_manager_mutex),
 	PSI_KEY(srv_sys_mutex),
-	PSI_KEY(lock_mutex),
+	PSI_KEY(lock_rec_shard_mutex),
 	PSI_KEY(lock_wait_mutex),
 	PSI_KEY(trx_mutex),
 	PSI_KEY(srv_threads_mutex),
@@ -661,6 +661,7 @@ performance schema instrumented if "UNIV_PFS_RWLOCK"
 is defined */
 static PSI_rwlock_info all_innodb_rwlocks[] = {
 	PSI_RWLOCK_KEY(btr_search_latch),
+	PSI_RWLOCK_KEY(lock_sys_latch),
 #  ifndef PFS_SKIP_BUFFER_MUTEX_RWLOCK
 	PSI_RWLOCK_KEY(buf_block_lock),
 #  endif /* !PFS_SKIP_BUFFER_MUTEX_RWLOCK */
@@ -685,7 +686,9 @@ performance schema instrumented if "UNIV_PFS_THREAD"
 is defined */
 static PSI_thread_info	all_innodb_threads[] = {
 	PSI_KEY(buf_dump_thread),
+	PSI_KEY(buf_load_thread),
 	PSI_KEY(dict_stats_thread),
+	PSI_KEY(dict_stats_analyze_thread),
 	PSI_KEY(io_handler_thread),
 	PSI_KEY(io_ibuf_thread),
 	PSI_KEY(io_log_thread),
@@ -693,6 +696,9 @@ static PSI_thread_info	all_innodb_threads[] = {
 	PSI_KEY(io_write_thread),
 	PSI_KEY(page_cleaner_thread),
 	PSI_KEY(recv_writer_thread),
+	PSI_KEY(row_merge_thread),
+	PSI_KEY(row_log_thread),
+	PSI_KEY(row_scan_thread),
 	PSI_KEY(srv_error_monitor_thread),
 	PSI_KEY(srv_lock_timeout_thread),
 	PSI_KEY(srv_master_thread),
@@ -1173,6 +1179,9 @@ static SHOW_VAR innodb_status_variables[]= {
   {"encryption_rotation_pages_flushed",
   (char*) &export_vars.innodb_encryption_rotation_pages_flushed,
    SHOW_LONG},
+  {"encryption_rotation_pages_skipped",
+  (char*) &export_vars.innodb_encryption_rotation_pages_skipped,
+   SHOW_LONG},
   {"encryption_rotation_estimated_iops",
   (char*) &export_vars.innodb_encryption_rotation_estimated_iops,
    SHOW_LONG},
@@ -2950,6 +2959,7 @@ ha_innobase::ha_innobase(
                           | HA_CAN_TABLES_WITHOUT_ROLLBACK
                           | HA_CAN_ONLINE_BACKUPS
 			  | HA_CONCURRENT_OPTIMIZE
+			  | HA_CAN_READ_BATCH
 			  |  (srv_force_primary_key ? HA_REQUIRE_PRIMARY_KEY : 0)
 		  ),
 	m_start_of_scan(),
@@ -4191,7 +4201,11 @@ static int innodb_init_params()
 		srv_use_doublewrite_buf = FALSE;
 	}
 
-#ifdef LINUX_NATIVE_AIO
+#ifdef LINUX_URING_AIO
+	if (srv_use_native_aio) {
+		ib::info() << "Using liburing";
+	}
+#elif defined(LINUX_NATIVE_AIO)
 	if (srv_use_native_aio) {
 		ib::info() << "Using Linux native AIO";
 	}
@@ -4709,6 +4723,15 @@ innobase_commit(
 	ut_ad(trx->dict_operation_lock_mode == 0);
 	ut_ad(trx->dict_operation == TRX_DICT_OP_NONE);
 
+	/* Build the indexes of any bulk insert that is still buffered,
+	because ha_innobase::end_bulk_insert() was not invoked. This does
+	not depend on trx->bulk_insert, which a trigger may have reset. */
+	trx->bulk_insert = false;
+	if (dberr_t err = trx->bulk_insert_apply()) {
+		innobase_rollback(hton, thd, commit_trx);
+		DBUG_RETURN(convert_error_code_to_mysql(err, 0, thd));
+	}
+
 	/* Transaction is deregistered only in a commit or a rollback. If
 	it is deregistered we know there cannot be resources to be freed
 	and we could return immediately.  For the time being, we play safe
@@ -9670,7 +9693,7 @@ bool ha_innobase::autoinc_lock_mode_stmt_unsafe() const
 }
 
 /***********************************************************************//**
-Reads the next or previous row from a cursor, which must have previously been
+Reads the next or previous rows from a cursor, which must have previously been
 positioned using index_read.
 @return 0, HA_ERR_END_OF_FILE, or error number */
 
@@ -9680,8 +9703,12 @@ ha_innobase::general_fetch(
 	uchar*	buf,		/*!< in/out: buffer for next row in MySQL
 				format */
 	uint	direction,	/*!< in: ROW_SEL_NEXT or ROW_SEL_PREV */
-	uint	match_mode)	/*!< in: 0, ROW_SEL_EXACT, or
+	uint	match_mode,	/*!< in: 0, ROW_SEL_EXACT, or
 				ROW_SEL_EXACT_PREFIX */
+	uint	max_rows,	/*!< in: number of rows to read into
+				buf, table->s->reclength apart */
+	uint*	n_rows)		/*!< out: number of rows read, or NULL
+				if max_rows == 1 */
 {
 	DBUG_ENTER("general_fetch");
 
@@ -9698,26 +9725,47 @@ ha_innobase::general_fetch(
 			    : HA_ERR_NO_SUCH_TABLE);
 	}
 
+	ut_ad(max_rows == 1 || n_rows);
+
 	innobase_srv_conc_enter_innodb(m_prebuilt);
 
-	dberr_t	ret = row_search_mvcc(
-		buf, PAGE_CUR_UNSUPP, m_prebuilt, match_mode, direction);
+	uint	n_read = 0;
+	dberr_t	ret;
+
+	for (;;) {
+		ret = row_search_mvcc(
+			buf, PAGE_CUR_UNSUPP, m_prebuilt, match_mode,
+			direction);
+
+		if (ret != DB_SUCCESS || ++n_read == max_rows) {
+			break;
+		}
+
+		buf += table->s->reclength;
+	}
 
 	innobase_srv_conc_exit_innodb(m_prebuilt);
 
+	if (n_read) {
+		if (m_prebuilt->table->is_system_db) {
+			srv_stats.n_system_rows_read.add(
+				thd_get_thread_id(trx->mysql_thd), n_read);
+		} else {
+			srv_stats.n_rows_read.add(
+				thd_get_thread_id(trx->mysql_thd), n_read);
+		}
+	}
+
+	if (n_rows) {
+		*n_rows = n_read;
+	}
+
 	int	error;
 
 	switch (ret) {
 	case DB_SUCCESS:
 		error = 0;
 		table->status = 0;
-		if (m_prebuilt->table->is_system_db) {
-			srv_stats.n_system_rows_read.add(
-				thd_get_thread_id(trx->mysql_thd), 1);
-		} else {
-			srv_stats.n_rows_read.add(
-				thd_get_thread_id(trx->mysql_thd), 1);
-		}
 		break;
 	case DB_RECORD_NOT_FOUND:
 		error = HA_ERR_END_OF_FILE;
@@ -9916,6 +9964,36 @@ ha_innobase::rnd_next(
 	DBUG_RETURN(error);
 }
 
+/** Read the rows that follow the current row of a table scan or
+of a forward index scan.
+@param[out]	buf		buffer for max_rows rows of
+				table->s->reclength bytes
+@param[in]	max_rows	maximum number of rows to read
+@param[out]	n_rows		number of rows that were read
+@return 0, HA_ERR_END_OF_FILE, HA_ERR_WRONG_COMMAND, or error number */
+int ha_innobase::read_next_batch(uchar* buf, uint max_rows, uint* n_rows)
+{
+	DBUG_ENTER("ha_innobase::read_next_batch");
+
+	*n_rows = 0;
+
+	/* Rows can only be read ahead under the same conditions as
+	they can be prefetched in row_search_mvcc(): the cursor must not
+	be needed for locking, and each row must be self-contained. */
+	if (m_start_of_scan
+	    || m_prebuilt->select_lock_type != LOCK_NONE
+	    || m_prebuilt->templ_contains_blob
+	    || m_prebuilt->clust_index_was_generated
+	    || m_prebuilt->used_in_HANDLER
+	    || m_prebuilt->keep_other_fields_on_keyread
+	    || m_prebuilt->template_type == ROW_MYSQL_DUMMY_TEMPLATE
+	    || m_prebuilt->in_fts_query) {
+		DBUG_RETURN(HA_ERR_WRONG_COMMAND);
+	}
+
+	DBUG_RETURN(general_fetch(buf, ROW_SEL_NEXT, 0, max_rows, n_rows));
+}
+
 /**********************************************************************//**
 Fetches a row from the table based on a row reference.
 @return 0, HA_ERR_KEY_NOT_FOUND, or error code */
@@ -14034,6 +14112,52 @@ ha_innobase::estimate_rows_upper_bound()
 	DBUG_RETURN((ha_rows) estimate);
 }
 
+/** Count the rows in the read view of the current transaction for
+SELECT COUNT(*), by scanning the clustered index in parallel.
+@return number of rows, or HA_POS_ERROR if the rows must be counted by
+reading them through the handler interface */
+ha_rows
+ha_innobase::records_for_count()
+{
+	DBUG_ENTER("ha_innobase::records_for_count");
+
+	if (srv_parallel_scan_threads <= 1) {
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	update_thd(ha_thd());
+
+	trx_t*		trx = m_prebuilt->trx;
+	dict_index_t*	index = dict_table_get_first_index(m_prebuilt->table);
+
+	/* Locking reads, and tables or history that are not accessible,
+	are left to the regular scan. */
+	if (m_prebuilt->select_lock_type != LOCK_NONE
+	    || !m_prebuilt->table->is_readable()) {
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	if (m_prebuilt->sql_stat_start) {
+		m_prebuilt->sql_stat_start = FALSE;
+		trx_start_if_not_started(trx, false);
+		trx->read_view.open(trx);
+	}
+
+	if (!row_merge_is_index_usable(trx, index)) {
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	trx->op_info = "counting rows";
+
+	ulint	n_rows;
+	dberr_t	err = row_scan_clust_index_parallel(trx, index, false,
+						    &n_rows);
+
+	trx->op_info = "";
+
+	DBUG_RETURN(err == DB_SUCCESS ? ha_rows(n_rows) : HA_POS_ERROR);
+}
+
 /*********************************************************************//**
 How many seeks it will take to read through the table. This is to be
 comparable to the number returned by records_in_range so that we can
@@ -15397,6 +15521,35 @@ ha_innobase::free_foreign_key_create_info(
 	}
 }
 
+/** Announce a multi-row insert. If the table is empty, the rows
+may be buffered and the indexes built by sorting in end_bulk_insert(),
+without writing undo log for each row. */
+void ha_innobase::start_bulk_insert(ha_rows, uint)
+{
+	if (!m_prebuilt->table->is_temporary()
+	    && !m_prebuilt->table->skip_alter_undo) {
+		m_prebuilt->trx->bulk_insert = true;
+	}
+}
+
+/** Finish a multi-row insert that was started by start_bulk_insert().
+The buffered rows of any table that a trigger inserted into are
+applied as well, so that the rest of the transaction can read them.
+@return	error code
+@retval	0	on success */
+int ha_innobase::end_bulk_insert()
+{
+	trx_t*	trx = m_prebuilt->trx;
+	trx->bulk_insert = false;
+
+	if (dberr_t err = trx->bulk_insert_apply(m_prebuilt->table, table)) {
+		return my_errno = convert_error_code_to_mysql(
+			err, m_prebuilt->table->flags, m_user_thd);
+	}
+
+	return 0;
+}
+
 /*******************************************************************//**
 Tells something additional to the handler about how to do things.
 @return 0 or error number */
@@ -15483,6 +15636,13 @@ ha_innobase::reset()
 		row_mysql_prebuilt_free_blob_heap(m_prebuilt);
 	}
 
+	if (m_prebuilt->fetch_cache_alloc > MYSQL_FETCH_CACHE_SIZE) {
+		/* Do not keep a grown prefetch cache in idle handles. */
+		m_prebuilt->n_fetch_cached = 0;
+		m_prebuilt->fetch_cache_first = 0;
+		row_mysql_prebuilt_free_fetch_cache(m_prebuilt);
+	}
+
 	reset_template();
 
 	m_ds_mrr.dsmrr_close();
@@ -17026,6 +17186,11 @@ innobase_xa_prepare(
 
 	innobase_srv_conc_force_exit_innodb(trx);
 
+	trx->bulk_insert = false;
+	if (dberr_t err = trx->bulk_insert_apply()) {
+		return convert_error_code_to_mysql(err, 0, thd);
+	}
+
 	if (!trx_is_registered_for_2pc(trx) && trx_is_started(trx)) {
 
 		sql_print_error("Transaction not registered for MariaDB 2PC,"
@@ -18210,6 +18375,54 @@ static int show_innodb_vars(THD*, SHOW_VAR* var, void *,
 	return(0);
 }
 
+/** Report a prefetch cache counter of the current connection,
+or the server-wide total for SHOW GLOBAL STATUS.
+@param[in]	thd	current connection
+@param[out]	var	status variable
+@param[out]	buff	value buffer
+@param[in]	scope	OPT_GLOBAL or OPT_SESSION
+@param[in]	total	srv_stats.n_rows_prefetched or srv_stats.n_prefetch_hits
+@param[in]	counter	trx_t::n_rows_prefetched or trx_t::n_prefetch_hits */
+static void show_innodb_prefetch_counter(THD* thd, SHOW_VAR* var, void* buff,
+					 enum enum_var_type scope,
+					 const srv_stats_t::ulint_ctr_64_t& total,
+					 ulint trx_t::*counter)
+{
+	ulonglong	val = 0;
+
+	if (scope == OPT_GLOBAL) {
+		val = total;
+	} else if (const trx_t* trx = thd_to_trx(thd)) {
+		val = trx->*counter;
+	}
+
+	var->type = SHOW_LONGLONG;
+	var->value = static_cast<char*>(buff);
+	*static_cast<ulonglong*>(buff) = val;
+}
+
+/** Report the number of rows copied to the prefetch cache. */
+static int show_innodb_prefetch_rows(THD* thd, SHOW_VAR* var, void* buff,
+				     struct system_status_var*,
+				     enum enum_var_type scope)
+{
+	show_innodb_prefetch_counter(thd, var, buff, scope,
+				     srv_stats.n_rows_prefetched,
+				     &trx_t::n_rows_prefetched);
+	return(0);
+}
+
+/** Report the number of rows that were returned from the prefetch cache. */
+static int show_innodb_prefetch_hits(THD* thd, SHOW_VAR* var, void* buff,
+				     struct system_status_var*,
+				     enum enum_var_type scope)
+{
+	show_innodb_prefetch_counter(thd, var, buff, scope,
+				     srv_stats.n_prefetch_hits,
+				     &trx_t::n_prefetch_hits);
+	return(0);
+}
+
 /****************************************************************//**
 This function checks each index name for a table against reserved
 system default primary index name 'GEN_CLUST_INDEX'. If a name
@@ -18647,6 +18860,10 @@ innobase_debug_sync_set(THD *thd, st_mysql_sys_var*, void *, const void *value)
 
 static SHOW_VAR innodb_status_variables_export[]= {
 	SHOW_FUNC_ENTRY("Innodb", &show_innodb_vars),
+	{"Innodb_prefetch_hits", (char*) &show_innodb_prefetch_hits,
+	 SHOW_SIMPLE_FUNC},
+	{"Innodb_prefetch_rows", (char*) &show_innodb_prefetch_rows,
+	 SHOW_SIMPLE_FUNC},
 	{NullS, NullS, SHOW_LONG}
 };
 
@@ -18967,6 +19184,17 @@ static MYSQL_SYSVAR_BOOL(doublewrite, srv_use_doublewrite_buf,
   " Disable with --skip-innodb-doublewrite.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_ULONG(doublewrite_files, srv_doublewrite_files,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of doublewrite files per buffer pool instance"
+  " (0=use the doublewrite buffer in the system tablespace)",
+  NULL, NULL, 0, 0, 64, 0);
+
+static MYSQL_SYSVAR_ULONG(doublewrite_pages, srv_doublewrite_pages,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of pages in each doublewrite file",
+  NULL, NULL, 256, 32, BUF_DBLWR_BATCH_MAX, 0);
+
 static MYSQL_SYSVAR_BOOL(use_atomic_writes, srv_use_atomic_writes,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Enable atomic writes, instead of using the doublewrite buffer, for files "
@@ -19237,6 +19465,12 @@ static MYSQL_SYSVAR_ULONGLONG(stats_persistent_sample_pages,
   " statistics (by ANALYZE, default 20)",
   NULL, NULL, 20, 1, ~0ULL, 0);
 
+static MYSQL_SYSVAR_ULONG(stats_analyze_threads, srv_stats_analyze_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that analyze the indexes of a table in parallel when"
+  " calculating persistent statistics (default 4)",
+  NULL, NULL, 4, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(stats_modified_counter, srv_stats_modified_counter,
   PLUGIN_VAR_RQCMDARG,
   "The number of rows modified before we calculate new statistics (default 0 = current limits)",
@@ -19349,6 +19583,23 @@ static MYSQL_SYSVAR_BOOL(buffer_pool_dump_at_shutdown, srv_buffer_pool_dump_at_s
   "Dump the buffer pool into a file named @@innodb_buffer_pool_filename",
   NULL, NULL, TRUE);
 
+static const char* buffer_pool_dump_format_names[] = {
+	"text", "binary", NullS
+};
+
+static TYPELIB buffer_pool_dump_format_typelib = {
+	array_elements(buffer_pool_dump_format_names) - 1,
+	"buffer_pool_dump_format_typelib",
+	buffer_pool_dump_format_names,
+	NULL
+};
+
+static MYSQL_SYSVAR_ENUM(buffer_pool_dump_format, srv_buf_dump_format,
+  PLUGIN_VAR_RQCMDARG,
+  "Format of the buffer pool dump file: text (space,page per line) or"
+  " binary (sorted, delta-encoded, with the LRU position of each page)",
+  NULL, NULL, BUF_DUMP_TEXT, &buffer_pool_dump_format_typelib);
+
 static MYSQL_SYSVAR_ULONG(buffer_pool_dump_pct, srv_buf_pool_dump_pct,
   PLUGIN_VAR_RQCMDARG,
   "Dump only the hottest N% of each buffer pool, defaults to 25",
@@ -19372,6 +19623,11 @@ static MYSQL_SYSVAR_BOOL(buffer_pool_load_now, innodb_buffer_pool_load_now,
   "Trigger an immediate load of the buffer pool from a file named @@innodb_buffer_pool_filename",
   NULL, buffer_pool_load_now, FALSE);
 
+static MYSQL_SYSVAR_ULONG(buffer_pool_load_threads, srv_buf_load_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads reading pages during a buffer pool load",
+  NULL, NULL, 4, 1, 64, 0);
+
 static MYSQL_SYSVAR_BOOL(buffer_pool_load_abort, innodb_buffer_pool_load_abort,
   PLUGIN_VAR_RQCMDARG,
   "Abort a currently running load of the buffer pool",
@@ -19552,6 +19808,13 @@ static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   "Maximum modification log file size for online index creation",
   NULL, NULL, 128<<20, 65536, ~0ULL, 0);
 
+static MYSQL_SYSVAR_ULONG(ddl_threads, srv_ddl_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that sort and build indexes and apply the log"
+  " of an online table rebuild in ALTER TABLE and CREATE INDEX"
+  " (default 4)",
+  NULL, NULL, 4, 1, 64, 0);
+
 static MYSQL_SYSVAR_BOOL(optimize_fulltext_only, innodb_optimize_fulltext_only,
   PLUGIN_VAR_NOCMDARG,
   "Only optimize the Fulltext index of the table",
@@ -19567,6 +19830,17 @@ static MYSQL_SYSVAR_ULONG(write_io_threads, srv_n_write_io_threads,
   "Number of background write I/O threads in InnoDB.",
   NULL, NULL, 4, 1, 64, 0);
 
+static MYSQL_SYSVAR_ULONG(recovery_threads, srv_n_recovery_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads applying redo log records during crash recovery.",
+  NULL, NULL, 4, 1, 64, 0);
+
+static MYSQL_SYSVAR_ULONG(parallel_scan_threads, srv_parallel_scan_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum number of threads scanning the clustered index for"
+  " SELECT COUNT(*) and CHECK TABLE (1=disable parallel scans).",
+  NULL, NULL, 1, 1, 256, 0);
+
 static MYSQL_SYSVAR_ULONG(force_recovery, srv_force_recovery,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Helps to save your data in case the disk image of the database becomes corrupt.",
@@ -20100,12 +20374,14 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_filename),
   MYSQL_SYSVAR(buffer_pool_dump_now),
   MYSQL_SYSVAR(buffer_pool_dump_at_shutdown),
+  MYSQL_SYSVAR(buffer_pool_dump_format),
   MYSQL_SYSVAR(buffer_pool_dump_pct),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(buffer_pool_evict),
 #endif /* UNIV_DEBUG */
   MYSQL_SYSVAR(buffer_pool_load_now),
   MYSQL_SYSVAR(buffer_pool_load_abort),
+  MYSQL_SYSVAR(buffer_pool_load_threads),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(buffer_pool_load_pages_abort),
 #endif /* UNIV_DEBUG */
@@ -20128,11 +20404,15 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(temp_data_file_path),
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(doublewrite),
+  MYSQL_SYSVAR(doublewrite_files),
+  MYSQL_SYSVAR(doublewrite_pages),
   MYSQL_SYSVAR(stats_include_delete_marked),
   MYSQL_SYSVAR(use_atomic_writes),
   MYSQL_SYSVAR(fast_shutdown),
   MYSQL_SYSVAR(read_io_threads),
   MYSQL_SYSVAR(write_io_threads),
+  MYSQL_SYSVAR(recovery_threads),
+  MYSQL_SYSVAR(parallel_scan_threads),
   MYSQL_SYSVAR(file_per_table),
   MYSQL_SYSVAR(file_format), /* deprecated in MariaDB 10.2; no effect */
   MYSQL_SYSVAR(flush_log_at_timeout),
@@ -20187,6 +20467,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(stats_persistent),
   MYSQL_SYSVAR(stats_persistent_sample_pages),
   MYSQL_SYSVAR(stats_auto_recalc),
+  MYSQL_SYSVAR(stats_analyze_threads),
   MYSQL_SYSVAR(stats_modified_counter),
   MYSQL_SYSVAR(stats_traditional),
 #ifdef BTR_CUR_HASH_ADAPT
@@ -20199,6 +20480,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(sort_buffer_size),
   MYSQL_SYSVAR(online_alter_log_max_size),
+  MYSQL_SYSVAR(ddl_threads),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
   MYSQL_SYSVAR(table_locks),
@@ -20352,7 +20634,8 @@ i_s_innodb_sys_virtual,
 i_s_innodb_mutexes,
 i_s_innodb_sys_semaphore_waits,
 i_s_innodb_tablespaces_encryption,
-i_s_innodb_tablespaces_scrubbing
+i_s_innodb_tablespaces_scrubbing,
+i_s_innodb_ahi_partitions
 maria_declare_plugin_end;
 
 /** @brief Initialize the default value of innodb_commit_concurrency.
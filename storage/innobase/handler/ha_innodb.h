@@ -151,6 +151,9 @@ class ha_innobase final: public handler
 
 	int rnd_next(uchar *buf) override;
 
+	int read_next_batch(uchar* buf, uint max_rows, uint* n_rows)
+		override;
+
 	int rnd_pos(uchar * buf, uchar *pos) override;
 
 	int ft_init() override;
@@ -170,6 +173,10 @@ class ha_innobase final: public handler
 
 	int extra(ha_extra_function operation) override;
 
+	void start_bulk_insert(ha_rows rows, uint flags) override;
+
+	int end_bulk_insert() override;
+
 	int reset() override;
 
 	int external_lock(THD *thd, int lock_type) override;
@@ -183,6 +190,8 @@ class ha_innobase final: public handler
 
 	ha_rows estimate_rows_upper_bound() override;
 
+	ha_rows records_for_count() override;
+
 	void update_create_info(HA_CREATE_INFO* create_info) override;
 
 	inline int create(
@@ -458,7 +467,8 @@ class ha_innobase final: public handler
 	inline void update_thd(THD* thd);
 	void update_thd();
 
-	int general_fetch(uchar* buf, uint direction, uint match_mode);
+	int general_fetch(uchar* buf, uint direction, uint match_mode,
+			  uint max_rows = 1, uint* n_rows = NULL);
 	int change_active_index(uint keynr);
 	/* @return true if it's necessary to switch current statement log
 	format from STATEMENT to ROW if binary log format is MIXED and
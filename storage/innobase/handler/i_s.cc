@@ -36,6 +36,7 @@ Modified Dec 29, 2014 Jan Lindström (Added sys_semaphore_waits)
 #include "i_s.h"
 #include "btr0pcur.h"
 #include "btr0types.h"
+#include "btr0sea.h"
 #include "dict0dict.h"
 #include "dict0load.h"
 #include "buf0buddy.h"
@@ -7198,6 +7199,18 @@ static ST_FIELD_INFO innodb_tablespaces_encryption_fields_info[]=
 #define TABLESPACES_ENCRYPTION_ROTATING_OR_FLUSHING 9
   {"ROTATING_OR_FLUSHING", 1, MYSQL_TYPE_LONG,
    0, MY_I_S_UNSIGNED, "", SKIP_OPEN_TABLE},
+#define TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_MODIFIED 10
+  {"KEY_ROTATION_PAGES_MODIFIED", MY_INT64_NUM_DECIMAL_DIGITS,
+   MYSQL_TYPE_LONGLONG,
+   0, MY_I_S_UNSIGNED | MY_I_S_MAYBE_NULL, "", SKIP_OPEN_TABLE},
+#define TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_SKIPPED 11
+  {"KEY_ROTATION_PAGES_SKIPPED", MY_INT64_NUM_DECIMAL_DIGITS,
+   MYSQL_TYPE_LONGLONG,
+   0, MY_I_S_UNSIGNED | MY_I_S_MAYBE_NULL, "", SKIP_OPEN_TABLE},
+#define TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_PER_SECOND 12
+  {"KEY_ROTATION_PAGES_PER_SECOND", MY_INT64_NUM_DECIMAL_DIGITS,
+   MYSQL_TYPE_LONGLONG,
+   0, MY_I_S_UNSIGNED | MY_I_S_MAYBE_NULL, "", SKIP_OPEN_TABLE},
   END_OF_ST_FIELD_INFO
 };
 
@@ -7255,11 +7268,26 @@ i_s_dict_fill_tablespaces_encryption(
 		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_MAX_PAGE_NUMBER]->set_notnull();
 		OK(fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_MAX_PAGE_NUMBER]->store(
 			   status.rotate_max_page_number, true));
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_MODIFIED]->set_notnull();
+		OK(fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_MODIFIED]->store(
+			   status.rotate_pages_modified, true));
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_SKIPPED]->set_notnull();
+		OK(fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_SKIPPED]->store(
+			   status.rotate_pages_skipped, true));
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_PER_SECOND]->set_notnull();
+		OK(fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_PER_SECOND]->store(
+			   status.rotate_pages_per_second, true));
 	} else {
 		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGE_NUMBER]
 			->set_null();
 		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_MAX_PAGE_NUMBER]
 			->set_null();
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_MODIFIED]
+			->set_null();
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_SKIPPED]
+			->set_null();
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGES_PER_SECOND]
+			->set_null();
 	}
 
 	OK(schema_table_store_record(thd, table_to_fill));
@@ -7937,3 +7965,133 @@ UNIV_INTERN struct st_maria_plugin	i_s_innodb_sys_semaphore_waits =
 	INNODB_VERSION_STR,
         MariaDB_PLUGIN_MATURITY_STABLE,
 };
+
+/**  INNODB_ADAPTIVE_HASH_PARTITIONS  ***********************************/
+/* Fields of the dynamic table
+INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_PARTITIONS */
+static ST_FIELD_INFO innodb_ahi_partitions_fields_info[]=
+{
+#define AHI_PARTITION_ID		0
+  {"PARTITION_ID", MY_INT32_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONG,
+   0, MY_I_S_UNSIGNED, "", SKIP_OPEN_TABLE},
+#define AHI_PARTITION_HITS		1
+  {"HITS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG,
+   0, MY_I_S_UNSIGNED, "", SKIP_OPEN_TABLE},
+#define AHI_PARTITION_MISSES		2
+  {"MISSES", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG,
+   0, MY_I_S_UNSIGNED, "", SKIP_OPEN_TABLE},
+#define AHI_PARTITION_LATCH_WAITS	3
+  {"LATCH_WAITS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG,
+   0, MY_I_S_UNSIGNED, "", SKIP_OPEN_TABLE},
+  END_OF_ST_FIELD_INFO
+};
+
+/** Populate INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_PARTITIONS
+with the lookup statistics of each adaptive hash index partition.
+@param[in]	thd	connection
+@param[in,out]	tables	tables to fill
+@return 0 on success */
+static
+int
+i_s_innodb_ahi_partitions_fill_table(
+	THD*		thd,
+	TABLE_LIST*	tables,
+	Item*		)
+{
+	DBUG_ENTER("i_s_innodb_ahi_partitions_fill_table");
+	RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+	/* deny access to user without PROCESS_ACL privilege */
+	if (check_global_access(thd, PROCESS_ACL)) {
+		DBUG_RETURN(0);
+	}
+
+#ifdef BTR_CUR_HASH_ADAPT
+	Field**	fields = tables->table->field;
+
+	for (ulint i = 0; i < btr_ahi_parts; i++) {
+		const btr_search_part_stats_t& stats
+			= btr_search_sys->part_stats[i];
+
+		OK(fields[AHI_PARTITION_ID]->store(i, true));
+		OK(fields[AHI_PARTITION_HITS]->store(
+			   ulint(stats.hits), true));
+		OK(fields[AHI_PARTITION_MISSES]->store(
+			   ulint(stats.misses), true));
+		OK(fields[AHI_PARTITION_LATCH_WAITS]->store(
+			   ulint(stats.latch_waits), true));
+		OK(schema_table_store_record(thd, tables->table));
+	}
+#endif /* BTR_CUR_HASH_ADAPT */
+
+	DBUG_RETURN(0);
+}
+
+/** Bind the dynamic table INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_PARTITIONS
+@param[in,out]	p	table schema object
+@return 0 on success */
+static
+int
+innodb_ahi_partitions_init(
+	void*	p)
+{
+	ST_SCHEMA_TABLE*	schema;
+
+	DBUG_ENTER("innodb_ahi_partitions_init");
+
+	schema = (ST_SCHEMA_TABLE*) p;
+
+	schema->fields_info = innodb_ahi_partitions_fields_info;
+	schema->fill_table = i_s_innodb_ahi_partitions_fill_table;
+
+	DBUG_RETURN(0);
+}
+
+UNIV_INTERN struct st_maria_plugin	i_s_innodb_ahi_partitions =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	MYSQL_INFORMATION_SCHEMA_PLUGIN,
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	&i_s_info,
+
+	/* plugin name */
+	/* const char* */
+	"INNODB_ADAPTIVE_HASH_PARTITIONS",
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	maria_plugin_author,
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	"InnoDB adaptive hash index partition statistics",
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	PLUGIN_LICENSE_GPL,
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	innodb_ahi_partitions_init,
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	i_s_common_deinit,
+
+	/* plugin version (for SHOW PLUGINS) */
+	/* unsigned int */
+	INNODB_VERSION_SHORT,
+
+	/* struct st_mysql_show_var* */
+	NULL,
+
+	/* struct st_mysql_sys_var** */
+	NULL,
+
+	/* Maria extension */
+	INNODB_VERSION_STR,
+	MariaDB_PLUGIN_MATURITY_STABLE,
+};
@@ -351,6 +351,12 @@ btr_free_if_exists(
 @param[in]	page_id		root page id */
 void btr_free(const page_id_t page_id);
 
+/** Remove all records from a persistent index tree, leaving an empty
+root page. This is used for rolling back TRX_UNDO_EMPTY, while the
+table is protected by an exclusive table lock.
+@param[in,out]	index	index tree to be emptied */
+void btr_clear(dict_index_t* index);
+
 /** Read the last used AUTO_INCREMENT value from PAGE_ROOT_AUTO_INC.
 @param[in,out]	index	clustered index
 @return	the last used AUTO_INCREMENT value
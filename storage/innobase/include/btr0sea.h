@@ -30,6 +30,7 @@ Created 2/17/1996 Heikki Tuuri
 #include "dict0dict.h"
 #ifdef BTR_CUR_HASH_ADAPT
 #include "ha0ha.h"
+#include "ut0counter.h"
 
 /** Creates and initializes the adaptive search system at a database start.
 @param[in]	hash_size	hash table size. */
@@ -164,6 +165,12 @@ static inline bool btr_search_own_any();
 /** Unlock all search latches from shared mode. */
 static inline void btr_search_s_unlock_all();
 
+/** Get the adaptive hash index partition of an index.
+A partition is selected using pair of index-id, space-id.
+@param[in]	index	index handler
+@return partition number, less than btr_ahi_parts */
+static inline ulint btr_get_search_part(const dict_index_t* index);
+
 /** Get the latch based on index attributes.
 A latch is selected from an array of latches using pair of index-id, space-id.
 @param[in]	index	index handler
@@ -280,11 +287,29 @@ inline ulint dict_index_t::n_ahi_pages() const
   return ref_count;
 }
 
+/** Number of slots in each btr_search_part_stats_t counter */
+#define BTR_SEARCH_STATS_SLOTS	8
+
+/** Lookup statistics of an adaptive hash index partition, reported in
+INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_PARTITIONS */
+struct btr_search_part_stats_t {
+	/** lookups that positioned the cursor */
+	ib_counter_t<ulint, BTR_SEARCH_STATS_SLOTS>	hits;
+	/** lookups that did not find a matching record */
+	ib_counter_t<ulint, BTR_SEARCH_STATS_SLOTS>	misses;
+	/** lookups that raced with a writer and had to acquire
+	btr_search_latches[] */
+	ib_counter_t<ulint, BTR_SEARCH_STATS_SLOTS>	latch_waits;
+};
+
 /** The hash index system */
 struct btr_search_sys_t{
 	hash_table_t**	hash_tables;	/*!< the adaptive hash tables,
 					mapping dtuple_fold values
 					to rec_t pointers on index pages */
+	btr_search_part_stats_t*
+			part_stats;	/*!< lookup statistics,
+					btr_ahi_parts elements */
 };
 
 /** Latches protecting access to adaptive hash index. */
@@ -158,6 +158,19 @@ static inline bool btr_search_own_any()
 }
 #endif /* UNIV_DEBUG */
 
+/** Get the adaptive hash index partition of an index.
+@param[in]	index	index handler
+@return partition number, less than btr_ahi_parts */
+static inline ulint btr_get_search_part(const dict_index_t* index)
+{
+	ut_ad(index != NULL);
+	ut_ad(!index->table->space
+	      || index->table->space->id == index->table->space_id);
+
+	return ut_fold_ulint_pair(ulint(index->id), index->table->space_id)
+		% btr_ahi_parts;
+}
+
 static inline rw_lock_t* btr_get_search_latch(
   index_id_t index_id, ulint space_id)
 {
@@ -393,6 +393,23 @@ buf_page_get_known_nowait(
 	unsigned	line,	/*!< in: line where called */
 	mtr_t*		mtr);	/*!< in: mini-transaction */
 
+/** Latch a buffer-fixed page without waiting.
+@param[in]	rw_latch	RW_S_LATCH or RW_X_LATCH
+@param[in,out]	block		buffer-fixed block; unfixed on failure
+@param[in]	mode		BUF_MAKE_YOUNG or BUF_KEEP_OLD
+@param[in]	file		file name
+@param[in]	line		line where called
+@param[in,out]	mtr		mini-transaction
+@return whether the page was latched and registered in mtr */
+bool
+buf_page_get_fixed_nowait(
+	ulint		rw_latch,
+	buf_block_t*	block,
+	ulint		mode,
+	const char*	file,
+	unsigned	line,
+	mtr_t*		mtr);
+
 /** Given a tablespace id and page number tries to get that page. If the
 page is not in the buffer pool it is not loaded and NULL is returned.
 Suitable for using when holding the lock_sys_t::mutex.
@@ -1159,6 +1176,23 @@ This function does not return if the block is not identified.
 @return pointer to block, never NULL */
 buf_block_t*
 buf_block_from_ahi(const byte* ptr);
+
+/** Buffer-fix a block that was found by ha_search_latch_free()
+without holding the adaptive hash index latch.
+@param[in]	ptr	pointer to within a page frame
+@param[in]	table	adaptive hash index partition that ptr was read from
+@param[in]	seq	modification counter from ha_search_latch_free()
+@param[in]	file	file name
+@param[in]	line	line where called
+@return the buffer-fixed block
+@retval NULL if the partition was modified or the block is being freed */
+buf_block_t*
+buf_block_fix_from_ahi(
+	const byte*		ptr,
+	const hash_table_t*	table,
+	ulint			seq,
+	const char*		file,
+	unsigned		line);
 #endif /* BTR_CUR_HASH_ADAPT */
 
 /********************************************************************//**
@@ -2137,6 +2171,27 @@ struct buf_pool_t{
 					of the given type running;
 					os_event_set() and os_event_reset()
 					are protected by buf_pool_t::mutex */
+	struct {
+		bool	active;	/*!< whether idle page cleaner
+				threads may join the batch */
+		ulint	n_helpers;/*!< number of threads that
+				are helping with the batch */
+		bool	joined;	/*!< whether any thread joined
+				the batch */
+		ulint	min_n;	/*!< wished number of pages
+				to flush */
+		lsn_t	lsn_limit;/*!< upper limit of
+				oldest_modification to flush */
+		ulint	count;	/*!< number of pages queued for
+				writing by all threads */
+		ulint	len;	/*!< number of flush_list entries
+				that may still be scanned */
+	}		flush_list_batch;
+					/*!< state of the running
+					flush_list batch, shared by the
+					page cleaner threads that scan
+					the flush_list from flush_hp;
+					protected by buf_pool_t::mutex */
 	ib_rbt_t*	flush_rbt;	/*!< a red-black tree is used
 					exclusively during recovery to
 					speed up insertions in the
@@ -32,6 +32,9 @@ Created 2011/12/19 Inaam Rana
 #include "buf0types.h"
 #include "log0recv.h"
 
+/** Maximum number of pages in a doublewrite batch */
+#define BUF_DBLWR_BATCH_MAX	512
+
 /** Doublewrite system */
 extern buf_dblwr_t*	buf_dblwr;
 /** Set to TRUE when the doublewrite buffer is being created */
@@ -99,14 +102,15 @@ written to the dblwr buffer on disk. */
 void
 buf_dblwr_sync_datafiles();
 
-/********************************************************************//**
-Flushes possible buffered writes from the doublewrite memory buffer to disk,
+/** Flushes possible buffered writes from the doublewrite memory buffer to disk,
 and also wakes up the aio thread if simulated aio is used. It is very
 important to call this function after a batch of writes has been posted,
 and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
+of threads can occur.
+@param[in]	instance_no	buffer pool instance whose doublewrite
+files should be written (innodb_doublewrite_files>0) */
 void
-buf_dblwr_flush_buffered_writes();
+buf_dblwr_flush_buffered_writes(ulint instance_no);
 
 /********************************************************************//**
 Writes a page to the doublewrite buffer on disk, sync it, then write
@@ -153,6 +157,16 @@ struct buf_dblwr_t{
 				(which is required by Windows aio) */
 	byte*		write_buf_unaligned;/*!< pointer to write_buf,
 				but unaligned */
+	byte*		reorder_buf;/*!< one page of scratch space after
+				write_buf, used when reordering a batch
+				by page identifier */
+	ulint		batch_size;/*!< number of pages at the start
+				of write_buf that are used for batches */
+	char*		path;	/*!< path of the doublewrite file
+				(innodb_doublewrite_files>0), or NULL
+				for the doublewrite buffer in the
+				system tablespace */
+	pfs_os_file_t	file;	/*!< handle to path */
 	buf_page_t**	buf_block_arr;/*!< array to store pointers to
 				the buffer blocks which have been
 				cached to write_buf */
@@ -28,6 +28,15 @@ Created April 08, 2011 Vasil Dimov
 
 #include "univ.i"
 
+/** Values of innodb_buffer_pool_dump_format */
+enum buf_dump_format_t {
+	/** one "space,page" line per page, in LRU order */
+	BUF_DUMP_TEXT,
+	/** delta-encoded page identifiers sorted by file offset,
+	each followed by its position in the LRU list */
+	BUF_DUMP_BINARY
+};
+
 /*****************************************************************//**
 Wakes up the buffer pool dump/load thread and instructs it to start
 a dump. This function is called by MySQL code via buffer_pool_dump_now()
@@ -1119,6 +1119,12 @@ struct dict_index_t {
 	bool		stats_error_printed;
 				/*!< has persistent statistics error printed
 				for this index ? */
+	ib_uint64_t	stat_modified_counter;
+				/*!< number of records inserted or
+				delete-marked since the statistics were
+				last calculated; like
+				dict_table_t::stat_modified_counter, not
+				protected by any latch */
 	/* @} */
 	/** Statistics for defragmentation, these numbers are estimations and
 	could be very inaccurate at certain times, e.g. right after restart,
@@ -2307,8 +2313,8 @@ struct dict_table_t {
 
 	/** Count of the number of record locks on this table. We use this to
 	determine whether we can evict the table from the dictionary cache.
-	It is protected by lock_sys.mutex. */
-	ulint					n_rec_locks;
+	Modified while holding lock_sys.latch in either mode. */
+	Atomic_counter<ulint>			n_rec_locks;
 private:
 	/** Count of how many handles are opened to this table. Dropping of the
 	table is NOT allowed until this count gets to zero. MySQL does NOT
@@ -40,6 +40,10 @@ enum dict_stats_upd_option_t {
 				storage, if the persistent storage is
 				not present then emit a warning and
 				fall back to transient stats */
+	DICT_STATS_RECALC_PERSISTENT_MODIFIED,/* like
+				DICT_STATS_RECALC_PERSISTENT, but keep the
+				statistics of the indexes that were modified
+				less than 10% since they were calculated */
 	DICT_STATS_RECALC_TRANSIENT,/* (re) calculate the statistics
 				using an imprecise quick algo
 				without saving the results
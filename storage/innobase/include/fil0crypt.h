@@ -91,6 +91,15 @@ struct fil_space_rotate_state_t
 				     rotated */
 	lsn_t end_lsn;		/*!< max lsn created when rotating this
 				space */
+	ulint pages_modified;	/*!< pages rewritten by this rotation */
+	ulint pages_skipped;	/*!< pages skipped by this rotation
+				because their extent was known to
+				be rotated already */
+	uint* extent_min_key_version; /*!< min key version of each extent,
+				      as found by the latest rotation that
+				      covered it, or 0 if unknown; NULL when
+				      not encrypting */
+	ulint n_extents;	/*!< size of extent_min_key_version */
 	bool starting;		/*!< initial write of IV */
 	bool flushing;		/*!< space is being flushed at end of rotate */
 	struct {
@@ -141,6 +150,7 @@ struct fil_space_crypt_t : st_encryption_scheme
 	/** Destructor */
 	~fil_space_crypt_t()
 	{
+		ut_free(rotate_state.extent_min_key_version);
 		mutex_free(&mutex);
 	}
 
@@ -218,6 +228,9 @@ struct fil_space_crypt_status_t {
 	bool flushing;           /*!< is flush at end of rotation ongoing */
 	ulint rotate_next_page_number; /*!< next page if key rotating */
 	ulint rotate_max_page_number;  /*!< max page if key rotating */
+	ulint rotate_pages_modified;   /*!< pages rewritten if key rotating */
+	ulint rotate_pages_skipped;    /*!< pages skipped if key rotating */
+	ulint rotate_pages_per_second; /*!< throughput if key rotating */
 };
 
 /** Statistics about encryption key rotation */
@@ -226,6 +239,7 @@ struct fil_crypt_stat_t {
 	ulint pages_read_from_disk;
 	ulint pages_modified;
 	ulint pages_flushed;
+	ulint pages_skipped;
 	ulint estimated_iops;
 };
 
@@ -43,6 +43,38 @@ ha_search_and_get_data(
 /*===================*/
 	hash_table_t*	table,	/*!< in: hash table */
 	ulint		fold);	/*!< in: folded value of the searched data */
+
+/** Look for an element in an adaptive hash index partition without
+holding the partition latch. Writers hold the latch in exclusive mode
+and make hash_table_t::ahi_seq odd while they modify or unlink chain
+nodes, so that a concurrent reader can detect that it may have followed
+a stale pointer. Nodes may only be dereferenced after the sequence
+number has been validated.
+@param[in]	table	adaptive hash index partition
+@param[in]	fold	folded value of the searched data
+@param[out]	seq	modification counter at the start of the search,
+			to be passed to ha_search_validate()
+@param[out]	data	the data of the first node having the fold number,
+			or NULL if not found
+@return whether the chain was read consistently */
+UNIV_INLINE
+bool
+ha_search_latch_free(
+	hash_table_t*	table,
+	ulint		fold,
+	ulint*		seq,
+	const rec_t**	data);
+
+/** Check that an adaptive hash index partition has not been modified
+since ha_search_latch_free().
+@param[in]	table	adaptive hash index partition
+@param[in]	seq	modification counter returned by ha_search_latch_free()
+@return whether the result of ha_search_latch_free() is still valid */
+UNIV_INLINE
+bool
+ha_search_validate(
+	const hash_table_t*	table,
+	ulint			seq);
 /*********************************************************//**
 Looks for an element when we know the pointer to the data and updates
 the pointer to data if found.
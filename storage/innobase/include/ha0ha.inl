@@ -173,6 +173,73 @@ ha_search_and_get_data(
 	return(NULL);
 }
 
+/** Check that an adaptive hash index partition has not been modified
+since ha_search_latch_free().
+@param[in]	table	adaptive hash index partition
+@param[in]	seq	modification counter returned by ha_search_latch_free()
+@return whether the result of ha_search_latch_free() is still valid */
+UNIV_INLINE
+bool
+ha_search_validate(
+	const hash_table_t*	table,
+	ulint			seq)
+{
+	/* Order the preceding reads of the chain before the read of
+	the counter. Pairs with the release fence in ha_modify_begin(). */
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return(table->ahi_seq == seq);
+}
+
+/** Look for an element in an adaptive hash index partition without
+holding the partition latch.
+@param[in]	table	adaptive hash index partition
+@param[in]	fold	folded value of the searched data
+@param[out]	seq	modification counter at the start of the search,
+			to be passed to ha_search_validate()
+@param[out]	data	the data of the first node having the fold number,
+			or NULL if not found
+@return whether the chain was read consistently */
+UNIV_INLINE
+bool
+ha_search_latch_free(
+	hash_table_t*	table,
+	ulint		fold,
+	ulint*		seq,
+	const rec_t**	data)
+{
+	ut_ad(table->magic_n == HASH_TABLE_MAGIC_N);
+	ut_ad(table->adaptive);
+
+	const ulint	s = table->ahi_seq;
+	std::atomic_thread_fence(std::memory_order_acquire);
+
+	*seq = s;
+	*data = NULL;
+
+	if (s & 1) {
+		/* A writer is modifying the partition. */
+		return(false);
+	}
+
+	for (const ha_node_t* node = ha_chain_get_first(table, fold);
+	     node != NULL;
+	     node = ha_chain_get_next(node)) {
+
+		/* The node may have been moved by HASH_DELETE_AND_COMPACT
+		or freed after we read the pointer to it. */
+		if (!ha_search_validate(table, s)) {
+			return(false);
+		}
+
+		if (node->fold == fold) {
+			*data = node->data;
+			break;
+		}
+	}
+
+	return(ha_search_validate(table, s));
+}
+
 /*********************************************************//**
 Looks for an element when we know the pointer to the data.
 @return pointer to the hash table node, NULL if not found in the table */
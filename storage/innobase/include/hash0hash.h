@@ -29,6 +29,7 @@ Created 5/20/1997 Heikki Tuuri
 
 #include "mem0mem.h"
 #include "sync0rw.h"
+#include "my_atomic_wrapper.h"
 
 struct hash_table_t;
 struct hash_cell_t;
@@ -490,6 +491,9 @@ struct hash_table_t {
 					table of the adaptive hash
 					index */
 # endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
+	Atomic_relaxed<ulint>	ahi_seq;/*!< adaptive hash index modification
+					counter; odd while a chain is being
+					modified, see ha_search_latch_free() */
 #endif /* BTR_CUR_HASH_ADAPT */
 	ulint			n_cells;/* number of cells in the hash table */
 	hash_cell_t*		array;	/*!< pointer to cell array */
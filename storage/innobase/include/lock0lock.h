@@ -484,13 +484,12 @@ lock_table(
 	lock_mode	mode,	/*!< in: lock mode */
 	que_thr_t*	thr)	/*!< in: query thread */
 	MY_ATTRIBUTE((warn_unused_result));
-/*********************************************************************//**
-Creates a table IX lock object for a resurrected transaction. */
-void
-lock_table_ix_resurrect(
-/*====================*/
-	dict_table_t*	table,	/*!< in/out: table */
-	trx_t*		trx);	/*!< in/out: transaction */
+/** Create a table lock object for a resurrected transaction.
+@param[in,out]	table	table
+@param[in,out]	trx	recovered transaction
+@param[in]	mode	LOCK_IX, or LOCK_X if the transaction wrote
+			a TRX_UNDO_EMPTY record for the table */
+void lock_table_resurrect(dict_table_t* table, trx_t* trx, lock_mode mode);
 
 /** Sets a lock on a table based on the given mode.
 @param[in]	table	table to lock
@@ -848,9 +847,21 @@ class lock_sys_t
   bool m_initialised;
 
 public:
+	/** Number of mutexes that partition the rec_hash cells */
+	static const ulint	REC_SHARDS = 256;
+
+	/** Mutex protecting a subset of the rec_hash cells */
+	struct MY_ALIGNED(CACHE_LINE_SIZE) rec_shard_t {
+		LockMutex	mutex;
+	};
+
 	MY_ALIGNED(CACHE_LINE_SIZE)
-	LockMutex	mutex;			/*!< Mutex protecting the
-						locks */
+	rw_lock_t	latch;			/*!< Latch protecting the
+						locks. An exclusive latch
+						covers everything; a shared
+						latch together with
+						rec_shards[] covers the
+						rec_hash cells of the shard */
 	hash_table_t*	rec_hash;		/*!< hash table of the record
 						locks */
 	hash_table_t*	prdt_hash;		/*!< hash table of the predicate
@@ -886,6 +897,8 @@ class lock_sys_t
 	bool		timeout_thread_active;	/*!< True if the timeout thread
 						is running */
 
+	/** Mutexes protecting rec_hash while latch is held in shared mode */
+	rec_shard_t	rec_shards[REC_SHARDS];
 
   /**
     Constructor.
@@ -917,6 +930,46 @@ class lock_sys_t
 
   /** Closes the lock system at database shutdown. */
   void close();
+
+
+  /** @return the shard mutex protecting a rec_hash cell
+  @param[in]	cell	rec_hash cell number, as returned by lock_rec_hash() */
+  LockMutex& rec_shard_mutex(ulint cell)
+  {
+    return rec_shards[cell % REC_SHARDS].mutex;
+  }
+
+
+  /**
+    Acquire the shared latch and the shard mutex of a rec_hash cell.
+    This allows the record lock queue of a page to be inspected and
+    extended without blocking operations on other shards. Anything
+    that cannot be done on a single queue, such as waiting or
+    deadlock detection, requires the exclusive latch.
+
+    The cell number depends on the size of rec_hash, which may only
+    change under the exclusive latch, so it is computed after the shared
+    latch has been acquired.
+
+    @param[in] block buffer block whose record lock queue is accessed
+    @return rec_hash cell number of the page, to pass to rec_shard_exit()
+  */
+  ulint rec_shard_enter(const buf_block_t *block);
+
+
+  /** Release the latches acquired by rec_shard_enter().
+  @param[in]	cell	rec_hash cell number */
+  void rec_shard_exit(ulint cell)
+  {
+    rec_shard_mutex(cell).exit();
+    rw_lock_s_unlock(&latch);
+  }
+
+#ifdef UNIV_DEBUG
+  /** @return whether the current thread may access a rec_hash cell
+  @param[in]	cell	rec_hash cell number */
+  bool rec_cell_own(ulint cell);
+#endif /* UNIV_DEBUG */
 };
 
 /*********************************************************************//**
@@ -1032,21 +1085,22 @@ lock_rec_free_all_from_discard_page(
 /** The lock system */
 extern lock_sys_t lock_sys;
 
-/** Test if lock_sys.mutex can be acquired without waiting. */
+/** Test if lock_sys.latch can be acquired in exclusive mode without waiting.
+@return 0 if the latch was acquired */
 #define lock_mutex_enter_nowait() 		\
-	(lock_sys.mutex.trylock(__FILE__, __LINE__))
+	(!rw_lock_x_lock_nowait(&lock_sys.latch))
 
-/** Test if lock_sys.mutex is owned. */
-#define lock_mutex_own() (lock_sys.mutex.is_owned())
+/** Test if lock_sys.latch is owned in exclusive mode. */
+#define lock_mutex_own() rw_lock_own(&lock_sys.latch, RW_LOCK_X)
 
-/** Acquire the lock_sys.mutex. */
+/** Acquire the lock_sys.latch in exclusive mode. */
 #define lock_mutex_enter() do {			\
-	mutex_enter(&lock_sys.mutex);		\
+	rw_lock_x_lock(&lock_sys.latch);	\
 } while (0)
 
-/** Release the lock_sys.mutex. */
+/** Release the exclusive lock_sys.latch. */
 #define lock_mutex_exit() do {			\
-	lock_sys.mutex.exit();			\
+	rw_lock_x_unlock(&lock_sys.latch);	\
 } while (0)
 
 /** Test if lock_sys.wait_mutex is owned. */
@@ -156,12 +156,12 @@ lock_rec_get_first_on_page(
 	hash_table_t*		lock_hash,	/*!< in: lock hash table */
 	const buf_block_t*	block)		/*!< in: buffer block */
 {
-	ut_ad(lock_mutex_own());
-
 	ulint	space	= block->page.id.space();
 	ulint	page_no	= block->page.id.page_no();
 	ulint	hash = buf_block_get_lock_hash_val(block);
 
+	ut_ad(lock_sys.rec_cell_own(hash));
+
 	for (lock_t* lock = static_cast<lock_t*>(
 			HASH_GET_FIRST(lock_hash, hash));
 	     lock != NULL;
@@ -267,12 +267,13 @@ lock_rec_get_next_on_page_const(
 /*============================*/
 	const lock_t*	lock)	/*!< in: a record lock */
 {
-	ut_ad(lock_mutex_own());
 	ut_ad(lock_get_type_low(lock) == LOCK_REC);
 
 	ulint	space = lock->un_member.rec_lock.space;
 	ulint	page_no = lock->un_member.rec_lock.page_no;
 
+	ut_ad(lock_sys.rec_cell_own(lock_rec_hash(space, page_no)));
+
 	while ((lock = static_cast<const lock_t*>(HASH_GET_NEXT(hash, lock)))
 	       != NULL) {
 
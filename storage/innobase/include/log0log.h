@@ -56,17 +56,21 @@ step which modifies the database, is started */
 #define LOG_CHECKPOINT_FREE_PER_THREAD	(4U << srv_page_size_shift)
 #define LOG_CHECKPOINT_EXTRA_FREE	(8U << srv_page_size_shift)
 
-/** Append a string to the log.
+/** Reserve space for a string that fits in the current log block.
+The string must be copied with log_t::copy() after log_sys.mutex
+has been released.
 @param[in]	str		string
 @param[in]	len		string length
 @param[out]	start_lsn	start LSN of the log record
+@param[out]	offset		where to copy the string in log_sys.buf
 @return end lsn of the log record, zero if did not succeed */
 UNIV_INLINE
 lsn_t
-log_reserve_and_write_fast(
+log_reserve_fast(
 	const void*	str,
 	ulint		len,
-	lsn_t*		start_lsn);
+	lsn_t*		start_lsn,
+	ulint*		offset);
 /***********************************************************************//**
 Checks if there is need for a log buffer flush or a new checkpoint, and does
 this if yes. Any database operation should call this when it has modified
@@ -96,6 +100,12 @@ log_margin_checkpoint_age(
 lsn_t
 log_reserve_and_open(
 	ulint	len);
+/** Reserve space for a string in the log buffer and update the log block
+headers. The caller must hold log_sys.mutex and have invoked
+log_reserve_and_open().
+@param[in]	len	string length
+@return where to copy the string in log_sys.buf with log_t::copy() */
+ulint log_reserve_low(ulint len);
 /************************************************************//**
 Writes to the log the string given. It is assumed that the caller holds the
 log mutex. */
@@ -495,6 +505,12 @@ struct log_t{
 	ulong		buf_free;	/*!< first free offset within the log
 					buffer in use */
 
+	/** Number of reservations in buf whose log records have not been
+	copied yet. Incremented while holding mutex, decremented by copy_done()
+	without holding it. */
+	MY_ALIGNED(CACHE_LINE_SIZE)
+	std::atomic<ulint>	n_pending_copies;
+
 	MY_ALIGNED(CACHE_LINE_SIZE)
 	LogSysMutex	mutex;		/*!< mutex protecting the log */
 	MY_ALIGNED(CACHE_LINE_SIZE)
@@ -711,6 +727,45 @@ struct log_t{
       : OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_CHECKSUM;
   }
 
+  /** Copy log records to space that was reserved by log_reserve_low()
+  or log_reserve_fast(). This does not require mutex.
+  @param[in]	offset	offset in buf
+  @param[in]	str	log records
+  @param[in]	len	length of str in bytes
+  @return offset after the copied records */
+  ulint copy(ulint offset, const byte* str, ulint len)
+  {
+    const ulint trailer= trailer_offset();
+
+    while (len)
+    {
+      const ulint in_block= offset % OS_FILE_LOG_BLOCK_SIZE;
+      ut_ad(in_block >= LOG_BLOCK_HDR_SIZE);
+      ut_ad(in_block < trailer);
+      const ulint n= std::min(len, trailer - in_block);
+      memcpy(buf + offset, str, n);
+      str+= n;
+      len-= n;
+      offset+= n;
+      if (len)
+        /* Skip the trailer of this block and the header of the next one */
+        offset+= framing_size();
+    }
+
+    return offset;
+  }
+
+  /** Note that the log records of a reservation have been copied. */
+  void copy_done()
+  {
+    ut_d(const ulint n=) n_pending_copies.fetch_sub(1, std::memory_order_release);
+    ut_ad(n);
+  }
+
+  /** Wait until all reserved log records have been copied to buf.
+  The caller must hold mutex, so that no new space can be reserved. */
+  void wait_for_copies() const;
+
   /** Initialise the redo log subsystem. */
   void create();
 
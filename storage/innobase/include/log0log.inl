@@ -276,17 +276,21 @@ log_block_init(
 	log_block_set_first_rec_group(log_block, 0);
 }
 
-/** Append a string to the log.
+/** Reserve space for a string that fits in the current log block.
+The string must be copied with log_t::copy() after log_sys.mutex
+has been released.
 @param[in]	str		string
 @param[in]	len		string length
 @param[out]	start_lsn	start LSN of the log record
+@param[out]	offset		where to copy the string in log_sys.buf
 @return end lsn of the log record, zero if did not succeed */
 UNIV_INLINE
 lsn_t
-log_reserve_and_write_fast(
+log_reserve_fast(
 	const void*	str,
 	ulint		len,
-	lsn_t*		start_lsn)
+	lsn_t*		start_lsn,
+	ulint*		offset)
 {
 	ut_ad(log_mutex_own());
 	ut_ad(len > 0);
@@ -328,6 +332,7 @@ log_reserve_and_write_fast(
 	}
 
 	*start_lsn = log_sys.lsn;
+	*offset = log_sys.buf_free;
 
 #ifdef UNIV_LOG_LSN_DEBUG
 	if (lsn_len) {
@@ -342,12 +347,10 @@ log_reserve_and_write_fast(
 		b += mach_write_compressed(b, log_sys.lsn & 0xFFFFFFFFUL);
 		ut_a(b - lsn_len == &log_sys.buf[log_sys.buf_free]);
 
-		::memcpy(b, str, len);
-
+		*offset += lsn_len;
 		len += lsn_len;
-	} else
+	}
 #endif /* UNIV_LOG_LSN_DEBUG */
-	memcpy(log_sys.buf + log_sys.buf_free, str, len);
 
 	log_block_set_data_len(
                 reinterpret_cast<byte*>(ut_align_down(
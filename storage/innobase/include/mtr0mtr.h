@@ -438,11 +438,15 @@ struct mtr_t {
 	@return number of bytes to write in finish_write() */
 	inline ulint prepare_write();
 
-	/** Append the redo log records to the redo log buffer.
+	/** Reserve space for the redo log records in the redo log buffer.
 	@param[in]	len	number of bytes to write
 	@return start_lsn */
 	inline lsn_t finish_write(ulint len);
 
+	/** Copy the redo log records to the space reserved by
+	finish_write(). This does not require log_sys.mutex. */
+	inline void copy_log();
+
 	/** Release the resources */
 	inline void release_resources();
 
@@ -484,6 +488,9 @@ struct mtr_t {
 
 	/** LSN at commit time */
 	lsn_t		m_commit_lsn;
+
+	/** offset of the log records in log_sys.buf, set by finish_write() */
+	ulint		m_log_offset;
 };
 
 #include "mtr0mtr.inl"
@@ -77,7 +77,8 @@ class ReadView
 
 
 public:
-  ReadView(): m_state(READ_VIEW_STATE_CLOSED), m_low_limit_id(0) {}
+  ReadView(): m_state(READ_VIEW_STATE_CLOSED), m_low_limit_id(0),
+    m_ids_version(TRX_ID_MAX) {}
 
 
   /**
@@ -92,6 +93,8 @@ class ReadView
   void copy(const ReadView &other)
   {
     ut_ad(&other != this);
+    /* m_ids will no longer match a trx_sys snapshot */
+    m_ids_version= TRX_ID_MAX;
     if (m_low_limit_no > other.m_low_limit_no)
       m_low_limit_no= other.m_low_limit_no;
     if (m_low_limit_id > other.m_low_limit_id)
@@ -283,6 +286,10 @@ class ReadView
 	was taken */
 	trx_ids_t	m_ids;
 
+	/** trx_sys.m_rw_trx_hash_changes when m_ids were collected,
+	or TRX_ID_MAX if m_ids cannot be reused by the next snapshot */
+	trx_id_t	m_ids_version;
+
 	/** The view does not need to see the undo logs for transactions
 	whose transaction number is strictly smaller (<) than this value:
 	they can be removed in purge if not needed by other views */
@@ -128,6 +128,45 @@ cmp_dtuple_rec_with_match_low(
 #define cmp_dtuple_rec_with_match(tuple,rec,offsets,fields)		\
 	cmp_dtuple_rec_with_match_low(					\
 		tuple,rec,offsets,dtuple_get_n_fields_cmp(tuple),fields)
+/** A search tuple whose fields are fixed-length, NOT NULL and ordered
+by memcmp(), such as most PRIMARY KEYs, converted to a byte string.
+Because such fields are stored contiguously at the start of B-tree
+records, the key can be compared to a record without rec_get_offsets()
+and without dispatching on the data type of each field. */
+struct cmp_normalized_key_t
+{
+	/** Maximum length of a key, in bytes */
+	static const ulint	max_len = 64;
+	/** Maximum number of fields in a key */
+	static const ulint	max_fields = 16;
+
+	/** Convert a search tuple.
+	@param[in]	tuple	search tuple
+	@param[in]	index	B-tree index
+	@return whether the tuple can be compared by cmp() */
+	bool init(const dtuple_t* tuple, const dict_index_t* index);
+
+	/** Compare the key to a record.
+	@see cmp_dtuple_rec_with_match()
+	@param[in]	rec		B-tree record
+	@param[in]	comp		whether the record is in ROW_FORMAT=COMPACT
+	@param[in,out]	matched_fields	number of completely matched fields
+	@retval 0 if the key is equal to rec
+	@retval negative if the key is less than rec
+	@retval positive if the key is greater than rec */
+	int cmp(const rec_t* rec, bool comp, ulint* matched_fields) const;
+
+private:
+	/** length of the key, in bytes */
+	ulint	len;
+	/** number of fields */
+	ulint	n_fields;
+	/** end offset of each field in buf */
+	ulint	field_end[max_fields];
+	/** the fields of the search tuple */
+	byte	buf[max_len];
+};
+
 /** Compare a data tuple to a physical record.
 @param[in]	dtuple		data tuple
 @param[in]	rec		B-tree or R-tree index record
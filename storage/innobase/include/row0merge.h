@@ -408,6 +408,7 @@ row_merge_file_create(
 @param[in,out]	stage	performance schema accounting object, used by
 ALTER TABLE. If not NULL, stage->begin_phase_sort() will be called initially
 and then stage->inc() will be called for each record processed.
+@param[in]	n_threads	maximum number of threads for merging
 @return DB_SUCCESS or error code */
 dberr_t
 row_merge_sort(
@@ -422,7 +423,8 @@ row_merge_sort(
 	const double	pct_cost,
 	row_merge_block_t*	crypt_block,
 	ulint			space,
-	ut_stage_alter_t*	stage = NULL)
+	ut_stage_alter_t*	stage = NULL,
+	ulint			n_threads = 1)
 	MY_ATTRIBUTE((warn_unused_result));
 
 /*********************************************************************//**
@@ -483,4 +485,78 @@ row_merge_read_rec(
 	row_merge_block_t*	crypt_block, /*!< in: crypt buf or NULL */
 	ulint			space)	   /*!< in: space id */
 	MY_ATTRIBUTE((warn_unused_result));
+
+/** Index entries of a bulk insert into an empty table. The entries of
+each index are collected into a sort buffer; a full buffer is sorted
+and written to a temporary file as one run. At the end of the statement,
+the runs are merge sorted and the indexes are built by BtrBulk, like
+row_merge_build_indexes() does for ALTER TABLE. */
+class row_merge_bulk_t
+{
+	/** sort buffer for each index */
+	row_merge_buf_t**		m_merge_buf;
+	/** temporary file for each index */
+	merge_file_t*			m_merge_files;
+	/** number of indexes */
+	ulint				m_n_index;
+	/** temporary file for row_merge_sort() */
+	pfs_os_file_t			m_tmpfd;
+	/** allocator of m_block and m_crypt_block */
+	ut_allocator<row_merge_block_t>	m_alloc;
+	/** 3 * srv_sort_buf_size bytes for writing and merging runs,
+	or NULL if no run has been written yet */
+	row_merge_block_t*		m_block;
+	/** allocation metadata of m_block */
+	ut_new_pfx_t			m_block_pfx;
+	/** buffer for encrypting m_block, or NULL */
+	row_merge_block_t*		m_crypt_block;
+	/** allocation metadata of m_crypt_block */
+	ut_new_pfx_t			m_crypt_pfx;
+	/** largest AUTO_INCREMENT value in the clustered index entries */
+	ib_uint64_t			m_autoinc;
+
+public:
+	/** Constructor
+	@param[in]	table	table whose indexes are empty */
+	explicit row_merge_bulk_t(dict_table_t* table);
+
+	/** Destructor; discards any buffered entries */
+	~row_merge_bulk_t();
+
+	/** Buffer an index entry.
+	@param[in]	entry	index entry
+	@param[in]	index	index of the entry
+	@param[in,out]	trx	transaction
+	@return error code */
+	dberr_t bulk_insert_buffered(const dtuple_t& entry,
+				     const dict_index_t& index, trx_t* trx);
+
+	/** Sort the buffered entries and load them into the indexes.
+	@param[in,out]	table		table
+	@param[in,out]	trx		transaction
+	@param[in,out]	mysql_table	MySQL table for reporting duplicate
+					keys, or NULL
+	@return error code */
+	dberr_t write_to_table(dict_table_t* table, trx_t* trx,
+			       struct TABLE* mysql_table);
+
+private:
+	/** Allocate m_block and m_crypt_block if needed.
+	@return whether the allocation succeeded */
+	bool alloc_block();
+
+	/** Sort a full sort buffer and write it as a run to the
+	temporary file of the index.
+	@param[in]	i	index number
+	@param[in,out]	trx	transaction
+	@return error code */
+	dberr_t write_to_tmp_file(ulint i, trx_t* trx);
+
+	/** Sort the entries of an index and load them into the index.
+	@param[in]	i		index number
+	@param[in,out]	trx		transaction
+	@param[in,out]	mysql_table	MySQL table, or NULL
+	@return error code */
+	dberr_t write_to_index(ulint i, trx_t* trx, struct TABLE* mysql_table);
+};
 #endif /* row0merge.h */
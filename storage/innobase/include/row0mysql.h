@@ -52,6 +52,10 @@ row_mysql_prebuilt_free_blob_heap(
 /*==============================*/
 	row_prebuilt_t*	prebuilt);	/*!< in: prebuilt struct of a
 					ha_innobase:: table handle */
+
+/** Free the prefetch cache of a table handle.
+@param[in,out]	prebuilt	prebuilt struct of a ha_innobase:: table handle */
+void row_mysql_prebuilt_free_fetch_cache(row_prebuilt_t* prebuilt);
 /*******************************************************************//**
 Stores a >= 5.0.3 format true VARCHAR length to dest, in the MySQL row
 format.
@@ -493,6 +497,24 @@ row_scan_index_for_mysql(
 	ulint*			n_rows)		/*!< out: number of entries
 						seen in the consistent read */
 	MY_ATTRIBUTE((warn_unused_result));
+
+/** Count the records of a clustered index that are visible in the read
+view of a transaction. The index is divided into key ranges by sampling
+the upper levels of the B-tree, and the ranges are scanned by up to
+innodb_parallel_scan_threads threads.
+@param[in]	trx	transaction whose read view is being used
+@param[in]	index	clustered index
+@param[in]	check	whether to check the order and uniqueness
+			of the records (CHECK TABLE)
+@param[out]	n_rows	number of records seen in the consistent read
+@return DB_SUCCESS or error code */
+dberr_t
+row_scan_clust_index_parallel(
+	const trx_t*	trx,
+	dict_index_t*	index,
+	bool		check,
+	ulint*		n_rows)
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
 /*********************************************************************//**
 Initialize this module */
 void
@@ -562,9 +584,15 @@ struct mysql_row_templ_t {
 	ulint	is_virtual;		/*!< if a column is a virtual column */
 };
 
+/* Initial number of rows to prefetch in fetch_cache */
 #define MYSQL_FETCH_CACHE_SIZE		8
 /* After fetching this many rows, we start caching them in fetch_cache */
 #define MYSQL_FETCH_CACHE_THRESHOLD	4
+/* The number of rows to prefetch is doubled every time the cache was
+filled up, until it reaches this many rows ... */
+#define MYSQL_FETCH_CACHE_MAX_SIZE	1024
+/* ... or the rows would occupy more than this many bytes */
+#define MYSQL_FETCH_CACHE_MAX_BYTES	(256U << 10)
 
 #define ROW_PREBUILT_ALLOCATED	78540783
 #define ROW_PREBUILT_FREED	26423527
@@ -737,7 +765,7 @@ struct row_prebuilt_t {
 	ulint		n_rows_fetched;	/*!< number of rows fetched after
 					positioning the current cursor */
 	ulint		fetch_direction;/*!< ROW_SEL_NEXT or ROW_SEL_PREV */
-	byte*		fetch_cache[MYSQL_FETCH_CACHE_SIZE];
+	byte**		fetch_cache;
 					/*!< a cache for fetched rows if we
 					fetch many rows from the same cursor:
 					it saves CPU time to fetch them in a
@@ -747,6 +775,12 @@ struct row_prebuilt_t {
 					allocated mem buf start, because
 					there is a 4 byte magic number at the
 					start and at the end */
+	ulint		fetch_cache_alloc;/*!< number of rows allocated
+					in fetch_cache */
+	ulint		fetch_cache_size;/*!< number of rows to prefetch
+					in the next batch; grows from
+					MYSQL_FETCH_CACHE_SIZE while a scan
+					keeps consuming full batches */
 	bool		keep_other_fields_on_keyread; /*!< when using fetch
 					cache with HA_EXTRA_KEYREAD, don't
 					overwrite other fields in mysql row
@@ -154,6 +154,12 @@ struct srv_stats_t
 	/** Number of rows inserted */
 	ulint_ctr_64_t		n_rows_inserted;
 
+	/** Number of rows copied to the prefetch cache */
+	ulint_ctr_64_t		n_rows_prefetched;
+
+	/** Number of rows returned from the prefetch cache */
+	ulint_ctr_64_t		n_prefetch_hits;
+
 	/** Number of system rows read. */
 	ulint_ctr_64_t		n_system_rows_read;
 
@@ -208,6 +214,10 @@ extern os_event_t	srv_buf_resize_event;
 /** The buffer pool dump/load file name */
 #define SRV_BUF_DUMP_FILENAME_DEFAULT	"ib_buffer_pool"
 extern char*		srv_buf_dump_filename;
+/** innodb_buffer_pool_dump_format */
+extern ulong		srv_buf_dump_format;
+/** innodb_buffer_pool_load_threads */
+extern ulong		srv_buf_load_threads;
 
 /** Boolean config knobs that tell InnoDB to dump the buffer pool at shutdown
 and/or load it during startup. */
@@ -261,6 +271,8 @@ extern ibool	srv_locks_unsafe_for_binlog;
 extern ulong	srv_sort_buf_size;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
+/** innodb_ddl_threads */
+extern ulong	srv_ddl_threads;
 
 /* If this flag is TRUE, then we will use the native aio of the
 OS (provided we compiled Innobase with it in), otherwise we will
@@ -383,6 +395,12 @@ extern my_bool	srv_random_read_ahead;
 extern ulong	srv_read_ahead_threshold;
 extern ulong	srv_n_read_io_threads;
 extern ulong	srv_n_write_io_threads;
+/** innodb_recovery_threads */
+extern ulong	srv_n_recovery_threads;
+/** innodb_parallel_scan_threads */
+extern ulong	srv_parallel_scan_threads;
+/** innodb_stats_analyze_threads */
+extern ulong	srv_stats_analyze_threads;
 
 /* Defragmentation, Origianlly facebook default value is 100, but it's too high */
 #define SRV_DEFRAGMENT_FREQUENCY_DEFAULT 40
@@ -450,6 +468,8 @@ extern my_bool			srv_stats_sample_traditional;
 
 extern my_bool	srv_use_doublewrite_buf;
 extern ulong	srv_doublewrite_batch_size;
+extern ulong	srv_doublewrite_files;
+extern ulong	srv_doublewrite_pages;
 extern ulong	srv_checksum_algorithm;
 
 extern double	srv_max_buf_pool_modified_pct;
@@ -592,7 +612,9 @@ extern ulong srv_buf_dump_status_frequency;
 # ifdef UNIV_PFS_THREAD
 /* Keys to register InnoDB threads with performance schema */
 extern mysql_pfs_key_t	buf_dump_thread_key;
+extern mysql_pfs_key_t	buf_load_thread_key;
 extern mysql_pfs_key_t	dict_stats_thread_key;
+extern mysql_pfs_key_t	dict_stats_analyze_thread_key;
 extern mysql_pfs_key_t	io_handler_thread_key;
 extern mysql_pfs_key_t	io_ibuf_thread_key;
 extern mysql_pfs_key_t	io_log_thread_key;
@@ -600,6 +622,10 @@ extern mysql_pfs_key_t	io_read_thread_key;
 extern mysql_pfs_key_t	io_write_thread_key;
 extern mysql_pfs_key_t	page_cleaner_thread_key;
 extern mysql_pfs_key_t	recv_writer_thread_key;
+extern mysql_pfs_key_t	recv_apply_thread_key;
+extern mysql_pfs_key_t	row_merge_thread_key;
+extern mysql_pfs_key_t	row_log_thread_key;
+extern mysql_pfs_key_t	row_scan_thread_key;
 extern mysql_pfs_key_t	srv_error_monitor_thread_key;
 extern mysql_pfs_key_t	srv_lock_timeout_thread_key;
 extern mysql_pfs_key_t	srv_master_thread_key;
@@ -1040,6 +1066,7 @@ struct export_var_t{
 	ulint innodb_encryption_rotation_pages_read_from_disk;
 	ulint innodb_encryption_rotation_pages_modified;
 	ulint innodb_encryption_rotation_pages_flushed;
+	ulint innodb_encryption_rotation_pages_skipped;
 	ulint innodb_encryption_rotation_estimated_iops;
 	int64_t innodb_encryption_key_requests;
 
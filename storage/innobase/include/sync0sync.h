@@ -91,7 +91,7 @@ extern mysql_pfs_key_t	buf_dblwr_mutex_key;
 extern mysql_pfs_key_t	trx_mutex_key;
 extern mysql_pfs_key_t	trx_pool_mutex_key;
 extern mysql_pfs_key_t	trx_pool_manager_mutex_key;
-extern mysql_pfs_key_t	lock_mutex_key;
+extern mysql_pfs_key_t	lock_rec_shard_mutex_key;
 extern mysql_pfs_key_t	lock_wait_mutex_key;
 extern mysql_pfs_key_t	trx_sys_mutex_key;
 extern mysql_pfs_key_t	srv_sys_mutex_key;
@@ -108,6 +108,7 @@ extern mysql_pfs_key_t	rw_trx_hash_element_mutex_key;
 /* Following are rwlock keys used to register with MySQL
 performance schema */
 extern	mysql_pfs_key_t btr_search_latch_key;
+extern	mysql_pfs_key_t	lock_sys_latch_key;
 extern	mysql_pfs_key_t	buf_block_lock_key;
 # ifdef UNIV_DEBUG
 extern	mysql_pfs_key_t	buf_block_debug_latch_key;
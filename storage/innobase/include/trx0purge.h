@@ -202,6 +202,10 @@ class purge_sys_t
 	ulint		hdr_offset;	/*!< Header byte offset on the page */
 
 
+	mem_heap_t*	heap;		/*!< Copies of the undo log records
+					of the current purge batch (only
+					accessed by the purge coordinator) */
+
 	TrxUndoRsegsIterator
 			rseg_iter;	/*!< Iterator to get the next rseg
 					to process */
@@ -155,7 +155,9 @@ trx_undo_report_row_operation(
 	dict_index_t*	index,		/*!< in: clustered index */
 	const dtuple_t*	clust_entry,	/*!< in: in the case of an insert,
 					index entry to insert into the
-					clustered index; in updates,
+					clustered index, or NULL to write
+					TRX_UNDO_EMPTY before a bulk insert
+					into an empty table; in updates,
 					may contain a clustered index
 					record tuple that also contains
 					virtual columns of the table;
@@ -282,6 +284,8 @@ trx_undo_read_v_idx(
 compilation info multiplied by 16 is ORed to this value in an undo log
 record */
 
+#define	TRX_UNDO_EMPTY		8	/*!< empty the table (roll back
+					a bulk insert into an empty table) */
 #define	TRX_UNDO_RENAME_TABLE	9	/*!< RENAME TABLE */
 #define	TRX_UNDO_INSERT_METADATA 10	/*!< insert a metadata
 					pseudo-record for instant ALTER */
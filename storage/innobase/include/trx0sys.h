@@ -824,6 +824,19 @@ class trx_sys_t
   MY_ALIGNED(CACHE_LINE_SIZE) std::atomic<trx_id_t> m_rw_trx_hash_version;
 
 
+  /**
+    Incremented whenever the set of identifiers or serialisation numbers
+    collected by snapshot_ids() may change, that is by register_rw(),
+    deregister_rw() and assign_new_trx_no().
+
+    Allows read views to reuse previously collected identifiers instead of
+    iterating rw_trx_hash again.
+
+    @sa snapshot_ids()
+  */
+  MY_ALIGNED(CACHE_LINE_SIZE) std::atomic<trx_id_t> m_rw_trx_hash_changes;
+
+
   bool m_initialised;
 
 public:
@@ -952,6 +965,7 @@ class trx_sys_t
   {
     trx->no= get_new_trx_id_no_refresh();
     trx->rw_trx_hash_element->no= trx->no;
+    refresh_rw_trx_hash_changes();
     refresh_rw_trx_hash_version();
   }
 
@@ -972,14 +986,25 @@ class trx_sys_t
     of rw_trx_hash.iterate_no_dups(). It means that some transaction
     identifiers may appear multiple times in ids.
 
+    If m_rw_trx_hash_changes still equals version, no transaction was
+    registered, deregistered or serialised since ids were collected. In this
+    case ids are left intact and only max_trx_id and min_trx_no are updated,
+    so that repeatedly opened views do not have to touch rw_trx_hash at all.
+    register_rw() and assign_new_trx_no() increment m_rw_trx_hash_changes
+    before m_rw_trx_hash_version, thus the ACQUIRE barrier of
+    get_rw_trx_hash_version() makes the change visible here.
+
     @param[in,out] caller_trx used to get access to rw_trx_hash_pins
-    @param[out]    ids        array to store registered transaction identifiers
-    @param[out]    max_trx_id variable to store m_max_trx_id value
-    @param[out]    mix_trx_no variable to store min(trx->no) value
+    @param[in,out] ids        array to store registered transaction identifiers
+    @param[in,out] max_trx_id variable to store m_max_trx_id value
+    @param[in,out] mix_trx_no variable to store min(trx->no) value
+    @param[in,out] version    m_rw_trx_hash_changes at the time ids were
+                              collected
+    @return whether ids were collected anew (and need to be sorted)
   */
 
-  void snapshot_ids(trx_t *caller_trx, trx_ids_t *ids, trx_id_t *max_trx_id,
-                    trx_id_t *min_trx_no)
+  bool snapshot_ids(trx_t *caller_trx, trx_ids_t *ids, trx_id_t *max_trx_id,
+                    trx_id_t *min_trx_no, trx_id_t *version)
   {
     ut_ad(!mutex_own(&mutex));
     snapshot_ids_arg arg(ids);
@@ -988,6 +1013,17 @@ class trx_sys_t
       ut_delay(1);
     arg.m_no= arg.m_id;
 
+    const trx_id_t changes=
+      m_rw_trx_hash_changes.load(std::memory_order_acquire);
+    if (changes == *version)
+    {
+      ut_ad(*max_trx_id <= arg.m_id);
+      if (*min_trx_no >= *max_trx_id)
+        *min_trx_no= arg.m_id;
+      *max_trx_id= arg.m_id;
+      return false;
+    }
+
     ids->clear();
     ids->reserve(rw_trx_hash.size() + 32);
     rw_trx_hash.iterate(caller_trx,
@@ -996,6 +1032,8 @@ class trx_sys_t
 
     *max_trx_id= arg.m_id;
     *min_trx_no= arg.m_no;
+    *version= changes;
+    return true;
   }
 
 
@@ -1004,6 +1042,7 @@ class trx_sys_t
   {
     m_max_trx_id= value;
     m_rw_trx_hash_version.store(value, std::memory_order_relaxed);
+    m_rw_trx_hash_changes.store(0, std::memory_order_relaxed);
   }
 
 
@@ -1044,6 +1083,7 @@ class trx_sys_t
   {
     trx->id= get_new_trx_id_no_refresh();
     rw_trx_hash.insert(trx);
+    refresh_rw_trx_hash_changes();
     refresh_rw_trx_hash_version();
   }
 
@@ -1058,6 +1098,7 @@ class trx_sys_t
   void deregister_rw(trx_t *trx)
   {
     rw_trx_hash.erase(trx);
+    refresh_rw_trx_hash_changes();
   }
 
 
@@ -1178,6 +1219,13 @@ class trx_sys_t
   }
 
 
+  /** Increments m_rw_trx_hash_changes, must issue RELEASE memory barrier. */
+  void refresh_rw_trx_hash_changes()
+  {
+    m_rw_trx_hash_changes.fetch_add(1, std::memory_order_release);
+  }
+
+
   /**
     Allocates new transaction id without refreshing rw_trx_hash version.
 
@@ -504,6 +504,8 @@ struct trx_lock_t {
 	ulint		n_rec_locks;	/*!< number of rec locks in this trx */
 };
 
+class row_merge_bulk_t;
+
 /** Logical first modification time of a table in a transaction */
 class trx_mod_table_time_t
 {
@@ -511,16 +513,52 @@ class trx_mod_table_time_t
 	undo_no_t	first;
 	/** First modification of a system versioned column */
 	undo_no_t	first_versioned;
+	/** Whether the table was empty at the first modification,
+	a TRX_UNDO_EMPTY record was written and inserts of the current
+	statement are not being undo logged */
+	bool		bulk_insert;
 
 	/** Magic value signifying that a system versioned column of a
 	table was never modified in a transaction. */
 	static const undo_no_t UNVERSIONED = IB_ID_MAX;
 
 public:
+	/** Index entries buffered by the bulk insert, to be sorted and
+	loaded into the empty indexes by row_merge_bulk_t::write_to_table(),
+	or NULL if the inserts are being applied row by row */
+	row_merge_bulk_t*	bulk_store;
+
 	/** Constructor
 	@param[in]	rows	number of modified rows so far */
 	trx_mod_table_time_t(undo_no_t rows)
-		: first(rows), first_versioned(UNVERSIONED) {}
+		: first(rows), first_versioned(UNVERSIONED),
+		  bulk_insert(false), bulk_store(NULL) {}
+
+	/** Copy constructor; only used while inserting to
+	trx_t::mod_tables, before any bulk insert buffer exists */
+	trx_mod_table_time_t(const trx_mod_table_time_t& other)
+		: first(other.first), first_versioned(other.first_versioned),
+		  bulk_insert(other.bulk_insert), bulk_store(NULL)
+	{
+		ut_ad(!other.bulk_store);
+	}
+
+	~trx_mod_table_time_t() { if (bulk_store) end_bulk_insert(); }
+
+	/** @return whether inserts are not being undo logged */
+	bool is_bulk_insert() const { return bulk_insert; }
+
+	/** Note that a TRX_UNDO_EMPTY record was written */
+	void start_bulk_insert()
+	{
+		ut_ad(!bulk_insert);
+		ut_ad(!bulk_store);
+		bulk_insert = true;
+	}
+
+	/** Resume undo logging after the bulk insert statement,
+	discarding any buffered index entries */
+	void end_bulk_insert();
 
 #ifdef UNIV_DEBUG
 	/** Validation
@@ -802,6 +840,9 @@ struct trx_t {
 					flush the log in
 					trx_commit_complete_for_mysql() */
 	ulint		duplicates;	/*!< TRX_DUP_IGNORE | TRX_DUP_REPLACE */
+	/** whether the current statement may use the bulk insert of
+	empty tables (ha_innobase::start_bulk_insert() was called) */
+	bool		bulk_insert;
 	trx_dict_op_t	dict_operation;	/**< @see enum trx_dict_op_t */
 
 	/* Fields protected by the srv_conc_mutex. */
@@ -904,6 +945,11 @@ struct trx_t {
 					vector needs to be freed explicitly
 					when the trx instance is destroyed.
 					Protected by lock_sys.mutex. */
+	/** number of rows that row_search_mvcc() copied to the
+	prefetch cache for this connection */
+	ulint		n_rows_prefetched;
+	/** number of rows that were returned from the prefetch cache */
+	ulint		n_prefetch_hits;
 	/*------------------------------*/
 	bool		read_only;	/*!< true if transaction is flagged
 					as a READ-ONLY transaction.
@@ -997,6 +1043,16 @@ struct trx_t {
 		return flush_observer;
 	}
 
+	/** Load the buffered bulk inserts of all tables into the indexes
+	and resume undo logging for the tables.
+	@param[in]	table		table whose MySQL handle is
+					mysql_table, or NULL
+	@param[in,out]	mysql_table	MySQL table for reporting duplicate
+					keys, or NULL
+	@return error code */
+	dberr_t bulk_insert_apply(const dict_table_t* table = NULL,
+				  struct TABLE* mysql_table = NULL);
+
   /** Transition to committed state, to release implicit locks. */
   inline void commit_state();
 
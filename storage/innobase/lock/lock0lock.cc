@@ -36,6 +36,7 @@ Created 5/7/1996 Heikki Tuuri
 #include "dict0mem.h"
 #include "trx0purge.h"
 #include "trx0sys.h"
+#include "sync0sync.h"
 #include "ut0vec.h"
 #include "btr0cur.h"
 #include "row0sel.h"
@@ -461,7 +462,11 @@ void lock_sys_t::create(ulint n_cells)
 		(ut_zalloc_nokey(srv_max_n_threads * sizeof *waiting_threads));
 	last_slot = waiting_threads;
 
-	mutex_create(LATCH_ID_LOCK_SYS, &mutex);
+	rw_lock_create(lock_sys_latch_key, &latch, SYNC_LOCK_SYS);
+
+	for (ulint i = 0; i < REC_SHARDS; i++) {
+		mutex_create(LATCH_ID_LOCK_SYS_REC_SHARD, &rec_shards[i].mutex);
+	}
 
 	mutex_create(LATCH_ID_LOCK_SYS_WAIT, &wait_mutex);
 
@@ -499,7 +504,7 @@ void lock_sys_t::resize(ulint n_cells)
 {
 	ut_ad(this == &lock_sys);
 
-	mutex_enter(&mutex);
+	lock_mutex_enter();
 
 	hash_table_t* old_hash = rec_hash;
 	rec_hash = hash_create(n_cells);
@@ -544,8 +549,19 @@ void lock_sys_t::resize(ulint n_cells)
 		buf_pool_mutex_exit(buf_pool);
 	}
 
-	mutex_exit(&mutex);
+	lock_mutex_exit();
+}
+
+#ifdef UNIV_DEBUG
+/** @return whether the current thread may access a rec_hash cell
+@param[in]	cell	rec_hash cell number */
+bool lock_sys_t::rec_cell_own(ulint cell)
+{
+	return rw_lock_own(&latch, RW_LOCK_X)
+		|| (rw_lock_own(&latch, RW_LOCK_S)
+		    && rec_shard_mutex(cell).is_owned());
 }
+#endif /* UNIV_DEBUG */
 
 
 /** Closes the lock system at database shutdown. */
@@ -566,7 +582,12 @@ void lock_sys_t::close()
 
 	os_event_destroy(timeout_event);
 
-	mutex_destroy(&mutex);
+	rw_lock_free(&latch);
+
+	for (ulint i = 0; i < REC_SHARDS; i++) {
+		mutex_destroy(&rec_shards[i].mutex);
+	}
+
 	mutex_destroy(&wait_mutex);
 
 	for (ulint i = srv_max_n_threads; i--; ) {
@@ -1368,7 +1389,9 @@ lock_rec_create_low(
 	ulint		n_bits;
 	ulint		n_bytes;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_mutex_own()
+	      || (!(type_mode & (LOCK_WAIT | LOCK_PREDICATE | LOCK_PRDT_PAGE))
+		  && lock_sys.rec_cell_own(lock_rec_hash(space, page_no))));
 	ut_ad(holds_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
@@ -1522,8 +1545,8 @@ lock_rec_create_low(
 	if (!holds_trx_mutex) {
 		trx_mutex_exit(trx);
 	}
-	MONITOR_INC(MONITOR_RECLOCK_CREATED);
-	MONITOR_INC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_CREATED);
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK);
 
 	return lock;
 }
@@ -1965,6 +1988,75 @@ static void lock_reuse_for_next_key_lock(const lock_t *held_lock, ulint mode,
     lock_rec_add_to_queue(LOCK_REC | mode, block, heap_no, index, trx, true);
 }
 
+/** Acquire the shared latch and the shard mutex covering a page.
+@param[in]	block	buffer block whose record lock queue is accessed
+@return rec_hash cell number of the page */
+ulint lock_sys_t::rec_shard_enter(const buf_block_t *block)
+{
+  rw_lock_s_lock(&latch);
+  const ulint cell= buf_block_get_lock_hash_val(block);
+  mutex_enter(&rec_shard_mutex(cell));
+  return cell;
+}
+
+/** Try to lock a record while holding only the shard of lock_sys.rec_hash
+that covers the page. This handles the most common cases: the page has no
+record locks, or the only lock on it was created by the same transaction
+in the same mode.
+@param[in]	impl	if true, no lock is set if no wait is necessary
+@param[in]	mode	lock mode: LOCK_X or LOCK_S possibly ORed to either
+			LOCK_GAP or LOCK_REC_NOT_GAP
+@param[in]	block	buffer block containing the record
+@param[in]	heap_no	heap number of record
+@param[in]	index	index of record
+@param[in,out]	trx	transaction
+@param[out]	err	DB_SUCCESS or DB_SUCCESS_LOCKED_REC
+@return whether the request was handled; if not, the caller must
+process it while holding the exclusive lock_sys.latch */
+static bool lock_rec_lock_try(bool impl, ulint mode, const buf_block_t *block,
+                              ulint heap_no, dict_index_t *index, trx_t *trx,
+                              dberr_t *err)
+{
+  bool done= true;
+  const ulint cell= lock_sys.rec_shard_enter(block);
+
+  if (lock_t *lock= lock_rec_get_first_on_page(lock_sys.rec_hash, block))
+  {
+    if (lock_rec_get_next_on_page(lock) ||
+        lock->trx != trx ||
+        lock->type_mode != (ulint(mode) | LOCK_REC) ||
+        lock_rec_get_n_bits(lock) <= heap_no)
+    {
+      /* Conflict checks and waiting require the exclusive latch. */
+      done= false;
+    }
+    else if (!impl)
+    {
+      trx_mutex_enter(trx);
+      if (!lock_rec_get_nth_bit(lock, heap_no))
+      {
+        lock_rec_set_nth_bit(lock, heap_no);
+        *err= DB_SUCCESS_LOCKED_REC;
+      }
+      trx_mutex_exit(trx);
+    }
+  }
+  else
+  {
+    if (!impl)
+      lock_rec_create(
+#ifdef WITH_WSREP
+         NULL, NULL,
+#endif
+        mode, block, heap_no, index, trx, false);
+
+    *err= DB_SUCCESS_LOCKED_REC;
+  }
+
+  lock_sys.rec_shard_exit(cell);
+  return done;
+}
+
 /*********************************************************************//**
 Tries to lock the specified record in the mode requested. If not immediately
 possible, enqueues a waiting lock request. This is a low-level function
@@ -2001,6 +2093,12 @@ lock_rec_lock(
   ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
   DBUG_EXECUTE_IF("innodb_report_deadlock", return DB_DEADLOCK;);
 
+  if (lock_rec_lock_try(impl, mode, block, heap_no, index, trx, &err))
+  {
+    MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
+    return err;
+  }
+
   lock_mutex_enter();
   ut_ad((LOCK_MODE_MASK & mode) != LOCK_S ||
         lock_table_has(trx, index->table, LOCK_IS));
@@ -4014,17 +4112,17 @@ lock_table(
 	return(err);
 }
 
-/*********************************************************************//**
-Creates a table IX lock object for a resurrected transaction. */
-void
-lock_table_ix_resurrect(
-/*====================*/
-	dict_table_t*	table,	/*!< in/out: table */
-	trx_t*		trx)	/*!< in/out: transaction */
+/** Create a table lock object for a resurrected transaction.
+@param[in,out]	table	table
+@param[in,out]	trx	recovered transaction
+@param[in]	mode	LOCK_IX, or LOCK_X if the transaction wrote
+			a TRX_UNDO_EMPTY record for the table */
+void lock_table_resurrect(dict_table_t* table, trx_t* trx, lock_mode mode)
 {
 	ut_ad(trx->is_recovered);
+	ut_ad(mode == LOCK_IX || mode == LOCK_X);
 
-	if (lock_table_has(trx, table, LOCK_IX)) {
+	if (lock_table_has(trx, table, mode)) {
 		return;
 	}
 
@@ -4034,10 +4132,10 @@ lock_table_ix_resurrect(
 	other transactions have in the table lock queue. */
 
 	ut_ad(!lock_table_other_has_incompatible(
-		      trx, LOCK_WAIT, table, LOCK_IX));
+		      trx, LOCK_WAIT, table, mode));
 
 	trx_mutex_enter(trx);
-	lock_table_create(table, LOCK_IX, trx);
+	lock_table_create(table, mode, trx);
 	lock_mutex_exit();
 	trx_mutex_exit(trx);
 }
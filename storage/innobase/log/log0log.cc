@@ -175,6 +175,8 @@ void log_buffer_extend(ulong len)
 		return;
 	}
 
+	log_sys.wait_for_copies();
+
 	ib::warn() << "The redo log transaction size " << len <<
 		" exceeds innodb_log_buffer_size="
 		<< srv_log_buffer_size << " / 2). Trying to extend it.";
@@ -330,40 +332,35 @@ log_reserve_and_open(
 	return(log_sys.lsn);
 }
 
-/************************************************************//**
-Writes to the log the string given. It is assumed that the caller holds the
-log mutex. */
-void
-log_write_low(
-/*==========*/
-	const byte*	str,		/*!< in: string */
-	ulint		str_len)	/*!< in: string length */
+/** Reserve space for a string in the log buffer and update the log block
+headers. The caller must hold log_sys.mutex and have invoked
+log_reserve_and_open().
+@param[in]	len	string length
+@return where to copy the string in log_sys.buf with log_t::copy() */
+ulint log_reserve_low(ulint len)
 {
-	ulint	len;
-
 	ut_ad(log_mutex_own());
+	const ulint offset = log_sys.buf_free;
 	const ulint trailer_offset = log_sys.trailer_offset();
 part_loop:
 	/* Calculate a part length */
 
-	ulint data_len = (log_sys.buf_free % OS_FILE_LOG_BLOCK_SIZE) + str_len;
+	ulint data_len = (log_sys.buf_free % OS_FILE_LOG_BLOCK_SIZE) + len;
+	ulint part_len;
 
 	if (data_len <= trailer_offset) {
 
 		/* The string fits within the current log block */
 
-		len = str_len;
+		part_len = len;
 	} else {
 		data_len = trailer_offset;
 
-		len = trailer_offset
+		part_len = trailer_offset
 			- log_sys.buf_free % OS_FILE_LOG_BLOCK_SIZE;
 	}
 
-	memcpy(log_sys.buf + log_sys.buf_free, str, len);
-
-	str_len -= len;
-	str = str + len;
+	len -= part_len;
 
 	byte* log_block = static_cast<byte*>(
 		ut_align_down(log_sys.buf + log_sys.buf_free,
@@ -376,26 +373,52 @@ log_write_low(
 		log_block_set_data_len(log_block, OS_FILE_LOG_BLOCK_SIZE);
 		log_block_set_checkpoint_no(log_block,
 					    log_sys.next_checkpoint_no);
-		len += log_sys.framing_size();
+		part_len += log_sys.framing_size();
 
-		log_sys.lsn += len;
+		log_sys.lsn += part_len;
 
 		/* Initialize the next block header */
 		log_block_init(log_block + OS_FILE_LOG_BLOCK_SIZE,
 			       log_sys.lsn);
 	} else {
-		log_sys.lsn += len;
+		log_sys.lsn += part_len;
 	}
 
-	log_sys.buf_free += ulong(len);
+	log_sys.buf_free += ulong(part_len);
 
 	ut_ad(log_sys.buf_free <= srv_log_buffer_size);
 
-	if (str_len > 0) {
+	if (len > 0) {
 		goto part_loop;
 	}
 
 	srv_stats.log_write_requests.inc();
+	return(offset);
+}
+
+/************************************************************//**
+Writes to the log the string given. It is assumed that the caller holds the
+log mutex. */
+void
+log_write_low(
+/*==========*/
+	const byte*	str,		/*!< in: string */
+	ulint		str_len)	/*!< in: string length */
+{
+	ut_ad(log_mutex_own());
+	log_sys.copy(log_reserve_low(str_len), str, str_len);
+}
+
+/** Wait until all reserved log records have been copied to buf.
+The caller must hold mutex, so that no new space can be reserved. */
+void log_t::wait_for_copies() const
+{
+	ut_ad(log_mutex_own());
+
+	while (n_pending_copies.load(std::memory_order_acquire)) {
+		/* The copying threads do not wait for anything. */
+		os_thread_yield();
+	}
 }
 
 /************************************************************//**
@@ -582,6 +605,7 @@ void log_t::create()
   log_block_set_first_rec_group(buf, LOG_BLOCK_HDR_SIZE);
 
   buf_free= LOG_BLOCK_HDR_SIZE;
+  n_pending_copies= 0;
   lsn= LOG_START_LSN + LOG_BLOCK_HDR_SIZE;
 
   MONITOR_SET(MONITOR_LSN_CHECKPOINT_AGE, lsn - last_checkpoint_lsn);
@@ -824,6 +848,7 @@ log_buffer_switch()
 {
 	ut_ad(log_mutex_own());
 	ut_ad(log_write_mutex_own());
+	ut_ad(!log_sys.n_pending_copies);
 
 	ulong		area_end = ut_calc_align(
 		log_sys.buf_free, ulong(OS_FILE_LOG_BLOCK_SIZE));
@@ -916,6 +941,7 @@ void log_write_up_to(lsn_t lsn, bool flush_to_disk, bool rotate_key)
 	}
 
 	log_mutex_enter();
+	log_sys.wait_for_copies();
 	if (!flush_to_disk
 	    && log_sys.buf_free == log_sys.buf_next_to_write) {
 		/* Nothing to write and no flush to disk requested */
@@ -1053,6 +1079,8 @@ ATTRIBUTE_COLD void log_write_and_flush()
   ut_ad(!recv_no_log_write);
   ut_ad(!recv_recovery_is_on());
 
+  log_sys.wait_for_copies();
+
   /* The following code is adapted from log_write_up_to(). */
   DBUG_PRINT("ib_log", ("write " LSN_PF " to " LSN_PF,
                         log_sys.write_lsn, log_sys.lsn));
@@ -112,6 +112,7 @@ static lsn_t	recv_max_page_lsn;
 #ifdef UNIV_PFS_THREAD
 mysql_pfs_key_t	trx_rollback_clean_thread_key;
 mysql_pfs_key_t	recv_writer_thread_key;
+mysql_pfs_key_t	recv_apply_thread_key;
 #endif /* UNIV_PFS_THREAD */
 
 /** Is recv_writer_thread active? */
@@ -2286,6 +2287,112 @@ buf_block_t* recv_recovery_create_page_low(const page_id_t page_id)
   return block;
 }
 
+/** Maximum number of threads applying redo log in one batch */
+static const ulint RECV_APPLY_MAX_THREADS = 64;
+
+/** Parameters of a redo log apply thread */
+struct recv_apply_t {
+	/** the first recv_sys.addr_hash cell to process */
+	ulint		first;
+	/** number of apply threads, and the stride between cells */
+	ulint		n_threads;
+	/** the thread */
+	os_thread_id_t	thread_id;
+};
+
+/** Apply the buffered redo log to the pages in a subset of
+recv_sys.addr_hash. Pages that are not in the buffer pool are read in
+asynchronously, and the log will be applied to them in the I/O handler
+threads on read completion.
+@param[in]	first		first hash cell to process
+@param[in]	n_threads	stride between the processed hash cells */
+static void recv_apply_cells(ulint first, ulint n_threads)
+{
+	ut_ad(mutex_own(&recv_sys.mutex));
+	ut_ad(recv_sys.apply_batch_on);
+
+	mtr_t mtr;
+
+	for (ulint i = first; i < hash_get_n_cells(recv_sys.addr_hash);
+	     i += n_threads) {
+		for (recv_addr_t* recv_addr = static_cast<recv_addr_t*>(
+			     HASH_GET_FIRST(recv_sys.addr_hash, i));
+		     recv_addr;
+		     recv_addr = static_cast<recv_addr_t*>(
+				HASH_GET_NEXT(addr_hash, recv_addr))) {
+			if (!UT_LIST_GET_LEN(recv_addr->rec_list)) {
+ignore:
+				ut_a(recv_sys.n_addrs);
+				recv_sys.n_addrs--;
+				continue;
+			}
+
+			switch (recv_addr->state) {
+			case RECV_BEING_READ:
+			case RECV_BEING_PROCESSED:
+			case RECV_PROCESSED:
+				continue;
+			case RECV_DISCARDED:
+				goto ignore;
+			case RECV_NOT_PROCESSED:
+			case RECV_WILL_NOT_READ:
+				break;
+			}
+
+			const page_id_t page_id(recv_addr->space,
+						recv_addr->page_no);
+
+			if (recv_addr->state == RECV_NOT_PROCESSED) {
+apply:
+				mtr.start();
+				mtr.set_log_mode(MTR_LOG_NONE);
+				if (buf_block_t* block = buf_page_get_low(
+					    page_id, 0, RW_X_LATCH, NULL,
+					    BUF_GET_IF_IN_POOL,
+					    __FILE__, __LINE__, &mtr, NULL)) {
+					buf_block_dbg_add_level(
+						block, SYNC_NO_ORDER_CHECK);
+					recv_recover_page(block, mtr,
+							  recv_addr);
+					ut_ad(mtr.has_committed());
+				} else {
+					mtr.commit();
+					recv_read_in_area(page_id);
+				}
+			} else if (!recv_recovery_create_page_low(
+					page_id, recv_addr)) {
+				goto apply;
+			}
+		}
+	}
+}
+
+/** Thread that applies the buffered redo log to a subset of
+recv_sys.addr_hash.
+@param[in]	arg	recv_apply_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(recv_apply_thread)(void* arg)
+{
+	my_thread_init();
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(recv_apply_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	const recv_apply_t* apply = static_cast<const recv_apply_t*>(arg);
+
+	mutex_enter(&recv_sys.mutex);
+	recv_apply_cells(apply->first, apply->n_threads);
+	mutex_exit(&recv_sys.mutex);
+
+	my_thread_end();
+	/* recv_apply_hashed_log_recs() will join this thread. */
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /** Apply the hash table of stored log records to persistent data pages.
 @param[in]	last_batch	whether the change buffer merge will be
 				performed as part of the operation */
@@ -2343,58 +2450,33 @@ void recv_apply_hashed_log_recs(bool last_batch)
 		}
 	}
 
-	mtr_t mtr;
-
-	for (ulint i = 0; i < hash_get_n_cells(recv_sys.addr_hash); i++) {
-		for (recv_addr_t* recv_addr = static_cast<recv_addr_t*>(
-			     HASH_GET_FIRST(recv_sys.addr_hash, i));
-		     recv_addr;
-		     recv_addr = static_cast<recv_addr_t*>(
-				HASH_GET_NEXT(addr_hash, recv_addr))) {
-			if (!UT_LIST_GET_LEN(recv_addr->rec_list)) {
-ignore:
-				ut_a(recv_sys.n_addrs);
-				recv_sys.n_addrs--;
-				continue;
-			}
+	ulint n_threads = ut_min(ulint(srv_n_recovery_threads),
+				 ulint(RECV_APPLY_MAX_THREADS));
+	recv_apply_t apply[RECV_APPLY_MAX_THREADS];
+
+	if (n_threads > 1 && recv_sys.n_addrs) {
+		/* The threads will start processing their hash cells
+		once we release recv_sys.mutex. */
+		for (ulint i = 1; i < n_threads; i++) {
+			apply[i].first = i;
+			apply[i].n_threads = n_threads;
+			os_thread_create(recv_apply_thread, &apply[i],
+					 &apply[i].thread_id);
+		}
+	} else {
+		n_threads = 1;
+	}
 
-			switch (recv_addr->state) {
-			case RECV_BEING_READ:
-			case RECV_BEING_PROCESSED:
-			case RECV_PROCESSED:
-				continue;
-			case RECV_DISCARDED:
-				goto ignore;
-			case RECV_NOT_PROCESSED:
-			case RECV_WILL_NOT_READ:
-				break;
-			}
+	recv_apply_cells(0, n_threads);
 
-			const page_id_t page_id(recv_addr->space,
-						recv_addr->page_no);
+	if (n_threads > 1) {
+		mutex_exit(&recv_sys.mutex);
 
-			if (recv_addr->state == RECV_NOT_PROCESSED) {
-apply:
-				mtr.start();
-				mtr.set_log_mode(MTR_LOG_NONE);
-				if (buf_block_t* block = buf_page_get_low(
-					    page_id, 0, RW_X_LATCH, NULL,
-					    BUF_GET_IF_IN_POOL,
-					    __FILE__, __LINE__, &mtr, NULL)) {
-					buf_block_dbg_add_level(
-						block, SYNC_NO_ORDER_CHECK);
-					recv_recover_page(block, mtr,
-							  recv_addr);
-					ut_ad(mtr.has_committed());
-				} else {
-					mtr.commit();
-					recv_read_in_area(page_id);
-				}
-			} else if (!recv_recovery_create_page_low(
-					page_id, recv_addr)) {
-				goto apply;
-			}
+		for (ulint i = 1; i < n_threads; i++) {
+			os_thread_join(apply[i].thread_id);
 		}
+
+		mutex_enter(&recv_sys.mutex);
 	}
 
 	/* Wait until all the pages have been processed */
@@ -2448,6 +2530,7 @@ void recv_apply_hashed_log_recs(bool last_batch)
 		mlog_init.reset();
 	} else if (!recv_no_ibuf_operations) {
 		/* We skipped this in buf_page_create(). */
+		mtr_t mtr;
 		mlog_init.ibuf_merge(mtr);
 	}
 
@@ -370,6 +370,20 @@ struct mtr_write_log_t {
 	}
 };
 
+/** Copy the blocks to space that was reserved in the redo log buffer */
+struct mtr_copy_log_t {
+	/** offset in log_sys.buf */
+	ulint	offset;
+
+	/** Copy a block to the redo log buffer.
+	@return whether the copying should continue */
+	bool operator()(const mtr_buf_t::block_t* block)
+	{
+		offset = log_sys.copy(offset, block->begin(), block->used());
+		return(true);
+	}
+};
+
 /** Append records to the system-wide redo log buffer.
 @param[in]	log	redo log records */
 void
@@ -435,8 +449,9 @@ mtr_t::commit()
     ut_ad(!srv_read_only_mode || m_log_mode == MTR_LOG_NO_REDO);
 
     lsn_t start_lsn;
+    const ulint len= prepare_write();
 
-    if (const ulint len= prepare_write())
+    if (len)
       start_lsn= finish_write(len);
     else
       start_lsn= m_commit_lsn;
@@ -455,6 +470,11 @@ mtr_t::commit()
     if (m_made_dirty)
       log_flush_order_mutex_exit();
 
+    /* The pages remain latched until the log records have been copied,
+    and log_write_up_to() will wait for the copying to finish. */
+    if (len)
+      copy_log();
+
     m_memo.for_each_block_in_reverse(CIterate<ReleaseLatches>());
   }
   else
@@ -519,6 +539,7 @@ void mtr_t::commit_shrink(fil_space_t &space)
   log_write_and_flush_prepare();
 
   const lsn_t start_lsn= finish_write(prepare_write());
+  copy_log();
 
   log_flush_order_mutex_enter();
   /* Durably write the reduced FSP_SIZE before truncating the data file. */
@@ -586,6 +607,7 @@ mtr_t::commit_checkpoint(
 	}
 
 	finish_write(m_log.size());
+	copy_log();
 	release_resources();
 
 	if (write_mlog_checkpoint) {
@@ -800,24 +822,32 @@ inline lsn_t mtr_t::finish_write(ulint len)
 		const mtr_buf_t::block_t* front = m_log.front();
 		ut_ad(len <= front->used());
 
-		m_commit_lsn = log_reserve_and_write_fast(front->begin(), len,
-							  &start_lsn);
-
-		if (m_commit_lsn) {
-			return start_lsn;
-		}
+		m_commit_lsn = log_reserve_fast(front->begin(), len,
+						&start_lsn, &m_log_offset);
+	} else {
+		m_commit_lsn = 0;
 	}
 
-	/* Open the database log for log_write_low */
-	start_lsn = log_reserve_and_open(len);
-
-	mtr_write_log_t	write_log;
-	m_log.for_each_block(write_log);
+	if (!m_commit_lsn) {
+		/* Open the database log for log_reserve_low */
+		start_lsn = log_reserve_and_open(len);
+		m_log_offset = log_reserve_low(len);
+		m_commit_lsn = log_close();
+	}
 
-	m_commit_lsn = log_close();
+	log_sys.n_pending_copies.fetch_add(1, std::memory_order_relaxed);
 	return start_lsn;
 }
 
+/** Copy the redo log records to the space reserved by finish_write().
+This does not require log_sys.mutex. */
+inline void mtr_t::copy_log()
+{
+	mtr_copy_log_t	copy_log = { m_log_offset };
+	m_log.for_each_block(copy_log);
+	log_sys.copy_done();
+}
+
 /** Find out whether a block was not X-latched by the mini-transaction */
 struct FindBlockX
 {
@@ -54,9 +54,11 @@ Created 10/21/1995 Heikki Tuuri
 
 #include <vector>
 
-#ifdef LINUX_NATIVE_AIO
+#ifdef LINUX_URING_AIO
+#include <liburing.h>
+#elif defined(LINUX_NATIVE_AIO)
 #include <libaio.h>
-#endif /* LINUX_NATIVE_AIO */
+#endif /* LINUX_URING_AIO */
 
 #ifdef HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE
 # include <fcntl.h>
@@ -242,8 +244,13 @@ struct Slot {
 	/** aio array containing this slot */
 	AIO				*array;
 #elif defined(LINUX_NATIVE_AIO)
+# ifdef LINUX_URING_AIO
+	/** I/O vector of the io_uring request */
+	struct iovec		iov;
+# else
 	/** Linux control block for aio */
 	struct iocb		control;
+# endif /* LINUX_URING_AIO */
 
 	/** AIO return code */
 	int			ret;
@@ -389,6 +396,37 @@ class AIO {
 	bool linux_dispatch(Slot* slot)
 		MY_ATTRIBUTE((warn_unused_result));
 
+# ifdef LINUX_URING_AIO
+	/** Accessor for the io_uring of a segment
+	@param[in]	segment	Segment for which to get the ring
+	@return the io_uring of the segment */
+	io_uring* ring(ulint segment)
+		MY_ATTRIBUTE((warn_unused_result))
+	{
+		ut_ad(segment < m_rings.size());
+
+		return(&m_rings[segment]);
+	}
+
+	/** Queue a request on the io_uring of its segment without
+	submitting it. The caller must own the mutex.
+	@param[in,out]	slot	an already reserved slot */
+	void uring_prep(Slot* slot);
+
+	/** Submit the queued requests of a segment to the kernel.
+	The caller must own the mutex, which is released while waiting
+	for the kernel to accept the requests if it is short of resources.
+	@param[in]	segment	local segment */
+	void uring_submit(ulint segment);
+
+	/** Submit the requests that were queued with
+	IORequest::DO_NOT_WAKE in all the AIO arrays. */
+	static void uring_submit_all();
+
+	/** Wake up the I/O handler threads at shutdown by posting
+	a no-op request to each io_uring. */
+	static void wake_at_shutdown();
+# else
 	/** Accessor for an AIO event
 	@param[in]	index	Index into the array
 	@return the event at the index */
@@ -417,6 +455,7 @@ class AIO {
 	@return true on success. */
 	static bool linux_create_io_ctx(unsigned max_events, io_context_t& io_ctx)
 		MY_ATTRIBUTE((warn_unused_result));
+# endif /* LINUX_URING_AIO */
 
 	/** Checks if the system supports native linux aio. On some kernel
 	versions where native aio is supported it won't work on tmpfs. In such
@@ -607,7 +646,17 @@ class AIO {
 	ulint			m_n_reserved;
 
 
-#if defined(LINUX_NATIVE_AIO)
+#ifdef LINUX_URING_AIO
+	/** Submission and completion queues for IO. There is one
+	io_uring per segment. Requests are queued and submitted while
+	holding m_mutex; the completions are reaped only by the
+	I/O handler thread of the segment. */
+	std::vector<io_uring>	m_rings;
+
+	/** Number of requests per segment that have been queued
+	but not submitted yet; protected by m_mutex */
+	std::vector<ulint>	m_uring_pending;
+#elif defined(LINUX_NATIVE_AIO)
 	typedef std::vector<io_event> IOEvents;
 
 	/** completion queue for IO. There is one such queue per
@@ -647,7 +696,7 @@ AIO*	AIO::s_ibuf;
 AIO*	AIO::s_log;
 AIO*	AIO::s_sync;
 
-#if defined(LINUX_NATIVE_AIO)
+#if defined(LINUX_NATIVE_AIO) && !defined(LINUX_URING_AIO)
 /** timeout for each io_getevents() call = 500ms. */
 static const ulint	OS_AIO_REAP_TIMEOUT = 500000000UL;
 
@@ -1082,7 +1131,9 @@ AIO::release(Slot* slot)
 #if defined(LINUX_NATIVE_AIO)
 
 	if (srv_use_native_aio) {
+# ifndef LINUX_URING_AIO
 		memset(&slot->control, 0x0, sizeof(slot->control));
+# endif /* !LINUX_URING_AIO */
 		slot->ret = 0;
 		slot->n_bytes = 0;
 	} else {
@@ -1641,6 +1692,12 @@ LinuxAIOHandler::resubmit(Slot* slot)
 
 	compile_time_assert(sizeof(off_t) >= sizeof(os_offset_t));
 
+#ifdef LINUX_URING_AIO
+	m_array->uring_prep(slot);
+	m_array->uring_submit(m_segment);
+
+	return(DB_SUCCESS);
+#else
 	struct iocb*	iocb = &slot->control;
 
 	if (slot->type.is_read()) {
@@ -1677,6 +1734,7 @@ LinuxAIOHandler::resubmit(Slot* slot)
 	}
 
 	return(ret < 0 ? DB_IO_PARTIAL_FAILED : DB_SUCCESS);
+#endif /* LINUX_URING_AIO */
 }
 
 /** Check if the AIO succeeded
@@ -1756,6 +1814,109 @@ LinuxAIOHandler::find_completed_slot(ulint* n_pending)
 	return(NULL);
 }
 
+#ifdef LINUX_URING_AIO
+/** This function is only used with io_uring. This is called from within
+the io-thread. If there are no completed IO requests in the slot array,
+the thread calls this function to submit the requests that were queued
+with IORequest::DO_NOT_WAKE and to wait for completions from the kernel.
+The io-thread is woken up at shutdown by a no-op request posted by
+AIO::wake_at_shutdown(). */
+void
+LinuxAIOHandler::collect()
+{
+	ut_ad(m_n_slots > 0);
+	ut_ad(m_array != NULL);
+	ut_ad(m_segment < m_array->get_n_segments());
+
+	io_uring*	ring = m_array->ring(m_segment);
+
+	/* Starting point of the m_segment we will be working on. */
+	ulint	start_pos = m_segment * m_n_slots;
+
+	/* End point. */
+	ulint	end_pos = start_pos + m_n_slots;
+
+	m_array->acquire();
+	m_array->uring_submit(m_segment);
+	m_array->release();
+
+	struct io_uring_cqe*	cqe;
+
+	int	ret = io_uring_wait_cqe(ring, &cqe);
+
+	switch (ret) {
+	case 0:
+		break;
+	case -EINTR:
+		return;
+	default:
+		ib::fatal()
+			<< "Unexpected ret_code[" << ret
+			<< "] from io_uring_wait_cqe()!";
+	}
+
+	unsigned	head;
+	unsigned	n_reaped = 0;
+
+	io_uring_for_each_cqe(ring, head, cqe) {
+
+		++n_reaped;
+
+		Slot*	slot = static_cast<Slot*>(io_uring_cqe_get_data(cqe));
+
+		if (slot == NULL) {
+			/* A no-op request posted at shutdown */
+			continue;
+		}
+
+		/* Some sanity checks. */
+		ut_a(slot->is_reserved);
+
+		/* We are not scribbling previous segment. */
+		ut_a(slot->pos >= start_pos);
+
+		/* We have not overstepped to next segment. */
+		ut_a(slot->pos < end_pos);
+
+		/* Deallocate unused blocks from file system.
+		This is newer done to page 0 or to log files.*/
+		if (slot->offset > 0
+		    && !slot->type.is_log()
+		    && slot->type.is_write()
+		    && slot->type.punch_hole()) {
+
+			slot->err = slot->type.punch_hole(
+				slot->file,
+				slot->offset, slot->len);
+		} else {
+			slot->err = DB_SUCCESS;
+		}
+
+		/* Mark this request as completed. The error handling
+		will be done in the calling function. */
+		m_array->acquire();
+
+		slot->io_already_done = true;
+
+		/* cqe->res is the number of bytes read or written,
+		or a negated errno value. */
+
+		if (cqe->res < 0) {
+			/* failure */
+			slot->n_bytes = 0;
+			slot->ret = cqe->res;
+		} else {
+			/* success */
+			slot->n_bytes = cqe->res;
+			slot->ret = 0;
+		}
+
+		m_array->release();
+	}
+
+	io_uring_cq_advance(ring, n_reaped);
+}
+#else
 /** This function is only used in Linux native asynchronous i/o. This is
 called from within the io-thread. If there are no completed IO requests
 in the slot array, the thread calls this function to collect more
@@ -1898,6 +2059,7 @@ LinuxAIOHandler::collect()
 		break;
 	}
 }
+#endif /* LINUX_URING_AIO */
 
 /** Process a Linux AIO request
 @param[out]	m1		the messages passed with the
@@ -2018,6 +2180,194 @@ os_aio_linux_handler(
 	return LinuxAIOHandler(global_segment).poll(m1, m2, request);
 }
 
+#ifdef LINUX_URING_AIO
+/** Queue a request on the io_uring of its segment without submitting it.
+@param[in,out]	slot		an already reserved slot */
+void
+AIO::uring_prep(Slot* slot)
+{
+	ut_ad(is_mutex_owned());
+	ut_a(slot->is_reserved);
+	ut_ad(slot->type.validate());
+
+	ut_a(reinterpret_cast<size_t>(slot->ptr) % OS_FILE_LOG_BLOCK_SIZE
+	     == 0);
+
+	ulint	segment = (slot->pos * m_n_segments) / m_slots.size();
+
+	/* Each io_uring has a submission queue entry for every slot
+	of its segment, and a slot is queued at most once. */
+	struct io_uring_sqe*	sqe = io_uring_get_sqe(ring(segment));
+	ut_a(sqe != NULL);
+
+	slot->iov.iov_base = slot->ptr;
+	slot->iov.iov_len = slot->len;
+
+	if (slot->type.is_read()) {
+		io_uring_prep_readv(
+			sqe, slot->file, &slot->iov, 1, slot->offset);
+	} else {
+		ut_ad(slot->type.is_write());
+
+		io_uring_prep_writev(
+			sqe, slot->file, &slot->iov, 1, slot->offset);
+	}
+
+	io_uring_sqe_set_data(sqe, slot);
+
+	++m_uring_pending[segment];
+}
+
+/** Submit the queued requests of a segment to the kernel.
+@param[in]	segment		local segment */
+void
+AIO::uring_submit(ulint segment)
+{
+	ut_ad(is_mutex_owned());
+
+	while (ulint n = m_uring_pending[segment]) {
+
+		int	ret = io_uring_submit(ring(segment));
+
+		if (ret > 0) {
+			m_uring_pending[segment] = ulint(ret) >= n
+				? 0 : n - ret;
+			continue;
+		}
+
+		switch (ret) {
+		case 0:
+		case -EAGAIN:
+		case -EBUSY:
+		case -EINTR:
+			/* The kernel is short of resources. The queued
+			requests stay in the ring; let the I/O handler
+			threads make progress and try again. */
+			release();
+			os_thread_yield();
+			acquire();
+			continue;
+		}
+
+		ib::fatal()
+			<< "Unexpected ret_code[" << ret
+			<< "] from io_uring_submit()!";
+	}
+}
+
+/** Submit the requests that were queued with IORequest::DO_NOT_WAKE
+in all the AIO arrays. */
+void
+AIO::uring_submit_all()
+{
+	AIO*	arrays[] = { s_ibuf, s_log, s_reads, s_writes };
+
+	for (ulint i = 0; i < array_elements(arrays); ++i) {
+		AIO*	array = arrays[i];
+
+		if (array == NULL) {
+			continue;
+		}
+
+		array->acquire();
+
+		for (ulint segment = 0; segment < array->m_rings.size();
+		     ++segment) {
+			array->uring_submit(segment);
+		}
+
+		array->release();
+	}
+}
+
+/** Wake up the I/O handler threads at shutdown by posting a no-op
+request to each io_uring. */
+void
+AIO::wake_at_shutdown()
+{
+	AIO*	arrays[] = { s_ibuf, s_log, s_reads, s_writes };
+
+	for (ulint i = 0; i < array_elements(arrays); ++i) {
+		AIO*	array = arrays[i];
+
+		if (array == NULL) {
+			continue;
+		}
+
+		array->acquire();
+
+		for (ulint segment = 0; segment < array->m_rings.size();
+		     ++segment) {
+
+			io_uring*		r = array->ring(segment);
+			struct io_uring_sqe*	sqe = io_uring_get_sqe(r);
+
+			if (sqe != NULL) {
+				io_uring_prep_nop(sqe);
+				io_uring_sqe_set_data(sqe, NULL);
+
+				/* The handler thread may have exited
+				already; do not wait for the kernel. */
+				io_uring_submit(r);
+			}
+		}
+
+		array->release();
+	}
+}
+
+/** Dispatch an AIO request to the kernel. Requests that were issued
+with IORequest::DO_NOT_WAKE are only queued; they will be submitted in
+a batch by os_aio_simulated_wake_handler_threads() or by the I/O
+handler thread of the segment.
+@param[in,out]	slot		an already reserved slot
+@return true on success. */
+bool
+AIO::linux_dispatch(Slot* slot)
+{
+	ut_a(slot->is_reserved);
+	ut_ad(slot->type.validate());
+
+	ulint	segment = (slot->pos * m_n_segments) / m_slots.size();
+	bool	submit = slot->type.is_wake();
+
+	acquire();
+
+	uring_prep(slot);
+
+	if (submit) {
+		uring_submit(segment);
+	}
+
+	release();
+
+	return(true);
+}
+
+/** Checks if the system supports io_uring. Unlike libaio, io_uring
+works on any file system, so it is enough to be able to create a ring.
+@return: true if supported, false otherwise. */
+bool
+AIO::is_linux_native_aio_supported()
+{
+	io_uring	ring;
+
+	int	ret = io_uring_queue_init(1, &ring, 0);
+
+	if (ret != 0) {
+		ib::warn()
+			<< "io_uring_queue_init() returned error["
+			<< -ret << "]. You can disable Linux Native AIO by"
+			" setting innodb_use_native_aio = 0 in my.cnf";
+
+		return(false);
+	}
+
+	io_uring_queue_exit(&ring);
+
+	return(true);
+}
+#else
 /** Dispatch an AIO request to the kernel.
 @param[in,out]	slot		an already reserved slot
 @return true on success. */
@@ -2279,6 +2629,7 @@ AIO::is_linux_native_aio_supported()
 
 	return(false);
 }
+#endif /* LINUX_URING_AIO */
 
 #endif /* LINUX_NATIVE_AIO */
 
@@ -5342,9 +5693,9 @@ AIO::AIO(
 	m_slots(n),
 	m_n_segments(segments),
 	m_n_reserved()
-# ifdef LINUX_NATIVE_AIO
+# if defined LINUX_NATIVE_AIO && !defined LINUX_URING_AIO
 	,m_events(m_slots.size())
-# endif /* LINUX_NATIVE_AIO */
+# endif /* LINUX_NATIVE_AIO && !LINUX_URING_AIO */
 #ifdef WIN_ASYNC_IO
 	,m_completion_port(new_completion_port())
 #endif
@@ -5358,9 +5709,9 @@ AIO::AIO(
 	m_is_empty = os_event_create("aio_is_empty");
 
 	memset((void*)&m_slots[0], 0x0, sizeof(m_slots[0]) * m_slots.size());
-#ifdef LINUX_NATIVE_AIO
+#if defined LINUX_NATIVE_AIO && !defined LINUX_URING_AIO
 	memset(&m_events[0], 0x0, sizeof(m_events[0]) * m_events.size());
-#endif /* LINUX_NATIVE_AIO */
+#endif /* LINUX_NATIVE_AIO && !LINUX_URING_AIO */
 
 	os_event_set(m_is_empty);
 }
@@ -5386,7 +5737,9 @@ AIO::init_slots()
 
 		slot.n_bytes = 0;
 
+# ifndef LINUX_URING_AIO
 		memset(&slot.control, 0x0, sizeof(slot.control));
+# endif /* !LINUX_URING_AIO */
 
 #endif /* WIN_ASYNC_IO */
 	}
@@ -5394,7 +5747,47 @@ AIO::init_slots()
 	return(DB_SUCCESS);
 }
 
-#ifdef LINUX_NATIVE_AIO
+#ifdef LINUX_URING_AIO
+/** Initialise the io_uring interface */
+dberr_t
+AIO::init_linux_native_aio()
+{
+	/* One io_uring per segment in the array. */
+	m_rings.resize(get_n_segments());
+	m_uring_pending.resize(get_n_segments());
+
+	unsigned	entries = unsigned(slots_per_segment());
+
+	for (ulint i = 0; i < m_rings.size(); ++i) {
+
+		int	ret = io_uring_queue_init(entries, &m_rings[i], 0);
+
+		if (ret == 0) {
+			continue;
+		}
+
+		/* io_uring_queue_init() may fail with ENOMEM if
+		RLIMIT_MEMLOCK is too small for the rings. */
+		ib::warn()
+			<< "Linux Native AIO disabled because"
+			" io_uring_queue_init() returned error["
+			<< -ret << "]. To get rid of this warning you can"
+			" try increasing RLIMIT_MEMLOCK or setting"
+			" innodb_use_native_aio = 0 in my.cnf";
+
+		while (i--) {
+			io_uring_queue_exit(&m_rings[i]);
+		}
+
+		m_rings.clear();
+		m_uring_pending.clear();
+		srv_use_native_aio = FALSE;
+		return(DB_SUCCESS);
+	}
+
+	return(DB_SUCCESS);
+}
+#elif defined(LINUX_NATIVE_AIO)
 /** Initialise the Linux Native AIO interface */
 dberr_t
 AIO::init_linux_native_aio()
@@ -5506,7 +5899,11 @@ AIO::~AIO()
 	os_event_destroy(m_not_full);
 	os_event_destroy(m_is_empty);
 
-#if defined(LINUX_NATIVE_AIO)
+#ifdef LINUX_URING_AIO
+	for (ulint i = 0; i < m_rings.size(); i++) {
+		io_uring_queue_exit(&m_rings[i]);
+	}
+#elif defined(LINUX_NATIVE_AIO)
 	if (srv_use_native_aio) {
 		for (ulint i = 0; i < m_aio_ctx.size(); i++) {
 			int ret = io_destroy(m_aio_ctx[i]);
@@ -5718,6 +6115,12 @@ os_aio_wake_all_threads_at_shutdown()
 {
 #ifdef WIN_ASYNC_IO
 	AIO::wake_at_shutdown();
+#elif defined(LINUX_URING_AIO)
+	/* The io helper threads wait on io_uring_wait_cqe() without
+	a timeout. Post a no-op request to wake them up. */
+	if (srv_use_native_aio) {
+		AIO::wake_at_shutdown();
+	}
 #elif defined(LINUX_NATIVE_AIO)
 	/* When using native AIO interface the io helper threads
 	wait on io_getevents with a timeout value of 500ms. At
@@ -5842,12 +6245,11 @@ AIO::reserve_slot(
 
 		release();
 
-		if (!srv_use_native_aio) {
-			/* If the handler threads are suspended,
-			wake them so that we get more slots */
+		/* If the handler threads are suspended, or requests
+		are waiting to be submitted to io_uring, wake them so
+		that we get more slots */
 
-			os_aio_simulated_wake_handler_threads();
-		}
+		os_aio_simulated_wake_handler_threads();
 
 		os_event_wait(m_not_full);
 	}
@@ -5914,7 +6316,7 @@ AIO::reserve_slot(
 		control->Offset = (DWORD) offset & 0xFFFFFFFF;
 		control->OffsetHigh = (DWORD) (offset >> 32);
 	}
-#elif defined(LINUX_NATIVE_AIO)
+#elif defined(LINUX_NATIVE_AIO) && !defined(LINUX_URING_AIO)
 
 	/* If we are not using native AIO skip this part. */
 	if (srv_use_native_aio) {
@@ -6005,11 +6407,16 @@ AIO::wake_simulated_handler_thread(ulint global_segment, ulint segment)
 	release();
 }
 
-/** Wakes up simulated aio i/o-handler threads if they have something to do. */
+/** Wakes up simulated aio i/o-handler threads if they have something to do.
+With io_uring, submits the requests that were queued with
+IORequest::DO_NOT_WAKE. */
 void
 os_aio_simulated_wake_handler_threads()
 {
 	if (srv_use_native_aio) {
+#ifdef LINUX_URING_AIO
+		AIO::uring_submit_all();
+#endif /* LINUX_URING_AIO */
 		/* We do not use simulated aio: do nothing */
 
 		return;
@@ -374,6 +374,12 @@ page_cur_search_with_match(
 	up_matched_fields  = *iup_matched_fields;
 	low_matched_fields = *ilow_matched_fields;
 
+	/* For fixed-length keys, such as most PRIMARY KEYs, compare
+	the bytes at the start of each record directly. */
+	cmp_normalized_key_t	key;
+	const bool		normalized = key.init(tuple, index);
+	const bool		comp = page_is_comp(page);
+
 	/* Perform binary search. First the search is done through the page
 	directory, after that as a linear search in the list of records
 	owned by the upper limit directory slot. */
@@ -392,13 +398,17 @@ page_cur_search_with_match(
 		cur_matched_fields = std::min(low_matched_fields,
 					      up_matched_fields);
 
-		offsets = offsets_;
-		offsets = rec_get_offsets(
-			mid_rec, index, offsets, n_core,
-			dtuple_get_n_fields_cmp(tuple), &heap);
+		if (normalized) {
+			cmp = key.cmp(mid_rec, comp, &cur_matched_fields);
+		} else {
+			offsets = offsets_;
+			offsets = rec_get_offsets(
+				mid_rec, index, offsets, n_core,
+				dtuple_get_n_fields_cmp(tuple), &heap);
 
-		cmp = cmp_dtuple_rec_with_match(
-			tuple, mid_rec, offsets, &cur_matched_fields);
+			cmp = cmp_dtuple_rec_with_match(
+				tuple, mid_rec, offsets, &cur_matched_fields);
+		}
 
 		if (cmp > 0) {
 low_slot_match:
@@ -446,13 +456,17 @@ page_cur_search_with_match(
 		cur_matched_fields = std::min(low_matched_fields,
 					      up_matched_fields);
 
-		offsets = offsets_;
-		offsets = rec_get_offsets(
-			mid_rec, index, offsets, n_core,
-			dtuple_get_n_fields_cmp(tuple), &heap);
+		if (normalized) {
+			cmp = key.cmp(mid_rec, comp, &cur_matched_fields);
+		} else {
+			offsets = offsets_;
+			offsets = rec_get_offsets(
+				mid_rec, index, offsets, n_core,
+				dtuple_get_n_fields_cmp(tuple), &heap);
 
-		cmp = cmp_dtuple_rec_with_match(
-			tuple, mid_rec, offsets, &cur_matched_fields);
+			cmp = cmp_dtuple_rec_with_match(
+				tuple, mid_rec, offsets, &cur_matched_fields);
+		}
 
 		if (cmp > 0) {
 low_rec_match:
@@ -485,7 +499,7 @@ page_cur_search_with_match(
 				/* We got a match, but cur_matched_fields is
 				0, it must have REC_INFO_MIN_REC_FLAG */
 				ulint   rec_info = rec_get_info_bits(mid_rec,
-                                                     rec_offs_comp(offsets));
+								 comp);
 				ut_ad(rec_info & REC_INFO_MIN_REC_FLAG);
 				ut_ad(!page_has_prev(page));
 				mtr_commit(&mtr);
@@ -182,8 +182,9 @@ will mark their views as closed but not actually free their views.
 */
 inline void ReadView::snapshot(trx_t *trx)
 {
-  trx_sys.snapshot_ids(trx, &m_ids, &m_low_limit_id, &m_low_limit_no);
-  std::sort(m_ids.begin(), m_ids.end());
+  if (trx_sys.snapshot_ids(trx, &m_ids, &m_low_limit_id, &m_low_limit_no,
+                           &m_ids_version))
+    std::sort(m_ids.begin(), m_ids.end());
   m_up_limit_id= m_ids.empty() ? m_low_limit_id : m_ids.front();
   ut_ad(m_up_limit_id <= m_low_limit_id);
 }
@@ -682,6 +682,108 @@ cmp_dtuple_rec_with_match_low(
 	return(ret);
 }
 
+/** Convert a search tuple.
+@param[in]	tuple	search tuple
+@param[in]	index	B-tree index
+@return whether the tuple can be compared by cmp() */
+bool
+cmp_normalized_key_t::init(const dtuple_t* tuple, const dict_index_t* index)
+{
+	n_fields = dtuple_get_n_fields_cmp(tuple);
+	len = 0;
+
+	if (!n_fields || n_fields > max_fields
+	    || index->is_spatial() || dict_index_is_ibuf(index)
+	    || (dtuple_get_info_bits(tuple) & REC_INFO_MIN_REC_FLAG)) {
+		return(false);
+	}
+
+	for (ulint i = 0; i < n_fields; i++) {
+		const dict_field_t*	field = dict_index_get_nth_field(
+			index, i);
+		const dfield_t*		dfield = dtuple_get_nth_field(tuple, i);
+		const ulint		f_len = dfield_get_len(dfield);
+
+		/* cmp_data() compares these types with memcmp(),
+		padding only fields of different length. */
+		switch (dfield_get_type(dfield)->mtype) {
+		case DATA_INT:
+		case DATA_SYS:
+		case DATA_FIXBINARY:
+			break;
+		default:
+			return(false);
+		}
+
+		/* The field must be stored at a fixed offset in every
+		record of the index. */
+		if (field->prefix_len || field->col->is_nullable()
+		    || f_len != field->fixed_len
+		    || len + f_len > max_len) {
+			return(false);
+		}
+
+		memcpy(buf + len, dfield_get_data(dfield), f_len);
+		len += f_len;
+		field_end[i] = len;
+	}
+
+	return(true);
+}
+
+/** Compare the key to a record.
+@see cmp_dtuple_rec_with_match()
+@param[in]	rec		B-tree record
+@param[in]	comp		whether the record is in ROW_FORMAT=COMPACT
+@param[in,out]	matched_fields	number of completely matched fields
+@retval 0 if the key is equal to rec
+@retval negative if the key is less than rec
+@retval positive if the key is greater than rec */
+int
+cmp_normalized_key_t::cmp(
+	const rec_t*	rec,
+	bool		comp,
+	ulint*		matched_fields) const
+{
+	ulint	f = *matched_fields;
+
+	ut_ad(f <= n_fields);
+
+	if (!f && (rec_get_info_bits(rec, comp) & REC_INFO_MIN_REC_FLAG)) {
+		/* init() rejected search tuples with this flag. */
+		return(1);
+	}
+
+	ulint	i = f ? field_end[f - 1] : 0;
+
+	/* Skip the equal prefix a word at a time. */
+	for (; i + 8 <= len; i += 8) {
+		uint64_t	a;
+		uint64_t	b;
+
+		memcpy(&a, buf + i, 8);
+		memcpy(&b, rec + i, 8);
+
+		if (a != b) {
+			break;
+		}
+	}
+
+	for (; i < len; i++) {
+		if (buf[i] != rec[i]) {
+			while (field_end[f] <= i) {
+				f++;
+			}
+
+			*matched_fields = f;
+			return(int(buf[i]) - int(rec[i]));
+		}
+	}
+
+	*matched_fields = n_fields;
+	return(0);
+}
+
 /** Get the pad character code point for a type.
 @param[in]	type
 @return		pad character code point
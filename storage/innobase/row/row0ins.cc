@@ -36,6 +36,7 @@ Created 4/20/1996 Heikki Tuuri
 #include "row0upd.h"
 #include "row0sel.h"
 #include "row0log.h"
+#include "row0merge.h"
 #include "rem0cmp.h"
 #include "lock0lock.h"
 #include "log0log.h"
@@ -3289,17 +3290,20 @@ row_ins_clust_index_entry(
 
 	if (err != DB_FAIL) {
 		DEBUG_SYNC_C("row_ins_clust_index_entry_leaf_after");
-		DBUG_RETURN(err);
-	}
+	} else {
+		/* Try then pessimistic descent to the B-tree */
+		log_free_check();
 
-	/* Try then pessimistic descent to the B-tree */
-	log_free_check();
+		err = row_ins_clust_index_entry_low(
+			flags, BTR_MODIFY_TREE, index, n_uniq, entry,
+			n_ext, thr);
 
-	err = row_ins_clust_index_entry_low(
-		flags, BTR_MODIFY_TREE, index, n_uniq, entry,
-		n_ext, thr);
+		entry->n_fields = orig_n_fields;
+	}
 
-	entry->n_fields = orig_n_fields;
+	if (err == DB_SUCCESS) {
+		index->stat_modified_counter++;
+	}
 
 	DBUG_RETURN(err);
 }
@@ -3379,9 +3383,182 @@ row_ins_sec_index_entry(
 
 	mem_heap_free(heap);
 	mem_heap_free(offsets_heap);
+
+	if (err == DB_SUCCESS) {
+		index->stat_modified_counter++;
+	}
+
 	return(err);
 }
 
+/** Determine if an index tree is empty.
+@param[in]	index	index tree
+@return whether the index root page is a leaf page without records */
+static bool row_ins_index_is_empty(dict_index_t* index)
+{
+	mtr_t	mtr;
+	bool	empty = false;
+
+	mtr.start();
+
+	if (const buf_block_t* root = btr_root_block_get(
+		    index, RW_S_LATCH, &mtr)) {
+		empty = page_is_leaf(root->frame)
+			&& page_is_empty(root->frame);
+	}
+
+	mtr.commit();
+	return empty;
+}
+
+/** Determine if the records of an index could be so long that
+some columns would have to be stored off-page.
+@param[in]	index	index tree
+@return whether off-page columns are possible */
+static bool row_ins_index_may_need_ext(const dict_index_t* index)
+{
+	ulint	size = REC_N_OLD_EXTRA_BYTES + 2 * ulint(index->n_fields);
+
+	for (ulint i = 0; i < index->n_fields; i++) {
+		const dict_field_t*	field = dict_index_get_nth_field(
+			index, i);
+		const ulint		len = field->prefix_len
+			? ulint(field->prefix_len)
+			: dict_col_get_max_size(field->col);
+
+		if (len == ULINT_MAX) {
+			return true;
+		}
+
+		size += len;
+	}
+
+	return size >= page_get_free_space_of_empty(
+		dict_table_is_comp(index->table)) / 2;
+}
+
+/** Start a bulk insert into an empty table on the first insert into
+the table by the transaction. The table is locked exclusively and
+a TRX_UNDO_EMPTY record is written, so that the rest of the statement
+does not need any undo log records for the table. If all indexes are
+empty and the records are short enough, the index entries will be
+buffered in trx_mod_table_time_t::bulk_store and sorted into the indexes
+at the end of the statement.
+@param[in,out]	index	clustered index
+@param[in,out]	thr	query thread
+@return error code
+@retval DB_FAIL	if the bulk insert is not possible */
+static dberr_t row_ins_bulk_start(dict_index_t* index, que_thr_t* thr)
+{
+	trx_t*		trx = thr_get_trx(thr);
+	dict_table_t*	table = index->table;
+
+	ut_ad(index->is_primary());
+	ut_ad(trx->bulk_insert);
+
+	if (trx->duplicates || trx->is_wsrep()
+	    || table->is_temporary() || table->no_rollback()
+	    || table->skip_alter_undo || table->versioned() || table->fts
+	    || !table->foreign_set.empty() || !table->referenced_set.empty()) {
+		return DB_FAIL;
+	}
+
+	for (const dict_index_t* i = index; i;
+	     i = dict_table_get_next_index(i)) {
+		if ((i->type & (DICT_FTS | DICT_SPATIAL))
+		    || i->is_corrupted() || i->is_instant()
+		    || dict_index_is_online_ddl(i)) {
+			return DB_FAIL;
+		}
+	}
+
+	if (!row_ins_index_is_empty(index)) {
+		return DB_FAIL;
+	}
+
+	dberr_t	err = lock_table(0, table, LOCK_X, thr);
+
+	if (err != DB_SUCCESS) {
+		return err;
+	}
+
+	/* Some other transaction may have inserted records
+	before we acquired the table lock. */
+	if (!row_ins_index_is_empty(index)) {
+		return DB_FAIL;
+	}
+
+	roll_ptr_t	roll_ptr;
+	err = trx_undo_report_row_operation(thr, index, NULL, NULL, 0,
+					    NULL, NULL, &roll_ptr);
+	if (err != DB_SUCCESS) {
+		return err;
+	}
+
+	trx_mod_table_time_t&	time = trx->mod_tables.find(table)->second;
+	ut_ad(time.is_bulk_insert());
+
+	if (table->space->zip_size()) {
+		return DB_SUCCESS;
+	}
+
+	for (dict_index_t* i = index; i; i = dict_table_get_next_index(i)) {
+		if (row_ins_index_may_need_ext(i)
+		    || (i != index && !row_ins_index_is_empty(i))) {
+			/* Insert row by row, without undo logging. */
+			return DB_SUCCESS;
+		}
+	}
+
+	time.bulk_store = UT_NEW_NOKEY(row_merge_bulk_t(table));
+	return DB_SUCCESS;
+}
+
+/** Insert an index entry of a bulk insert into an empty table.
+@param[in,out]	index	index
+@param[in,out]	entry	index entry
+@param[in,out]	thr	query thread
+@return error code
+@retval DB_FAIL	if the entry must be inserted into the index tree */
+static dberr_t row_ins_bulk_insert(dict_index_t* index, dtuple_t* entry,
+				   que_thr_t* thr)
+{
+	trx_t*				trx = thr_get_trx(thr);
+	trx_mod_tables_t::iterator	t = trx->mod_tables.find(index->table);
+
+	if (t == trx->mod_tables.end()) {
+		if (!index->is_primary()) {
+			return DB_FAIL;
+		}
+
+		dberr_t	err = row_ins_bulk_start(index, thr);
+
+		if (err != DB_SUCCESS) {
+			return err;
+		}
+
+		t = trx->mod_tables.find(index->table);
+	}
+
+	row_merge_bulk_t*	store = t->second.bulk_store;
+
+	if (!store) {
+		return DB_FAIL;
+	}
+
+	ut_ad(t->second.is_bulk_insert());
+
+	if (index->is_primary()) {
+		dfield_t*	r = dtuple_get_nth_field(
+			entry, index->db_roll_ptr());
+		ut_ad(r->len == DATA_ROLL_PTR_LEN);
+		trx_write_roll_ptr(static_cast<byte*>(r->data),
+				   roll_ptr_t(1) << ROLL_PTR_INSERT_FLAG_POS);
+	}
+
+	return store->bulk_insert_buffered(*entry, *index, trx);
+}
+
 /***************************************************************//**
 Inserts an index entry to index. Tries first optimistic, then pessimistic
 descent down the tree. If the entry matches enough to a delete marked record,
@@ -3396,13 +3573,23 @@ row_ins_index_entry(
 	dtuple_t*	entry,	/*!< in/out: index entry to insert */
 	que_thr_t*	thr)	/*!< in: query thread */
 {
-	ut_ad(thr_get_trx(thr)->id || index->table->no_rollback()
+	trx_t*	trx = thr_get_trx(thr);
+
+	ut_ad(trx->id || index->table->no_rollback()
 	      || index->table->is_temporary());
 
 	DBUG_EXECUTE_IF("row_ins_index_entry_timeout", {
 			DBUG_SET("-d,row_ins_index_entry_timeout");
 			return(DB_LOCK_WAIT);});
 
+	if (trx->bulk_insert && !index->table->is_temporary()) {
+		dberr_t	err = row_ins_bulk_insert(index, entry, thr);
+
+		if (err != DB_FAIL) {
+			return err;
+		}
+	}
+
 	if (index->is_primary()) {
 		return row_ins_clust_index_entry(index, entry, thr, 0);
 	} else {
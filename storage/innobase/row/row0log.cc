@@ -37,10 +37,12 @@ Created 2011-05-26 Marko Makela
 #include "handler0alter.h"
 #include "ut0stage.h"
 #include "trx0rec.h"
+#include "pars0pars.h"
 
 #include <sql_class.h>
 #include <algorithm>
 #include <map>
+#include <vector>
 
 Atomic_counter<ulint> onlineddl_rowlog_rows;
 ulint onlineddl_rowlog_pct_used;
@@ -233,6 +235,9 @@ struct row_log_t {
 				if not, NULL values will not be converted to
 				defaults */
 	const TABLE*	old_table; /*< Use old table in case of error. */
+	bool		row_reported; /*!< whether row_log_table_report_row()
+				copied an erroneous row to the MySQL table;
+				protected by mutex */
 
 	uint64_t	n_rows; /*< Number of rows read from the table */
 	/** Determine whether the log should be in the 'instant ADD' format
@@ -1529,6 +1534,8 @@ row_log_table_apply_convert_mrec(
 	const rec_offs*		offsets,	/*!< in: offsets of mrec */
 	row_log_t*		log,		/*!< in: rebuild context */
 	mem_heap_t*		heap,		/*!< in/out: memory heap */
+	ulonglong		pos,		/*!< in: row_log_t::head::total
+						after the log record */
 	dberr_t*		error)		/*!< out: DB_SUCCESS or
 						DB_MISSING_HISTORY or
 						reason of failure */
@@ -1604,7 +1611,7 @@ row_log_table_apply_convert_mrec(
 				page_no_map::const_iterator p = blobs->find(
 					page_no);
 				if (p != blobs->end()
-				    && p->second.is_freed(log->head.total)) {
+				    && p->second.is_freed(pos)) {
 					/* This BLOB has been freed.
 					We must not access the row. */
 					*error = DB_MISSING_HISTORY;
@@ -1696,6 +1703,29 @@ row_log_table_apply_convert_mrec(
 	return(row);
 }
 
+/** Report an erroneous row using the new version of the table.
+When the log is being applied by several threads, only the row of
+the first error will be reported.
+@param[in,out]	dup	for reporting duplicate key errors
+@param[in,out]	log	online rebuild log
+@param[in]	row	table row in the new table definition */
+static
+void
+row_log_table_report_row(
+	row_merge_dup_t*	dup,
+	row_log_t*		log,
+	const dtuple_t*		row)
+{
+	mutex_enter(&log->mutex);
+
+	if (!log->row_reported) {
+		log->row_reported = true;
+		innobase_row_to_mysql(dup->table, log->table, row);
+	}
+
+	mutex_exit(&log->mutex);
+}
+
 /******************************************************//**
 Replays an insert operation on a table that was rebuilt.
 @return DB_SUCCESS or error code */
@@ -1784,13 +1814,15 @@ row_log_table_apply_insert(
 	mem_heap_t*		offsets_heap,	/*!< in/out: memory heap
 						that can be emptied */
 	mem_heap_t*		heap,		/*!< in/out: memory heap */
-	row_merge_dup_t*	dup)		/*!< in/out: for reporting
+	row_merge_dup_t*	dup,		/*!< in/out: for reporting
 						duplicate key errors */
+	ulonglong		pos)		/*!< in: row_log_t::head::total
+						after the log record */
 {
 	row_log_t*log	= dup->index->online_log;
 	dberr_t		error;
 	const dtuple_t*	row	= row_log_table_apply_convert_mrec(
-		mrec, dup->index, offsets, log, heap, &error);
+		mrec, dup->index, offsets, log, heap, pos, &error);
 
 	switch (error) {
 	case DB_MISSING_HISTORY:
@@ -1818,7 +1850,7 @@ row_log_table_apply_insert(
 	if (error != DB_SUCCESS) {
 		/* Report the erroneous row using the new
 		version of the table. */
-		innobase_row_to_mysql(dup->table, log->table, row);
+		row_log_table_report_row(dup, log, row);
 	}
 	return(error);
 }
@@ -2054,10 +2086,12 @@ row_log_table_apply_update(
 	mem_heap_t*		heap,		/*!< in/out: memory heap */
 	row_merge_dup_t*	dup,		/*!< in/out: for reporting
 						duplicate key errors */
-	const dtuple_t*		old_pk)		/*!< in: PRIMARY KEY and
+	const dtuple_t*		old_pk,		/*!< in: PRIMARY KEY and
 						DB_TRX_ID,DB_ROLL_PTR
 						of the old value,
 						or PRIMARY KEY if same_pk */
+	ulonglong		pos)		/*!< in: row_log_t::head::total
+						after the log record */
 {
 	row_log_t*	log	= dup->index->online_log;
 	const dtuple_t*	row;
@@ -2074,7 +2108,7 @@ row_log_table_apply_update(
 	      + (log->same_pk ? 0 : 2));
 
 	row = row_log_table_apply_convert_mrec(
-		mrec, dup->index, offsets, log, heap, &error);
+		mrec, dup->index, offsets, log, heap, pos, &error);
 
 	switch (error) {
 	case DB_MISSING_HISTORY:
@@ -2180,7 +2214,7 @@ row_log_table_apply_update(
 		if (error != DB_SUCCESS) {
 			/* Report the erroneous row using the new
 			version of the table. */
-			innobase_row_to_mysql(dup->table, log->table, row);
+			row_log_table_report_row(dup, log, row);
 		}
 
 		return(error);
@@ -2408,11 +2442,35 @@ row_log_table_apply_update(
 	goto func_exit;
 }
 
+/** Compute a fold value of the PRIMARY KEY of a log record.
+@param[in]	mrec	log record
+@param[in]	offsets	offsets of mrec
+@param[in]	n_uniq	number of PRIMARY KEY fields
+@return fold value */
+static
+ulint
+row_log_table_fold_pk(const mrec_t* mrec, const rec_offs* offsets,
+		      ulint n_uniq)
+{
+	ulint	fold = 0;
+
+	for (ulint i = 0; i < n_uniq; i++) {
+		ulint		len;
+		const byte*	field = rec_get_nth_field(
+			mrec, offsets, i, &len);
+
+		ut_ad(len != UNIV_SQL_NULL);
+		fold = ut_fold_ulint_pair(fold, ut_fold_binary(field, len));
+	}
+
+	return(fold);
+}
+
 /******************************************************//**
 Applies an operation to a table that was rebuilt.
 @return NULL on failure (mrec corruption) or when out of data;
 pointer to next record on success */
-static MY_ATTRIBUTE((nonnull, warn_unused_result))
+static MY_ATTRIBUTE((nonnull(1,3,4,5,6,7,8,9,10), warn_unused_result))
 const mrec_t*
 row_log_table_apply_op(
 /*===================*/
@@ -2428,8 +2486,15 @@ row_log_table_apply_op(
 	mem_heap_t*		heap,		/*!< in/out: memory heap */
 	const mrec_t*		mrec,		/*!< in: merge record */
 	const mrec_t*		mrec_end,	/*!< in: end of buffer */
-	rec_offs*		offsets)	/*!< in/out: work area
+	rec_offs*		offsets,	/*!< in/out: work area
 						for parsing mrec */
+	ulonglong*		total,		/*!< in/out: logical position
+						of mrec in the log, normally
+						&row_log_t::head::total */
+	ulint*			fold)		/*!< out: fold value of the
+						PRIMARY KEY, if the record
+						is only to be parsed; NULL
+						if it is to be applied */
 {
 	row_log_t*	log	= dup->index->online_log;
 	dict_index_t*	new_index = dict_table_get_first_index(log->table);
@@ -2439,7 +2504,8 @@ row_log_table_apply_op(
 
 	ut_ad(dict_index_is_clust(dup->index));
 	ut_ad(dup->index->table != log->table);
-	ut_ad(log->head.total <= log->tail.total);
+	ut_ad(*total <= log->tail.total);
+	ut_ad(!fold || log->same_pk);
 
 	*error = DB_SUCCESS;
 
@@ -2486,12 +2552,18 @@ row_log_table_apply_op(
 
 		if (next_mrec > mrec_end) {
 			return(NULL);
-		} else {
-			log->head.total += ulint(next_mrec - mrec_start);
-			*error = row_log_table_apply_insert(
-				thr, mrec, offsets, offsets_heap,
-				heap, dup);
 		}
+
+		*total += ulint(next_mrec - mrec_start);
+
+		if (fold) {
+			*fold = row_log_table_fold_pk(
+				mrec, offsets, new_index->n_uniq);
+			return(next_mrec);
+		}
+
+		*error = row_log_table_apply_insert(
+			thr, mrec, offsets, offsets_heap, heap, dup, *total);
 		break;
 
 	case ROW_T_DELETE:
@@ -2517,7 +2589,13 @@ row_log_table_apply_op(
 			return(NULL);
 		}
 
-		log->head.total += ulint(next_mrec - mrec_start);
+		*total += ulint(next_mrec - mrec_start);
+
+		if (fold) {
+			*fold = row_log_table_fold_pk(
+				mrec, offsets, new_index->n_uniq);
+			return(next_mrec);
+		}
 
 		*error = row_log_table_apply_delete(
 			new_trx_id_col,
@@ -2568,6 +2646,13 @@ row_log_table_apply_op(
 				return(NULL);
 			}
 
+			if (fold) {
+				*total += ulint(next_mrec - mrec_start);
+				*fold = row_log_table_fold_pk(
+					mrec, offsets, new_index->n_uniq);
+				return(next_mrec);
+			}
+
 			old_pk = dtuple_create(heap, new_index->n_uniq);
 			dict_index_copy_types(
 				old_pk, new_index, old_pk->n_fields);
@@ -2671,16 +2756,17 @@ row_log_table_apply_op(
 		}
 
 		ut_ad(next_mrec <= mrec_end);
-		log->head.total += ulint(next_mrec - mrec_start);
+		*total += ulint(next_mrec - mrec_start);
 		dtuple_set_n_fields_cmp(old_pk, new_index->n_uniq);
 
 		*error = row_log_table_apply_update(
 			thr, new_trx_id_col,
-			mrec, offsets, offsets_heap, heap, dup, old_pk);
+			mrec, offsets, offsets_heap, heap, dup, old_pk,
+			*total);
 		break;
 	}
 
-	ut_ad(log->head.total <= log->tail.total);
+	ut_ad(*total <= log->tail.total);
 	mem_heap_empty(offsets_heap);
 	mem_heap_empty(heap);
 	return(next_mrec);
@@ -2739,7 +2825,357 @@ row_log_progress_inc_per_block()
 }
 #endif /* HAVE_PSI_STAGE_INTERFACE */
 
+#ifdef UNIV_PFS_THREAD
+mysql_pfs_key_t	row_log_thread_key;
+#endif /* UNIV_PFS_THREAD */
+
+/** Log records that a thread of row_log_table_apply_ops() will apply.
+Each record is preceded by its length (4 bytes) and by its
+row_log_t::head::total after the record (8 bytes). */
+typedef std::vector<byte, ut_allocator<byte> >	row_log_table_batch_t;
+
+/** Size of the header of a record in row_log_table_batch_t */
+static const ulint ROW_LOG_BATCH_HEADER = 4 + 8;
+
+struct row_log_table_par_t;
+
+/** A thread that applies a partition of the log of a table rebuild */
+struct row_log_table_worker_t {
+	/** shared state */
+	row_log_table_par_t*	par;
+	/** log records to apply */
+	row_log_table_batch_t	batch;
+	/** memory heap for thr */
+	mem_heap_t*		graph_heap;
+	/** query graph of the thread */
+	que_thr_t*		thr;
+	/** memory heap that can be emptied */
+	mem_heap_t*		offsets_heap;
+	/** memory heap */
+	mem_heap_t*		heap;
+	/** work area for parsing log records */
+	rec_offs*		offsets;
+	/** for reporting duplicate key errors */
+	row_merge_dup_t		dup;
+	/** status of the thread */
+	dberr_t			err;
+};
+
+/** State of applying the log of a table rebuild by several threads.
+Records that refer to the same PRIMARY KEY value are applied by the same
+thread, in the order they were logged. The log is applied one block at a
+time: row_log_table_apply_ops() distributes the records of a block, and
+then row_log_table_apply_batches() applies them. */
+struct row_log_table_par_t {
+	/** transaction of the ALTER TABLE */
+	trx_t*			trx;
+	/** position of DB_TRX_ID in the new clustered index */
+	ulint			new_trx_id_col;
+	/** number of threads */
+	ulint			n_workers;
+	/** the threads */
+	row_log_table_worker_t*	workers;
+	/** number of records that have not been applied */
+	ulint			n_recs;
+	/** number of threads that failed */
+	Atomic_counter<ulint>	n_failed;
+};
+
+/** Determine whether row_log_table_apply_ops() can apply the log of a
+table rebuild by several threads, partitioned by the PRIMARY KEY. This
+requires that records for different PRIMARY KEY values can be applied in
+any order, and that no thread needs to access the connection.
+@param[in]	index	clustered index of the table that is being rebuilt
+@return whether the log can be applied in parallel */
+static
+bool
+row_log_table_can_apply_parallel(const dict_index_t* index)
+{
+	const row_log_t*	log = index->online_log;
+	const dict_table_t*	new_table = log->table;
+	const dict_index_t*	new_index = dict_table_get_first_index(
+		new_table);
+
+	if (srv_ddl_threads <= 1 || !log->same_pk
+	    || dict_table_get_n_v_cols(new_table)
+	    || dict_table_is_comp(index->table)
+	    != dict_table_is_comp(new_table)) {
+		return(false);
+	}
+
+	/* The outcome of a unique secondary index check depends on the
+	order in which the rows are modified. */
+	for (const dict_index_t* i = dict_table_get_next_index(new_index);
+	     i != NULL; i = dict_table_get_next_index(i)) {
+		if (dict_index_is_unique(i)
+		    || (i->type & (DICT_FTS | DICT_SPATIAL))) {
+			return(false);
+		}
+	}
+
+	/* The PRIMARY KEY must be stored in the same way in the old and
+	in the new table, so that all records for a row fold to the
+	same value. */
+	for (ulint i = 0; i < new_index->n_uniq; i++) {
+		const dict_field_t*	field = dict_index_get_nth_field(
+			index, i);
+		const dict_field_t*	new_field = dict_index_get_nth_field(
+			new_index, i);
+		const dict_col_t*	col = field->col;
+		const dict_col_t*	new_col = new_field->col;
+
+		if (field->prefix_len != new_field->prefix_len
+		    || log->col_map[dict_col_get_no(col)]
+		    != dict_col_get_no(new_col)
+		    || col->mtype != new_col->mtype
+		    || col->prtype != new_col->prtype
+		    || col->len != new_col->len) {
+			return(false);
+		}
+	}
+
+	/* Converting NULL to a NOT NULL column would push a warning to
+	the connection in row_log_table_apply_convert_mrec(). */
+	for (ulint i = 0; i < index->n_fields; i++) {
+		const dict_col_t*	col = dict_index_get_nth_col(index, i);
+
+		if (col->is_dropped()) {
+			continue;
+		}
+
+		const ulint	col_no = log->col_map[dict_col_get_no(col)];
+
+		if (col_no != ULINT_UNDEFINED
+		    && (dict_table_get_nth_col(new_table, col_no)->prtype
+			& DATA_NOT_NULL)
+		    && !(col->prtype & DATA_NOT_NULL)) {
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/** Create the state for applying the log of a table rebuild
+by several threads.
+@param[in]	thr		query graph of the ALTER TABLE
+@param[in]	dup		for reporting duplicate key errors
+@param[in]	new_trx_id_col	position of DB_TRX_ID in the new
+clustered index
+@param[in]	n_offsets	number of elements in a work area for
+parsing log records
+@return the state */
+static
+row_log_table_par_t*
+row_log_table_par_create(
+	que_thr_t*		thr,
+	const row_merge_dup_t*	dup,
+	ulint			new_trx_id_col,
+	ulint			n_offsets)
+{
+	row_log_table_par_t*	par = UT_NEW_NOKEY(row_log_table_par_t());
+
+	par->trx = thr_get_trx(thr);
+	par->new_trx_id_col = new_trx_id_col;
+	par->n_workers = srv_ddl_threads;
+	par->workers = UT_NEW_ARRAY_NOKEY(row_log_table_worker_t,
+					  par->n_workers);
+	par->n_recs = 0;
+	par->n_failed = 0;
+
+	for (ulint i = 0; i < par->n_workers; i++) {
+		row_log_table_worker_t*	w = &par->workers[i];
+
+		w->par = par;
+		w->graph_heap = mem_heap_create(512);
+		w->thr = pars_complete_graph_for_exec(
+			NULL, par->trx, w->graph_heap, thr->prebuilt);
+		w->offsets_heap = mem_heap_create(srv_page_size);
+		w->heap = mem_heap_create(srv_page_size);
+		w->offsets = static_cast<rec_offs*>(
+			ut_malloc_nokey(n_offsets * sizeof *w->offsets));
+		rec_offs_set_n_alloc(w->offsets, n_offsets);
+		w->dup = *dup;
+		w->err = DB_SUCCESS;
+	}
+
+	return(par);
+}
+
+/** Free the state for applying the log of a table rebuild
+by several threads.
+@param[in,out]	par	state created by row_log_table_par_create() */
+static
+void
+row_log_table_par_free(row_log_table_par_t* par)
+{
+	for (ulint i = 0; i < par->n_workers; i++) {
+		row_log_table_worker_t*	w = &par->workers[i];
+
+		ut_free(w->offsets);
+		mem_heap_free(w->heap);
+		mem_heap_free(w->offsets_heap);
+		mem_heap_free(w->graph_heap);
+	}
+
+	UT_DELETE_ARRAY(par->workers);
+	UT_DELETE(par);
+}
+
+/** Assign a parsed log record to the thread that applies its partition.
+@param[in,out]	par	parallel apply state
+@param[in]	fold	fold value of the PRIMARY KEY
+@param[in]	mrec	log record
+@param[in]	next_mrec	end of the log record
+@param[in]	total	row_log_t::head::total after the log record */
+static
+void
+row_log_table_par_add(
+	row_log_table_par_t*	par,
+	ulint			fold,
+	const mrec_t*		mrec,
+	const mrec_t*		next_mrec,
+	ulonglong		total)
+{
+	row_log_table_batch_t&	batch = par->workers[
+		fold % par->n_workers].batch;
+	const ulint		len = ulint(next_mrec - mrec);
+	const size_t		size = batch.size();
+
+	batch.resize(size + ROW_LOG_BATCH_HEADER + len);
+	mach_write_to_4(&batch[size], len);
+	mach_write_to_8(&batch[size + 4], total);
+	memcpy(&batch[size + ROW_LOG_BATCH_HEADER], mrec, len);
+	par->n_recs++;
+}
+
+/** Apply the log records that were assigned to a thread.
+@param[in,out]	w	the thread
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_log_table_apply_batch(row_log_table_worker_t* w)
+{
+	row_log_table_par_t*	par = w->par;
+	const byte*		b = w->batch.data();
+	const byte* const	end = b + w->batch.size();
+
+	while (b < end) {
+		if (par->n_failed) {
+			/* Another thread failed. It will report the error. */
+			return(DB_SUCCESS);
+		}
+
+		if (trx_is_interrupted(par->trx)) {
+			return(DB_INTERRUPTED);
+		}
+
+		const ulint	len = mach_read_from_4(b);
+		ulonglong	total = mach_read_from_8(b + 4) - len;
+		dberr_t		err;
+
+		b += ROW_LOG_BATCH_HEADER;
+
+		log_free_check();
+
+		const mrec_t*	next = row_log_table_apply_op(
+			w->thr, par->new_trx_id_col, &w->dup, &err,
+			w->offsets_heap, w->heap, b, b + len, w->offsets,
+			&total, NULL);
+
+		if (err != DB_SUCCESS) {
+			return(err);
+		}
+
+		b += len;
+
+		if (UNIV_UNLIKELY(next != b)) {
+			return(DB_CORRUPTION);
+		}
+	}
+
+	return(DB_SUCCESS);
+}
+
+/** Thread that applies a partition of the log of a table rebuild.
+@param[in,out]	arg	row_log_table_worker_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_log_table_apply_thread)(void* arg)
+{
+	my_thread_init();
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(row_log_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	row_log_table_worker_t*	w = static_cast<row_log_table_worker_t*>(
+		arg);
+
+	w->err = row_log_table_apply_batch(w);
+
+	if (w->err != DB_SUCCESS) {
+		w->par->n_failed++;
+	}
+
+	my_thread_end();
+	/* row_log_table_apply_batches() will join this thread. */
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Apply the log records that were assigned to the threads by
+row_log_table_par_add(), and wait for the threads to finish.
+@param[in,out]	par	parallel apply state
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_log_table_apply_batches(row_log_table_par_t* par)
+{
+	std::vector<os_thread_id_t>	threads(par->n_workers);
+	dberr_t				err = DB_SUCCESS;
+
+	for (ulint i = 1; i < par->n_workers; i++) {
+		row_log_table_worker_t*	w = &par->workers[i];
+
+		w->err = DB_SUCCESS;
+
+		if (!w->batch.empty()) {
+			os_thread_create(row_log_table_apply_thread, w,
+					 &threads[i]);
+		}
+	}
+
+	row_log_table_worker_t*	w = &par->workers[0];
+
+	w->err = row_log_table_apply_batch(w);
+
+	if (w->err != DB_SUCCESS) {
+		par->n_failed++;
+	}
+
+	for (ulint i = 0; i < par->n_workers; i++) {
+		w = &par->workers[i];
+
+		if (i && !w->batch.empty()) {
+			os_thread_join(threads[i]);
+		}
+
+		if (err == DB_SUCCESS) {
+			err = w->err;
+		}
+
+		w->batch.clear();
+	}
+
+	par->n_recs = 0;
+	return(err);
+}
+
 /** Applies operations to a table was rebuilt.
+The blocks that precede the one being written to are applied by
+innodb_ddl_threads threads if row_log_table_can_apply_parallel().
 @param[in]	thr	query graph
 @param[in,out]	dup	for reporting duplicate key errors
 @param[in,out]	stage	performance schema accounting object, used by
@@ -2773,6 +3209,8 @@ row_log_table_apply_ops(
 	const ulint	new_trx_id_col	= dict_col_get_clust_pos(
 		dict_table_get_sys_col(new_table, DATA_TRX_ID), new_index);
 	trx_t*		trx		= thr_get_trx(thr);
+	row_log_table_par_t* par	= NULL;
+	ulint		fold;
 
 	ut_ad(dict_index_is_clust(index));
 	ut_ad(dict_index_is_online_ddl(index));
@@ -2795,6 +3233,10 @@ row_log_table_apply_ops(
 	offsets_heap = mem_heap_create(srv_page_size);
 	has_index_lock = true;
 
+	if (row_log_table_can_apply_parallel(index)) {
+		par = row_log_table_par_create(thr, dup, new_trx_id_col, i);
+	}
+
 next_block:
 	ut_ad(has_index_lock);
 	ut_ad(rw_lock_own(dict_index_get_lock(index), RW_LOCK_X));
@@ -2855,6 +3297,7 @@ row_log_table_apply_ops(
 			/* End of log reached. */
 all_done:
 			ut_ad(has_index_lock);
+			ut_ad(!par || !par->n_recs);
 			ut_ad(index->online_log->head.blocks == 0);
 			ut_ad(index->online_log->tail.blocks == 0);
 			index->online_log->head.bytes = 0;
@@ -2942,7 +3385,9 @@ row_log_table_apply_ops(
 			thr, new_trx_id_col,
 			dup, &error, offsets_heap, heap,
 			index->online_log->head.buf,
-			(&index->online_log->head.buf)[1], offsets);
+			(&index->online_log->head.buf)[1], offsets,
+			&index->online_log->head.total,
+			par && !has_index_lock ? &fold : NULL);
 		if (error != DB_SUCCESS) {
 			goto func_exit;
 		} else if (UNIV_UNLIKELY(mrec == NULL)) {
@@ -2954,6 +3399,13 @@ row_log_table_apply_ops(
 		it should proceed beyond the old end of the buffer. */
 		ut_a(mrec > mrec_end);
 
+		if (par && !has_index_lock) {
+			row_log_table_par_add(par, fold,
+					      index->online_log->head.buf,
+					      mrec,
+					      index->online_log->head.total);
+		}
+
 		index->online_log->head.bytes = ulint(mrec - mrec_end);
 		next_mrec += index->online_log->head.bytes;
 	}
@@ -3047,11 +3499,20 @@ row_log_table_apply_ops(
 		next_mrec = row_log_table_apply_op(
 			thr, new_trx_id_col,
 			dup, &error, offsets_heap, heap,
-			mrec, mrec_end, offsets);
+			mrec, mrec_end, offsets,
+			&index->online_log->head.total,
+			par && !has_index_lock ? &fold : NULL);
 
 		if (error != DB_SUCCESS) {
 			goto func_exit;
-		} else if (next_mrec == next_mrec_end) {
+		}
+
+		if (next_mrec && par && !has_index_lock) {
+			row_log_table_par_add(par, fold, mrec, next_mrec,
+					      index->online_log->head.total);
+		}
+
+		if (next_mrec == next_mrec_end) {
 			/* The record happened to end on a block boundary.
 			Do we have more blocks left? */
 			if (has_index_lock) {
@@ -3062,6 +3523,17 @@ row_log_table_apply_ops(
 
 			mrec = NULL;
 process_next_block:
+			if (par && par->n_recs) {
+				/* Apply the records of the block before
+				proceeding to the next one, which could
+				be the one that is being written to. */
+				error = row_log_table_apply_batches(par);
+
+				if (error != DB_SUCCESS) {
+					goto func_exit;
+				}
+			}
+
 			rw_lock_x_lock(dict_index_get_lock(index));
 			has_index_lock = true;
 
@@ -3097,6 +3569,10 @@ row_log_table_apply_ops(
 		rw_lock_x_lock(dict_index_get_lock(index));
 	}
 
+	if (par) {
+		row_log_table_par_free(par);
+	}
+
 	mem_heap_free(offsets_heap);
 	mem_heap_free(heap);
 	row_log_block_free(index->online_log->head);
@@ -3232,6 +3708,7 @@ row_log_allocate(
 	      == (index->n_core_fields < index->n_fields));
 	log->allow_not_null = allow_not_null;
 	log->old_table = old_table;
+	log->row_reported = false;
 	log->n_rows = 0;
 
 	if (table && index->is_instant()) {
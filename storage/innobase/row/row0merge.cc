@@ -831,7 +831,7 @@ row_merge_dup_report(
 	row_merge_dup_t*	dup,	/*!< in/out: for reporting duplicates */
 	const dfield_t*		entry)	/*!< in: duplicate index entry */
 {
-	if (!dup->n_dup++) {
+	if (!dup->n_dup++ && dup->table) {
 		/* Only report the first duplicate record,
 		but count all duplicate records. */
 		innobase_fields_to_mysql(dup->table, dup->index, entry);
@@ -1602,6 +1602,24 @@ row_geo_field_is_valid(
 	return(true);
 }
 
+/** Publish the progress of ALTER TABLE in the status variable
+innodb_onlineddl_pct_progress and in SHOW PROCESSLIST.
+This must only be invoked by the thread that is executing ALTER TABLE.
+@param[in]	trx	transaction of the ALTER TABLE
+@param[in]	pct	percentage of the work that has been done */
+static
+void
+row_merge_report_progress(const trx_t* trx, double pct)
+{
+	/* presenting 10.12% as 1012 integer */
+	onlineddl_pct_progress = ulint(pct * 100);
+
+	if (trx->mysql_thd) {
+		thd_progress_report(trx->mysql_thd, onlineddl_pct_progress,
+				    10000);
+	}
+}
+
 /** Reads clustered index of the table and create temporary files
 containing the index entries for the indexes to be built.
 @param[in]	trx		transaction
@@ -2692,8 +2710,7 @@ row_merge_read_clustered_index(
 			curr_progress = (read_rows >= table_total_rows) ?
 					pct_cost :
 				((pct_cost * read_rows) / table_total_rows);
-			/* presenting 10.12% as 1012 integer */
-			onlineddl_pct_progress = (ulint) (curr_progress * 100);
+			row_merge_report_progress(trx, curr_progress);
 		}
 	}
 
@@ -3255,6 +3272,289 @@ row_merge(
 	return(DB_SUCCESS);
 }
 
+#ifdef UNIV_PFS_THREAD
+mysql_pfs_key_t	row_merge_thread_key;
+#endif /* UNIV_PFS_THREAD */
+
+/** Buffers of a thread that merges or inserts index entries */
+struct row_merge_thread_buf_t {
+	/** 3 buffers */
+	row_merge_block_t*	block;
+	/** allocation of block */
+	ut_new_pfx_t		block_pfx;
+	/** encryption buffer, or NULL */
+	row_merge_block_t*	crypt_block;
+	/** allocation of crypt_block */
+	ut_new_pfx_t		crypt_pfx;
+};
+
+/** Allocate the buffers of a thread that merges or inserts index entries.
+@param[out]	buf	buffers
+@return whether the allocation succeeded */
+static
+bool
+row_merge_thread_buf_alloc(row_merge_thread_buf_t* buf)
+{
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+
+	buf->crypt_block = NULL;
+	buf->block = alloc.allocate_large(3 * srv_sort_buf_size,
+					  &buf->block_pfx);
+
+	if (buf->block == NULL) {
+		return(false);
+	}
+
+	if (log_tmp_is_encrypted()) {
+		buf->crypt_block = alloc.allocate_large(
+			3 * srv_sort_buf_size, &buf->crypt_pfx);
+
+		if (buf->crypt_block == NULL) {
+			alloc.deallocate_large(buf->block, &buf->block_pfx,
+					       3 * srv_sort_buf_size);
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/** Free the buffers of a thread that merges or inserts index entries.
+@param[in,out]	buf	buffers allocated by row_merge_thread_buf_alloc() */
+static
+void
+row_merge_thread_buf_free(row_merge_thread_buf_t* buf)
+{
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+
+	alloc.deallocate_large(buf->block, &buf->block_pfx,
+			       3 * srv_sort_buf_size);
+
+	if (buf->crypt_block != NULL) {
+		alloc.deallocate_large(buf->crypt_block, &buf->crypt_pfx,
+				       3 * srv_sort_buf_size);
+	}
+}
+
+/** State shared by the threads of row_merge_parallel() */
+struct row_merge_par_t {
+	/** transaction, for checking whether it was interrupted */
+	trx_t*			trx;
+	/** descriptor of the index being created */
+	const row_merge_dup_t*	dup;
+	/** input file */
+	const merge_file_t*	file;
+	/** output file */
+	pfs_os_file_t		out_fd;
+	/** first block of each input run */
+	const ulint*		run_offset;
+	/** first block of each output run */
+	ulint*			out_offset;
+	/** number of input runs */
+	ulint			n_run;
+	/** tablespace ID for encryption */
+	ulint			space;
+	/** the next output run to produce */
+	Atomic_counter<ulint>	next;
+	/** number of records written to the output file */
+	Atomic_counter<ulint>	n_rec;
+	/** number of threads that failed */
+	Atomic_counter<ulint>	n_failed;
+};
+
+/** A thread of row_merge_parallel() */
+struct row_merge_par_thread_t {
+	/** shared state */
+	row_merge_par_t*	par;
+	/** buffers of the thread */
+	row_merge_thread_buf_t	buf;
+	/** status of the thread */
+	dberr_t			err;
+};
+
+/** Produce the output runs of a parallel merge pass until all of them
+have been assigned to a thread. Output run k is the merge of the input
+runs k and n_run / 2 + k, or a copy of the last input run if n_run is
+odd, like in row_merge(). It is written where the input runs would
+start if the first half of the input file were interleaved with the
+second half. A merged run never occupies more blocks than its inputs,
+so the output runs do not overlap, but there can be gaps between them.
+@param[in,out]	thr	thread state
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_merge_parallel_runs(row_merge_par_thread_t* thr)
+{
+	row_merge_par_t*	par	= thr->par;
+	const ulint		half	= par->n_run / 2;
+	const ulint		n_out	= par->n_run - half;
+	row_merge_block_t*	block	= thr->buf.block;
+	row_merge_block_t*	crypt_block = thr->buf.crypt_block;
+
+	while (!par->n_failed) {
+		const ulint	k = par->next++;
+
+		if (k >= n_out) {
+			break;
+		}
+
+		if (trx_is_interrupted(par->trx)) {
+			return(DB_INTERRUPTED);
+		}
+
+		const ulint	out = par->run_offset[k]
+			+ par->run_offset[half + k] - par->run_offset[half];
+		ulint		foffs0 = par->run_offset[k];
+		ulint		foffs1 = par->run_offset[half + k];
+		merge_file_t	of;
+		dberr_t		err = DB_SUCCESS;
+
+		of.fd = par->out_fd;
+		of.offset = out;
+		of.n_rec = 0;
+
+		if (k == half) {
+			if (!row_merge_blocks_copy(par->dup->index, par->file,
+						   block, &foffs1, &of, NULL,
+						   crypt_block, par->space)) {
+				err = DB_CORRUPTION;
+			}
+		} else {
+			err = row_merge_blocks(par->dup, par->file, block,
+					       &foffs0, &foffs1, &of, NULL,
+					       crypt_block, par->space);
+		}
+
+		if (err != DB_SUCCESS) {
+			return(err);
+		}
+
+		par->out_offset[k] = out;
+		par->n_rec += of.n_rec;
+	}
+
+	return(DB_SUCCESS);
+}
+
+/** Thread that produces output runs on behalf of row_merge_parallel().
+@param[in,out]	arg	row_merge_par_thread_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_merge_par_thread)(void* arg)
+{
+	my_thread_init();
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(row_merge_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	row_merge_par_thread_t*	thr = static_cast<row_merge_par_thread_t*>(
+		arg);
+
+	thr->err = row_merge_parallel_runs(thr);
+
+	if (thr->err != DB_SUCCESS) {
+		thr->par->n_failed++;
+	}
+
+	my_thread_end();
+	/* row_merge_parallel() will join this thread. */
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Merge pairs of runs in parallel, like row_merge() does serially.
+Because cmp_rec_rec_simple() writes a duplicate key value to dup->table,
+this must not be used when duplicates are to be reported.
+@param[in]	trx		transaction
+@param[in]	dup		descriptor of index being created
+@param[in,out]	file		file containing index entries
+@param[in,out]	thr		state of each thread; thr[0] is used by
+				the calling thread
+@param[in]	n_threads	number of elements in thr
+@param[in,out]	tmpfd		temporary file handle
+@param[in,out]	num_run		number of runs that remain to be merged
+@param[in,out]	run_offset	first block of each run
+@param[out]	out_offset	work area of num_run elements
+@param[in]	space		tablespace ID for encryption
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_merge_parallel(
+	trx_t*			trx,
+	const row_merge_dup_t*	dup,
+	merge_file_t*		file,
+	row_merge_par_thread_t*	thr,
+	ulint			n_threads,
+	pfs_os_file_t*		tmpfd,
+	ulint*			num_run,
+	ulint*			run_offset,
+	ulint*			out_offset,
+	ulint			space)
+{
+	row_merge_par_t	par;
+	const ulint	n_out = *num_run - *num_run / 2;
+
+	ut_ad(!dup->table || !dict_index_is_unique(dup->index));
+
+	par.trx = trx;
+	par.dup = dup;
+	par.file = file;
+	par.out_fd = *tmpfd;
+	par.run_offset = run_offset;
+	par.out_offset = out_offset;
+	par.n_run = *num_run;
+	par.space = space;
+	par.next = 0;
+	par.n_rec = 0;
+	par.n_failed = 0;
+
+	n_threads = ut_min(n_threads, n_out);
+
+	std::vector<os_thread_id_t>	threads(n_threads);
+
+	for (ulint i = 0; i < n_threads; i++) {
+		thr[i].par = &par;
+		thr[i].err = DB_SUCCESS;
+	}
+
+	for (ulint i = 1; i < n_threads; i++) {
+		os_thread_create(row_merge_par_thread, &thr[i], &threads[i]);
+	}
+
+	thr[0].err = row_merge_parallel_runs(&thr[0]);
+
+	if (thr[0].err != DB_SUCCESS) {
+		par.n_failed++;
+	}
+
+	for (ulint i = 1; i < n_threads; i++) {
+		os_thread_join(threads[i]);
+	}
+
+	for (ulint i = 0; i < n_threads; i++) {
+		if (thr[i].err != DB_SUCCESS) {
+			return(thr[i].err);
+		}
+	}
+
+	if (UNIV_UNLIKELY(par.n_rec != file->n_rec)) {
+		return(DB_CORRUPTION);
+	}
+
+	*num_run = n_out;
+	memcpy(run_offset, out_offset, n_out * sizeof *run_offset);
+
+	/* Swap file descriptors for the next pass. Because of the gaps
+	between the runs, file->offset remains an upper bound of the
+	size of the output file. */
+	*tmpfd = file->fd;
+	file->fd = par.out_fd;
+
+	return(DB_SUCCESS);
+}
+
 /** Merge disk files.
 @param[in]	trx	transaction
 @param[in]	dup	descriptor of index being created
@@ -3264,6 +3564,7 @@ row_merge(
 @param[in,out]	stage	performance schema accounting object, used by
 ALTER TABLE. If not NULL, stage->begin_phase_sort() will be called initially
 and then stage->inc() will be called for each record processed.
+@param[in]	n_threads	maximum number of threads for merging
 @return DB_SUCCESS or error code */
 dberr_t
 row_merge_sort(
@@ -3281,7 +3582,8 @@ row_merge_sort(
 	const double		pct_cost, /*!< in: current progress percent */
 	row_merge_block_t*	crypt_block, /*!< in: crypt buf or NULL */
 	ulint			space,	   /*!< in: space id */
-	ut_stage_alter_t* 	stage)
+	ut_stage_alter_t* 	stage,
+	ulint			n_threads)
 {
 	const ulint	half	= file->offset / 2;
 	ulint		num_runs;
@@ -3324,19 +3626,64 @@ row_merge_sort(
 				      num_runs);
 	}
 
+	/* Merge pairs of runs in parallel, as long as there are at
+	least two pairs to merge. The first pass merges the most runs,
+	so parallelism is decided once. Duplicates of a unique index
+	are reported via dup->table, which only one thread may do. */
+	if (dup->table && dict_index_is_unique(dup->index)) {
+		n_threads = 1;
+	} else {
+		n_threads = ut_min(n_threads, num_runs / 2);
+	}
+
+	ulint*			out_offset = NULL;
+	row_merge_par_thread_t*	thr = NULL;
+	ulint			n_alloc = 0;
+
+	if (n_threads > 1) {
+		out_offset = static_cast<ulint*>(
+			ut_malloc_nokey(file->offset * sizeof(ulint)));
+		thr = static_cast<row_merge_par_thread_t*>(
+			ut_zalloc_nokey(n_threads * sizeof *thr));
+
+		/* The calling thread uses the buffers that were passed. */
+		thr[0].buf.block = block;
+		thr[0].buf.crypt_block = crypt_block;
+
+		for (n_alloc = 1; n_alloc < n_threads; n_alloc++) {
+			if (!row_merge_thread_buf_alloc(&thr[n_alloc].buf)) {
+				break;
+			}
+		}
+
+		for (ulint i = 0; i < file->offset; i++) {
+			run_offset[i] = i;
+		}
+	}
+
 	/* Merge the runs until we have one big run */
 	do {
-		error = row_merge(trx, dup, file, block, tmpfd,
-				  &num_runs, run_offset, stage,
-				  crypt_block, space);
+		if (n_alloc > 1) {
+			error = row_merge_parallel(trx, dup, file, thr,
+						   n_alloc, tmpfd, &num_runs,
+						   run_offset, out_offset,
+						   space);
+			if (stage != NULL && error == DB_SUCCESS) {
+				stage->inc(file->n_rec);
+			}
+		} else {
+			error = row_merge(trx, dup, file, block, tmpfd,
+					  &num_runs, run_offset, stage,
+					  crypt_block, space);
+		}
 
 		if(update_progress) {
 			merge_count++;
 			curr_progress = (merge_count >= total_merge_sort_count) ?
 				pct_cost :
 				((pct_cost * merge_count) / total_merge_sort_count);
-			/* presenting 10.12% as 1012 integer */;
-			onlineddl_pct_progress = (ulint) ((pct_progress + curr_progress) * 100);
+			row_merge_report_progress(
+				trx, pct_progress + curr_progress);
 		}
 
 		if (error != DB_SUCCESS) {
@@ -3346,6 +3693,15 @@ row_merge_sort(
 		MEM_CHECK_DEFINED(run_offset, num_runs * sizeof *run_offset);
 	} while (num_runs > 1);
 
+	if (thr != NULL) {
+		for (ulint i = 1; i < n_alloc; i++) {
+			row_merge_thread_buf_free(&thr[i].buf);
+		}
+
+		ut_free(thr);
+		ut_free(out_offset);
+	}
+
 	ut_free(run_offset);
 
 	DBUG_RETURN(error);
@@ -3618,9 +3974,11 @@ row_merge_insert_index_tuples(
 
 		mem_heap_empty(tuple_heap);
 
-		/* Increment innodb_onlineddl_pct_progress status variable */
+		/* Increment innodb_onlineddl_pct_progress status variable,
+		unless we are building several indexes in parallel
+		(pct_cost == 0) */
 		inserted_rows++;
-		if(inserted_rows % 1000 == 0) {
+		if (pct_cost > 0 && inserted_rows % 1000 == 0) {
 			/* Update progress for each 1000 rows */
 			curr_progress = (inserted_rows >= table_total_rows ||
 				table_total_rows <= 0) ?
@@ -4470,6 +4828,281 @@ void row_merge_write_redo(const dict_index_t* index)
 	mtr.commit();
 }
 
+/** An index that is sorted and built by row_merge_build_parallel() */
+struct row_merge_job_t {
+	/** the index, or NULL if the index is not built in parallel */
+	dict_index_t*	index;
+	/** index entries */
+	merge_file_t*	file;
+	/** share of the ALTER TABLE progress percentage */
+	double		pct_cost;
+	/** whether the index was built */
+	bool		done;
+	/** outcome of building the index */
+	dberr_t		err;
+};
+
+/** State shared by the threads of row_merge_build_parallel() */
+struct row_merge_jobs_t {
+	/** transaction of the ALTER TABLE */
+	trx_t*			trx;
+	/** table where rows are read from */
+	const dict_table_t*	old_table;
+	/** mapping of old column numbers to new ones, or NULL */
+	const ulint*		col_map;
+	/** location of temporary files */
+	const char*		path;
+	/** tablespace ID for encryption */
+	ulint			space;
+	/** number of threads for each row_merge_sort() */
+	ulint			n_sort_threads;
+	/** indexes that do not need to report duplicate key values */
+	row_merge_job_t**	queue;
+	/** number of elements in queue */
+	ulint			n_queue;
+	/** the next element of queue to build */
+	Atomic_counter<ulint>	next;
+	/** number of threads that failed to build an index */
+	Atomic_counter<ulint>	n_failed;
+	/** number of worker threads that are running */
+	Atomic_counter<ulint>	n_running;
+	/** progress of the completed jobs, presenting 10.12% as 1012 */
+	Atomic_counter<ulint>	pct_done;
+};
+
+/** A thread of row_merge_build_parallel() */
+struct row_merge_job_thread_t {
+	/** shared state */
+	row_merge_jobs_t*	jobs;
+	/** buffers of the thread */
+	row_merge_thread_buf_t	buf;
+	/** temporary file for row_merge_sort() */
+	pfs_os_file_t		tmpfd;
+};
+
+/** Sort the entries of an index and insert them to the index.
+@param[in,out]	thr	thread state
+@param[in,out]	job	the index to build
+@param[in,out]	table	MySQL table, for reporting duplicate key values,
+or NULL if the index is not unique */
+static
+void
+row_merge_build_job(
+	row_merge_job_thread_t*	thr,
+	row_merge_job_t*	job,
+	struct TABLE*		table)
+{
+	row_merge_jobs_t*	jobs = thr->jobs;
+	trx_t*			trx = jobs->trx;
+	row_merge_dup_t		dup = {job->index, table, jobs->col_map, 0};
+
+	/* A file of a single block is already sorted. */
+	if (job->file->offset > 1
+	    && !row_merge_tmpfile_if_needed(&thr->tmpfd, jobs->path)) {
+		job->err = DB_OUT_OF_MEMORY;
+	} else {
+		job->err = row_merge_sort(
+			trx, &dup, job->file, thr->buf.block, &thr->tmpfd,
+			false, 0, 0, thr->buf.crypt_block, jobs->space,
+			NULL, jobs->n_sort_threads);
+	}
+
+	if (job->err == DB_SUCCESS) {
+		BtrBulk	btr_bulk(job->index, trx, trx->get_flush_observer());
+
+		job->err = row_merge_insert_index_tuples(
+			job->index, jobs->old_table, job->file->fd,
+			thr->buf.block, NULL, &btr_bulk, job->file->n_rec,
+			0, 0, thr->buf.crypt_block, jobs->space, NULL);
+		job->err = btr_bulk.finish(job->err);
+	}
+
+	job->done = true;
+
+	if (job->err != DB_SUCCESS) {
+		jobs->n_failed++;
+	} else {
+		jobs->pct_done += ulint(job->pct_cost * 100);
+	}
+}
+
+/** Build the queued indexes until the queue is empty or a job failed.
+@param[in,out]	thr	thread state */
+static
+void
+row_merge_build_queued(row_merge_job_thread_t* thr)
+{
+	row_merge_jobs_t*	jobs = thr->jobs;
+
+	while (!jobs->n_failed && !trx_is_interrupted(jobs->trx)) {
+		const ulint	i = jobs->next++;
+
+		if (i >= jobs->n_queue) {
+			break;
+		}
+
+		row_merge_build_job(thr, jobs->queue[i], NULL);
+	}
+}
+
+/** Thread that builds indexes on behalf of row_merge_build_parallel().
+@param[in,out]	arg	row_merge_job_thread_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_merge_build_thread)(void* arg)
+{
+	my_thread_init();
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(row_merge_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	row_merge_job_thread_t*	thr = static_cast<row_merge_job_thread_t*>(
+		arg);
+
+	row_merge_build_queued(thr);
+	thr->jobs->n_running--;
+
+	my_thread_end();
+	/* row_merge_build_parallel() will join this thread. */
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Sort and build several indexes in parallel, after
+row_merge_read_clustered_index() has written their entries to files.
+Unique indexes are built by the calling thread in the order of indexes[],
+because only one thread may report a duplicate key value to the MySQL
+table, and row_merge_build_indexes() reports the first error in that order.
+Other indexes are built by srv_ddl_threads - 1 threads with help from the
+calling thread. Indexes that were not built, because of an earlier error,
+will be built by the caller.
+@param[in]	trx		transaction
+@param[in]	old_table	table where rows are read from
+@param[in]	table		MySQL table, for reporting erroneous key value
+@param[in]	col_map		mapping of old column numbers to new ones,
+or NULL
+@param[in]	space		tablespace ID for encryption
+@param[in]	block		3 buffers of the calling thread
+@param[in]	crypt_block	encryption buffer of the calling thread, or NULL
+@param[in,out]	tmpfd		temporary file of the calling thread
+@param[in,out]	jobs		the indexes to build
+@param[in]	n_jobs		number of elements in jobs
+@param[in]	pct_progress	total progress percent until now */
+static
+void
+row_merge_build_parallel(
+	trx_t*			trx,
+	const dict_table_t*	old_table,
+	struct TABLE*		table,
+	const ulint*		col_map,
+	ulint			space,
+	row_merge_block_t*	block,
+	row_merge_block_t*	crypt_block,
+	pfs_os_file_t*		tmpfd,
+	row_merge_job_t*	jobs,
+	ulint			n_jobs,
+	double			pct_progress)
+{
+	row_merge_jobs_t	shared;
+	ulint			n_unique = 0;
+
+	shared.trx = trx;
+	shared.old_table = old_table;
+	shared.col_map = col_map;
+	shared.path = thd_innodb_tmpdir(trx->mysql_thd);
+	shared.space = space;
+	shared.queue = static_cast<row_merge_job_t**>(
+		ut_malloc_nokey(n_jobs * sizeof *shared.queue));
+	shared.n_queue = 0;
+	shared.next = 0;
+	shared.n_failed = 0;
+	shared.n_running = 0;
+	shared.pct_done = 0;
+
+	for (ulint i = 0; i < n_jobs; i++) {
+		if (jobs[i].index == NULL) {
+			continue;
+		}
+
+		if (dict_index_is_unique(jobs[i].index)) {
+			n_unique++;
+		} else {
+			shared.queue[shared.n_queue++] = &jobs[i];
+		}
+	}
+
+	const ulint	n_threads = ut_min<ulint>(srv_ddl_threads,
+						  shared.n_queue + 1);
+
+	/* Give the remaining threads to the merge sort of each index. */
+	shared.n_sort_threads = ut_max<ulint>(srv_ddl_threads / n_threads, 1);
+
+	if (global_system_variables.log_warnings > 2) {
+		sql_print_information("InnoDB: Online DDL : Start building"
+				      " " ULINTPF " indexes using " ULINTPF
+				      " threads",
+				      n_unique + shared.n_queue, n_threads);
+	}
+
+	row_merge_job_thread_t*	thr = static_cast<row_merge_job_thread_t*>(
+		ut_zalloc_nokey(n_threads * sizeof *thr));
+	std::vector<os_thread_id_t>	threads(n_threads);
+	ulint				n_started = 1;
+
+	thr[0].jobs = &shared;
+	thr[0].buf.block = block;
+	thr[0].buf.crypt_block = crypt_block;
+	thr[0].tmpfd = *tmpfd;
+
+	for (; n_started < n_threads; n_started++) {
+		if (!row_merge_thread_buf_alloc(&thr[n_started].buf)) {
+			break;
+		}
+
+		thr[n_started].jobs = &shared;
+		thr[n_started].tmpfd = OS_FILE_CLOSED;
+		shared.n_running++;
+		os_thread_create(row_merge_build_thread, &thr[n_started],
+				 &threads[n_started]);
+	}
+
+	/* Build the unique indexes in order, so that the first duplicate
+	key value will be reported like in the serial build. */
+	for (ulint i = 0; i < n_jobs && !shared.n_failed; i++) {
+		if (jobs[i].index == NULL
+		    || !dict_index_is_unique(jobs[i].index)
+		    || trx_is_interrupted(trx)) {
+			continue;
+		}
+
+		row_merge_build_job(&thr[0], &jobs[i], table);
+		row_merge_report_progress(
+			trx, pct_progress + double(shared.pct_done) / 100);
+	}
+
+	/* Help the worker threads, and report their progress. */
+	row_merge_build_queued(&thr[0]);
+
+	while (shared.n_running) {
+		row_merge_report_progress(
+			trx, pct_progress + double(shared.pct_done) / 100);
+		os_thread_sleep(100000);
+	}
+
+	for (ulint i = 1; i < n_started; i++) {
+		os_thread_join(threads[i]);
+		row_merge_file_destroy_low(thr[i].tmpfd);
+		row_merge_thread_buf_free(&thr[i].buf);
+	}
+
+	*tmpfd = thr[0].tmpfd;
+
+	ut_free(thr);
+	ut_free(shared.queue);
+}
+
 /** Build indexes on a table by reading a clustered index, creating a temporary
 file containing index entries, merge sorting these index entries and inserting
 sorted index entries to indexes.
@@ -4534,6 +5167,7 @@ row_merge_build_indexes(
 	fts_psort_t*		merge_info = NULL;
 	int64_t			sig_count = 0;
 	bool			fts_psort_initiated = false;
+	row_merge_job_t*	jobs = NULL;
 
 	double total_static_cost = 0;
 	double total_dynamic_cost = 0;
@@ -4578,6 +5212,10 @@ row_merge_build_indexes(
 		}
 	}
 
+	if (trx->mysql_thd) {
+		thd_progress_init(trx->mysql_thd, 1);
+	}
+
 	trx_start_if_not_started_xa(trx, true);
 	ulint	n_merge_files = 0;
 
@@ -4688,8 +5326,46 @@ row_merge_build_indexes(
 
 	DEBUG_SYNC_C("row_merge_after_scan");
 
+	if (srv_ddl_threads > 1) {
+		ulint	n_jobs = 0;
+
+		jobs = static_cast<row_merge_job_t*>(
+			ut_zalloc_nokey(n_indexes * sizeof *jobs));
+
+		for (ulint k = 0, i = 0; i < n_indexes; i++) {
+			if (dict_index_is_spatial(indexes[i])) {
+				continue;
+			}
+
+			merge_file_t*	file = &merge_files[k++];
+
+			if ((indexes[i]->type & DICT_FTS)
+			    || file->fd == OS_FILE_CLOSED) {
+				continue;
+			}
+
+			jobs[i].index = indexes[i];
+			jobs[i].file = file;
+			jobs[i].pct_cost = (COST_BUILD_INDEX_STATIC +
+				(total_dynamic_cost * file->offset /
+					total_index_blocks)) /
+				(total_static_cost + total_dynamic_cost)
+				* (PCT_COST_MERGESORT_INDEX
+				   + PCT_COST_INSERT_INDEX) * 100;
+			n_jobs++;
+		}
+
+		if (n_jobs > 1) {
+			row_merge_build_parallel(
+				trx, old_table, table, col_map,
+				new_table->space_id, block, crypt_block,
+				&tmpfd, jobs, n_indexes, pct_progress);
+		}
+	}
+
 	/* Now we have files containing index entries ready for
-	sorting and inserting. */
+	sorting and inserting. Indexes that were built by
+	row_merge_build_parallel() only need to be finished. */
 
 	for (ulint k = 0, i = 0; i < n_indexes; i++) {
 		dict_index_t*	sort_idx = indexes[i];
@@ -4770,6 +5446,10 @@ row_merge_build_indexes(
 #ifdef FTS_INTERNAL_DIAG_PRINT
 			DEBUG_FTS_SORT_PRINT("FTS_SORT: Complete Insert\n");
 #endif
+		} else if (jobs != NULL && jobs[i].done) {
+			error = jobs[i].err;
+			pct_progress += jobs[i].pct_cost;
+			row_merge_report_progress(trx, pct_progress);
 		} else if (merge_files[k].fd != OS_FILE_CLOSED) {
 			char	buf[NAME_LEN + 1];
 			row_merge_dup_t	dup = {
@@ -4804,7 +5484,7 @@ row_merge_build_indexes(
 					block, &tmpfd, true,
 					pct_progress, pct_cost,
 					crypt_block, new_table->space_id,
-					stage);
+					stage, srv_ddl_threads);
 
 			pct_progress += pct_cost;
 
@@ -4934,6 +5614,7 @@ row_merge_build_indexes(
 	}
 
 	ut_free(merge_files);
+	ut_free(jobs);
 
 	alloc.deallocate_large(block, &block_pfx, block_size);
 
@@ -5014,5 +5695,316 @@ row_merge_build_indexes(
 		}
 	}
 
+	if (trx->mysql_thd) {
+		thd_progress_end(trx->mysql_thd);
+	}
+
 	DBUG_RETURN(error);
 }
+
+/** Add a copy of an index entry to a sort buffer.
+@param[in,out]	buf	sort buffer
+@param[in]	entry	index entry
+@return whether the entry fit in the buffer */
+static bool row_merge_buf_add_entry(row_merge_buf_t* buf,
+				    const dtuple_t& entry)
+{
+	const dict_index_t*	index = buf->index;
+	const ulint		n_fields = dict_index_get_n_fields(index);
+
+	ut_ad(dtuple_get_n_fields(&entry) == n_fields);
+
+	if (buf->n_tuples >= buf->max_tuples) {
+		return false;
+	}
+
+	ulint	extra_size;
+	ulint	size = rec_get_converted_size_temp<false>(
+		index, entry.fields, n_fields, &extra_size);
+
+	/* See row_merge_buf_write() for the variable-length encoding
+	of extra_size. */
+	size += 1 + ((extra_size + 1) >= 0x80);
+
+	/* Reserve bytes for the end marker of row_merge_block_t. */
+	if (buf->total_size + size >= srv_sort_buf_size) {
+		return false;
+	}
+
+	dfield_t*	fields = static_cast<dfield_t*>(
+		mem_heap_dup(buf->heap, entry.fields,
+			     n_fields * sizeof *fields));
+
+	for (ulint i = 0; i < n_fields; i++) {
+		dfield_dup(&fields[i], buf->heap);
+	}
+
+	buf->tuples[buf->n_tuples++].fields = fields;
+	buf->total_size += size;
+	return true;
+}
+
+/** Constructor
+@param[in]	table	table whose indexes are empty */
+row_merge_bulk_t::row_merge_bulk_t(dict_table_t* table)
+	: m_n_index(UT_LIST_GET_LEN(table->indexes)),
+	  m_tmpfd(OS_FILE_CLOSED), m_alloc(mem_key_row_merge_sort),
+	  m_block(NULL), m_crypt_block(NULL), m_autoinc(0)
+{
+	m_merge_buf = static_cast<row_merge_buf_t**>(
+		ut_malloc_nokey(m_n_index * sizeof *m_merge_buf));
+	m_merge_files = static_cast<merge_file_t*>(
+		ut_malloc_nokey(m_n_index * sizeof *m_merge_files));
+
+	ulint	i = 0;
+
+	for (dict_index_t* index = dict_table_get_first_index(table);
+	     index; index = dict_table_get_next_index(index), i++) {
+		ut_ad(!(index->type & (DICT_FTS | DICT_SPATIAL)));
+		m_merge_buf[i] = row_merge_buf_create(index);
+		m_merge_files[i].fd = OS_FILE_CLOSED;
+		m_merge_files[i].offset = 0;
+		m_merge_files[i].n_rec = 0;
+	}
+
+	ut_ad(i == m_n_index);
+}
+
+/** Destructor; discards any buffered entries */
+row_merge_bulk_t::~row_merge_bulk_t()
+{
+	for (ulint i = 0; i < m_n_index; i++) {
+		row_merge_buf_free(m_merge_buf[i]);
+		row_merge_file_destroy(&m_merge_files[i]);
+	}
+
+	row_merge_file_destroy_low(m_tmpfd);
+	ut_free(m_merge_files);
+	ut_free(m_merge_buf);
+
+	if (m_block) {
+		m_alloc.deallocate_large(m_block, &m_block_pfx,
+					 3 * srv_sort_buf_size);
+	}
+
+	if (m_crypt_block) {
+		m_alloc.deallocate_large(m_crypt_block, &m_crypt_pfx,
+					 3 * srv_sort_buf_size);
+	}
+}
+
+/** Allocate m_block and m_crypt_block if needed.
+@return whether the allocation succeeded */
+bool row_merge_bulk_t::alloc_block()
+{
+	if (!m_block) {
+		m_block = m_alloc.allocate_large(3 * srv_sort_buf_size,
+						 &m_block_pfx);
+		if (!m_block) {
+			return false;
+		}
+	}
+
+	if (!m_crypt_block && log_tmp_is_encrypted()) {
+		m_crypt_block = m_alloc.allocate_large(3 * srv_sort_buf_size,
+						       &m_crypt_pfx);
+		if (!m_crypt_block) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/** Sort a full sort buffer and write it as a run to the
+temporary file of the index.
+@param[in]	i	index number
+@param[in,out]	trx	transaction
+@return error code */
+dberr_t row_merge_bulk_t::write_to_tmp_file(ulint i, trx_t* trx)
+{
+	row_merge_buf_t*	buf = m_merge_buf[i];
+	merge_file_t*		file = &m_merge_files[i];
+
+	if (dict_index_is_unique(buf->index)) {
+		row_merge_dup_t	dup = {buf->index, NULL, NULL, 0};
+
+		row_merge_buf_sort(buf, &dup);
+
+		if (dup.n_dup) {
+			trx->error_info = buf->index;
+			return DB_DUPLICATE_KEY;
+		}
+	} else {
+		row_merge_buf_sort(buf, NULL);
+	}
+
+	if (!alloc_block()
+	    || !row_merge_file_create_if_needed(
+		    file, &m_tmpfd, 0, thd_innodb_tmpdir(trx->mysql_thd))) {
+		return DB_OUT_OF_MEMORY;
+	}
+
+	file->n_rec += buf->n_tuples;
+	row_merge_buf_write(buf, file, m_block);
+
+	if (!row_merge_write(file->fd, file->offset++, m_block,
+			     m_crypt_block, buf->index->table->space_id)) {
+		return DB_TEMP_FILE_WRITE_FAIL;
+	}
+
+	MEM_UNDEFINED(&m_block[0], srv_sort_buf_size);
+	m_merge_buf[i] = row_merge_buf_empty(buf);
+	return DB_SUCCESS;
+}
+
+/** Buffer an index entry.
+@param[in]	entry	index entry
+@param[in]	index	index of the entry
+@param[in,out]	trx	transaction
+@return error code */
+dberr_t
+row_merge_bulk_t::bulk_insert_buffered(const dtuple_t& entry,
+				       const dict_index_t& index, trx_t* trx)
+{
+	ulint	i = 0;
+
+	while (m_merge_buf[i]->index != &index) {
+		ut_ad(i + 1 < m_n_index);
+		i++;
+	}
+
+	if (index.is_primary() && index.table->persistent_autoinc) {
+		const dfield_t*	dfield = dtuple_get_nth_field(
+			&entry, index.table->persistent_autoinc - 1);
+
+		if (!dfield_is_null(dfield)) {
+			ib_uint64_t	autoinc = row_parse_int(
+				static_cast<const byte*>(dfield->data),
+				dfield->len, dfield->type.mtype,
+				dfield->type.prtype & DATA_UNSIGNED);
+			if (autoinc > m_autoinc) {
+				m_autoinc = autoinc;
+			}
+		}
+	}
+
+	if (row_merge_buf_add_entry(m_merge_buf[i], entry)) {
+		return DB_SUCCESS;
+	}
+
+	dberr_t	err = write_to_tmp_file(i, trx);
+
+	if (err == DB_SUCCESS
+	    && !row_merge_buf_add_entry(m_merge_buf[i], entry)) {
+		/* An empty buffer should have enough room for
+		at least one record. */
+		ut_ad(!"record does not fit in an empty sort buffer");
+		err = DB_TOO_BIG_RECORD;
+	}
+
+	return err;
+}
+
+/** Sort the entries of an index and load them into the index.
+@param[in]	i		index number
+@param[in,out]	trx		transaction
+@param[in,out]	mysql_table	MySQL table, or NULL
+@return error code */
+dberr_t row_merge_bulk_t::write_to_index(ulint i, trx_t* trx,
+					 struct TABLE* mysql_table)
+{
+	row_merge_buf_t*	buf = m_merge_buf[i];
+	merge_file_t*		file = &m_merge_files[i];
+	dict_index_t*		index = buf->index;
+	const ulint		space_id = index->table->space_id;
+	row_merge_dup_t		dup = {index, mysql_table, NULL, 0};
+	dberr_t			err = DB_SUCCESS;
+	BtrBulk			btr_bulk(index, trx, trx->get_flush_observer());
+
+	if (file->fd == OS_FILE_CLOSED) {
+		/* All entries fit in the sort buffer. */
+		row_merge_buf_sort(buf, dict_index_is_unique(index)
+				   ? &dup : NULL);
+
+		if (dup.n_dup) {
+			err = DB_DUPLICATE_KEY;
+		} else {
+			err = row_merge_insert_index_tuples(
+				index, index->table, OS_FILE_CLOSED, NULL,
+				buf, &btr_bulk, 0, 0, 0, NULL, space_id);
+		}
+	} else {
+		if (buf->n_tuples) {
+			err = write_to_tmp_file(i, trx);
+		}
+
+		if (err == DB_SUCCESS) {
+			err = row_merge_sort(trx, &dup, file, m_block,
+					     &m_tmpfd, false, 0, 0,
+					     m_crypt_block, space_id, NULL);
+		}
+
+		if (err == DB_SUCCESS) {
+			err = row_merge_insert_index_tuples(
+				index, index->table, file->fd, m_block, NULL,
+				&btr_bulk, 0, 0, 0, m_crypt_block, space_id);
+		}
+	}
+
+	err = btr_bulk.finish(err);
+
+	if (err == DB_DUPLICATE_KEY) {
+		trx->error_info = index;
+	}
+
+	return err;
+}
+
+/** Sort the buffered entries and load them into the indexes.
+@param[in,out]	table		table
+@param[in,out]	trx		transaction
+@param[in,out]	mysql_table	MySQL table for reporting duplicate
+				keys, or NULL
+@return error code */
+dberr_t row_merge_bulk_t::write_to_table(dict_table_t* table, trx_t* trx,
+					 struct TABLE* mysql_table)
+{
+	dberr_t	err = DB_SUCCESS;
+
+	ut_ad(!trx->get_flush_observer());
+
+	if (innodb_log_optimize_ddl) {
+		trx->set_flush_observer(table->space, NULL);
+	}
+
+	for (ulint i = 0; i < m_n_index && err == DB_SUCCESS; i++) {
+		if (m_merge_buf[i]->n_tuples
+		    || m_merge_files[i].fd != OS_FILE_CLOSED) {
+			err = write_to_index(i, trx, mysql_table);
+		}
+	}
+
+	if (FlushObserver* flush_observer = trx->get_flush_observer()) {
+		if (err != DB_SUCCESS) {
+			flush_observer->interrupted();
+		}
+
+		flush_observer->flush();
+
+		if (err == DB_SUCCESS) {
+			for (ulint i = 0; i < m_n_index; i++) {
+				row_merge_write_redo(m_merge_buf[i]->index);
+			}
+		}
+
+		trx->remove_flush_observer();
+	}
+
+	if (err == DB_SUCCESS && m_autoinc) {
+		btr_write_autoinc(dict_table_get_first_index(table),
+				  m_autoinc);
+	}
+
+	return err;
+}
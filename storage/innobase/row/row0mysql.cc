@@ -58,6 +58,7 @@ Created 9/17/2000 Heikki Tuuri
 #include "row0row.h"
 #include "row0sel.h"
 #include "row0upd.h"
+#include "row0vers.h"
 #include "trx0purge.h"
 #include "trx0rec.h"
 #include "trx0roll.h"
@@ -139,6 +140,31 @@ row_mysql_prebuilt_free_blob_heap(
 	DBUG_VOID_RETURN;
 }
 
+/** Free the prefetch cache of a table handle.
+@param[in,out]	prebuilt	prebuilt struct of a ha_innobase:: table handle */
+void row_mysql_prebuilt_free_fetch_cache(row_prebuilt_t* prebuilt)
+{
+	const byte*	ptr = reinterpret_cast<const byte*>(
+		prebuilt->fetch_cache + prebuilt->fetch_cache_alloc);
+
+	for (ulint i = 0; i < prebuilt->fetch_cache_alloc; i++) {
+		ulint	magic1 = mach_read_from_4(ptr);
+		ut_a(magic1 == ROW_PREBUILT_FETCH_MAGIC_N);
+		ptr += 4;
+
+		ut_a(ptr == prebuilt->fetch_cache[i]);
+		ptr += prebuilt->mysql_row_len;
+
+		ulint	magic2 = mach_read_from_4(ptr);
+		ut_a(magic2 == ROW_PREBUILT_FETCH_MAGIC_N);
+		ptr += 4;
+	}
+
+	ut_free(prebuilt->fetch_cache);
+	prebuilt->fetch_cache = NULL;
+	prebuilt->fetch_cache_alloc = 0;
+}
+
 /*******************************************************************//**
 Stores a >= 5.0.3 format true VARCHAR length to dest, in the MySQL row
 format.
@@ -936,6 +962,7 @@ row_create_prebuilt(
 	prebuilt->fts_doc_id = 0;
 
 	prebuilt->mysql_row_len = mysql_row_len;
+	prebuilt->fetch_cache_size = MYSQL_FETCH_CACHE_SIZE;
 
 	prebuilt->fts_doc_id_in_read_set = 0;
 	prebuilt->blob_heap = NULL;
@@ -984,25 +1011,8 @@ row_prebuilt_free(
 		mem_heap_free(prebuilt->old_vers_heap);
 	}
 
-	if (prebuilt->fetch_cache[0] != NULL) {
-		byte*	base = prebuilt->fetch_cache[0] - 4;
-		byte*	ptr = base;
-
-		for (ulint i = 0; i < MYSQL_FETCH_CACHE_SIZE; i++) {
-			ulint	magic1 = mach_read_from_4(ptr);
-			ut_a(magic1 == ROW_PREBUILT_FETCH_MAGIC_N);
-			ptr += 4;
-
-			byte*	row = ptr;
-			ut_a(row == prebuilt->fetch_cache[i]);
-			ptr += prebuilt->mysql_row_len;
-
-			ulint	magic2 = mach_read_from_4(ptr);
-			ut_a(magic2 == ROW_PREBUILT_FETCH_MAGIC_N);
-			ptr += 4;
-		}
-
-		ut_free(base);
+	if (prebuilt->fetch_cache != NULL) {
+		row_mysql_prebuilt_free_fetch_cache(prebuilt);
 	}
 
 	if (prebuilt->rtr_info) {
@@ -4625,6 +4635,57 @@ row_rename_table_for_mysql(
 	return(err);
 }
 
+/** Report an index record that is not in ascending order with respect to
+the preceding one, or that violates the uniqueness of the index.
+@param[in]	index		index
+@param[in]	prev_entry	the preceding index entry
+@param[in]	rec		index record
+@param[in]	offsets		rec_get_offsets(rec, index) */
+static
+void
+row_scan_check_order(
+	const dict_index_t*	index,
+	const dtuple_t*		prev_entry,
+	const rec_t*		rec,
+	const rec_offs*		offsets)
+{
+	ulint	matched_fields = 0;
+	int	cmp = cmp_dtuple_rec_with_match(prev_entry, rec, offsets,
+						&matched_fields);
+	bool	contains_null = false;
+	const ulint n_ordering = dict_index_get_n_ordering_defined_by_user(
+		index);
+
+	/* In a unique secondary index we allow equal key values if
+	they contain SQL NULLs */
+
+	for (ulint i = 0; i < n_ordering; i++) {
+		if (UNIV_SQL_NULL == dfield_get_len(
+			    dtuple_get_nth_field(prev_entry, i))) {
+			contains_null = true;
+			break;
+		}
+	}
+
+	const char* msg;
+
+	if (cmp > 0) {
+		msg = "index records in a wrong order in ";
+	} else if (dict_index_is_unique(index)
+		   && !contains_null
+		   && matched_fields >= n_ordering) {
+		msg = "duplicate key in ";
+	} else {
+		return;
+	}
+
+	ib::error()
+		<< msg << index->name
+		<< " of table " << index->table->name
+		<< ": " << *prev_entry << ", "
+		<< rec_offsets_print(rec, offsets);
+}
+
 /*********************************************************************//**
 Scans an index for either COUNT(*) or CHECK TABLE.
 If CHECK TABLE; Checks that the index contains entries in an ascending order,
@@ -4641,13 +4702,9 @@ row_scan_index_for_mysql(
 						seen in the consistent read */
 {
 	dtuple_t*	prev_entry	= NULL;
-	ulint		matched_fields;
 	byte*		buf;
 	dberr_t		ret;
 	rec_t*		rec;
-	int		cmp;
-	ibool		contains_null;
-	ulint		i;
 	ulint		cnt;
 	mem_heap_t*	heap		= NULL;
 	rec_offs	offsets_[REC_OFFS_NORMAL_SIZE];
@@ -4667,6 +4724,19 @@ row_scan_index_for_mysql(
 		indexes of the old table will remain valid and the new
 		table will be unaccessible to MySQL until the
 		completion of the ALTER TABLE. */
+		if (srv_parallel_scan_threads > 1
+		    && prebuilt->table->is_readable()) {
+			if (prebuilt->sql_stat_start) {
+				prebuilt->sql_stat_start = FALSE;
+				trx_start_if_not_started(prebuilt->trx, false);
+				prebuilt->trx->read_view.open(prebuilt->trx);
+			}
+
+			return(row_scan_clust_index_parallel(
+				       prebuilt->trx,
+				       const_cast<dict_index_t*>(index),
+				       true, n_rows));
+		}
 	} else if (dict_index_is_online_ddl(index)
 		   || (index->type & DICT_FTS)) {
 		/* Full Text index are implemented by auxiliary tables,
@@ -4729,47 +4799,7 @@ row_scan_index_for_mysql(
 				  ULINT_UNDEFINED, &heap);
 
 	if (prev_entry != NULL) {
-		matched_fields = 0;
-
-		cmp = cmp_dtuple_rec_with_match(prev_entry, rec, offsets,
-						&matched_fields);
-		contains_null = FALSE;
-
-		/* In a unique secondary index we allow equal key values if
-		they contain SQL NULLs */
-
-		for (i = 0;
-		     i < dict_index_get_n_ordering_defined_by_user(index);
-		     i++) {
-			if (UNIV_SQL_NULL == dfield_get_len(
-				    dtuple_get_nth_field(prev_entry, i))) {
-
-				contains_null = TRUE;
-				break;
-			}
-		}
-
-		const char* msg;
-
-		if (cmp > 0) {
-			ret = DB_INDEX_CORRUPT;
-			msg = "index records in a wrong order in ";
-not_ok:
-			ib::error()
-				<< msg << index->name
-				<< " of table " << index->table->name
-				<< ": " << *prev_entry << ", "
-				<< rec_offsets_print(rec, offsets);
-			/* Continue reading */
-		} else if (dict_index_is_unique(index)
-			   && !contains_null
-			   && matched_fields
-			   >= dict_index_get_n_ordering_defined_by_user(
-				   index)) {
-			ret = DB_DUPLICATE_KEY;
-			msg = "duplicate key in ";
-			goto not_ok;
-		}
+		row_scan_check_order(index, prev_entry, rec, offsets);
 	}
 
 	{
@@ -4804,6 +4834,488 @@ row_scan_index_for_mysql(
 	goto loop;
 }
 
+#ifdef UNIV_PFS_THREAD
+mysql_pfs_key_t	row_scan_thread_key;
+#endif /* UNIV_PFS_THREAD */
+
+/** Number of key ranges per thread in row_scan_clust_index_parallel(),
+so that a thread that finishes early can take over more work */
+static const ulint ROW_SCAN_RANGES_PER_THREAD = 4;
+
+/** A key range of a clustered index scanned by row_scan_clust_index_parallel()
+*/
+struct row_scan_range_t {
+	/** inclusive lower bound, or NULL for the start of the index */
+	const dtuple_t*	low;
+	/** exclusive upper bound, or NULL for the end of the index */
+	const dtuple_t*	high;
+	/** number of records seen in the consistent read */
+	ulint		n_rows;
+	/** status of the scan */
+	dberr_t		err;
+	/** memory heap for first and first_offsets, or NULL */
+	mem_heap_t*	first_heap;
+	/** copy of the first visible record in the range, or NULL */
+	const rec_t*	first;
+	/** rec_get_offsets(first) */
+	const rec_offs*	first_offsets;
+	/** memory heap for last, or NULL */
+	mem_heap_t*	last_heap;
+	/** the last visible index entry in the range, or NULL */
+	const dtuple_t*	last;
+};
+
+/** State shared by the threads of row_scan_clust_index_parallel() */
+struct row_scan_t {
+	/** the clustered index */
+	dict_index_t*		index;
+	/** the transaction, for checking whether it was interrupted */
+	const trx_t*		trx;
+	/** the consistent read view, or NULL to read the latest
+	version of each record */
+	ReadView*		view;
+	/** whether to check the order and uniqueness of the records */
+	bool			check;
+	/** the key ranges */
+	row_scan_range_t*	ranges;
+	/** number of key ranges */
+	ulint			n_ranges;
+	/** the next range to scan */
+	Atomic_counter<ulint>	next;
+	/** number of ranges whose scan failed */
+	Atomic_counter<ulint>	n_failed;
+};
+
+/** Determine the boundaries of the key ranges of a clustered index by
+sampling the node pointers of the upper levels of the B-tree. We descend
+from the root until a level contains enough node pointers, or until we
+reach the level above the leaves.
+@param[in]	index		clustered index
+@param[in]	n_ranges	desired number of key ranges
+@param[in,out]	heap		memory heap for the boundaries
+@param[out]	bounds		ascending boundaries of the key ranges */
+static
+void
+row_scan_sample_bounds(
+	dict_index_t*			index,
+	ulint				n_ranges,
+	mem_heap_t*			heap,
+	std::vector<const dtuple_t*>&	bounds)
+{
+	mtr_t		mtr;
+	mem_heap_t*	offsets_heap	= NULL;
+	rec_offs	offsets_[REC_OFFS_NORMAL_SIZE];
+	rec_offs*	offsets		= offsets_;
+	rec_offs_init(offsets_);
+
+	const ulint	n_uniq		= dict_index_get_n_unique_in_tree(index);
+	std::vector<const dtuple_t*>	keys;
+	std::vector<ulint>		children;
+
+	mtr.start();
+	mtr_s_lock_index(index, &mtr);
+
+	buf_block_t*	block = btr_root_block_get(index, RW_S_LATCH, &mtr);
+
+	if (!block) {
+		mtr.commit();
+		return;
+	}
+
+	std::vector<buf_block_t*>	blocks(1, block);
+	ulint	level = btr_page_get_level(block->frame);
+
+	while (level) {
+		keys.clear();
+		children.clear();
+
+		for (ulint b = 0; b < blocks.size(); b++) {
+			const page_t*	page = blocks[b]->frame;
+			const bool	comp = page_is_comp(page);
+
+			for (const rec_t* rec = page_rec_get_next_const(
+				     page_get_infimum_rec(page));
+			     !page_rec_is_supremum(rec);
+			     rec = page_rec_get_next_const(rec)) {
+				offsets = rec_get_offsets(
+					rec, index, offsets, 0,
+					ULINT_UNDEFINED, &offsets_heap);
+				children.push_back(
+					btr_node_ptr_get_child_page_no(
+						rec, offsets));
+
+				if (rec_get_info_bits(rec, comp)
+				    & REC_INFO_MIN_REC_FLAG) {
+					/* The leftmost node pointer on
+					each level bounds nothing. */
+					continue;
+				}
+
+				dtuple_t*	key = dtuple_create(heap, n_uniq);
+				dict_index_copy_types(key, index, n_uniq);
+				rec_copy_prefix_to_dtuple(
+					key, rec, index, 0, n_uniq, heap);
+				key->info_bits = 0;
+				keys.push_back(key);
+			}
+		}
+
+		if (keys.size() + 1 >= n_ranges || --level == 0) {
+			break;
+		}
+
+		blocks.clear();
+
+		for (ulint c = 0; c < children.size(); c++) {
+			block = btr_block_get(
+				page_id_t(index->table->space_id,
+					  children[c]),
+				index->table->space->zip_size(),
+				RW_S_LATCH, index, &mtr);
+
+			if (!block) {
+				keys.clear();
+				goto func_exit;
+			}
+
+			blocks.push_back(block);
+		}
+	}
+
+	/* Pick evenly spaced boundaries among the sampled keys. */
+	if (keys.size() + 1 <= n_ranges) {
+		bounds = keys;
+	} else {
+		for (ulint i = 1; i < n_ranges; i++) {
+			bounds.push_back(keys[i * keys.size() / n_ranges]);
+		}
+	}
+
+func_exit:
+	mtr.commit();
+
+	if (offsets_heap) {
+		mem_heap_free(offsets_heap);
+	}
+}
+
+/** Scan a key range of a clustered index.
+@param[in]	scan	scan state
+@param[in,out]	range	key range
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_scan_range(const row_scan_t* scan, row_scan_range_t* range)
+{
+	dict_index_t*	index		= scan->index;
+	const bool	comp		= dict_table_is_comp(index->table);
+	mem_heap_t*	heap		= NULL;
+	mem_heap_t*	vers_heap	= mem_heap_create(UNIV_PAGE_SIZE_MIN);
+	dtuple_t*	prev_entry	= NULL;
+	dberr_t		err		= DB_SUCCESS;
+	btr_pcur_t	pcur;
+	mtr_t		mtr;
+	rec_offs	offsets_[REC_OFFS_NORMAL_SIZE];
+	rec_offs*	offsets		= offsets_;
+	rec_offs_init(offsets_);
+
+	mtr.start();
+
+	if (range->low) {
+		/* Position the cursor before the first record in the
+		range. */
+		btr_pcur_open(index, range->low, PAGE_CUR_L, BTR_SEARCH_LEAF,
+			      &pcur, &mtr);
+	} else {
+		btr_pcur_open_at_index_side(
+			true, index, BTR_SEARCH_LEAF, &pcur, true, 0, &mtr);
+	}
+
+	for (;;) {
+		if (btr_pcur_is_after_last_on_page(&pcur)) {
+			if (btr_pcur_is_after_last_in_tree(&pcur)) {
+				break;
+			}
+
+			if (UNIV_UNLIKELY(trx_is_interrupted(scan->trx))) {
+				err = DB_INTERRUPTED;
+				break;
+			}
+
+			if (scan->n_failed) {
+				/* The scan of another range failed, and
+				row_scan_clust_index_parallel() will
+				return its error. */
+				break;
+			}
+
+			if (heap) {
+				/* Release the offsets of old versions. */
+				mem_heap_empty(heap);
+				offsets = offsets_;
+			}
+
+			if (index->lock.waiters) {
+				/* Yield to the waiters on the index
+				tree lock, like row_merge_read_clustered_index()
+				does. */
+				btr_pcur_move_to_prev_on_page(&pcur);
+				btr_pcur_store_position(&pcur, &mtr);
+				mtr.commit();
+				os_thread_yield();
+				mtr.start();
+				btr_pcur_restore_position(
+					BTR_SEARCH_LEAF, &pcur, &mtr);
+				continue;
+			}
+
+			btr_pcur_move_to_next_page(&pcur, &mtr);
+
+			if (UNIV_UNLIKELY(btr_pcur_is_after_last_on_page(
+						  &pcur))) {
+				err = index->table->is_readable()
+					? DB_CORRUPTION
+					: DB_DECRYPTION_FAILED;
+				break;
+			}
+		}
+
+		btr_pcur_move_to_next_on_page(&pcur);
+
+		if (!btr_pcur_is_on_user_rec(&pcur)) {
+			continue;
+		}
+
+		const rec_t*	rec = btr_pcur_get_rec(&pcur);
+
+		if (rec_is_metadata(rec, *index)) {
+			continue;
+		}
+
+		offsets = rec_get_offsets(rec, index, offsets,
+					  index->n_core_fields,
+					  ULINT_UNDEFINED, &heap);
+
+		if (range->high
+		    && cmp_dtuple_rec(range->high, rec, offsets) <= 0) {
+			break;
+		}
+
+		if (scan->view
+		    && !lock_clust_rec_cons_read_sees(
+			    rec, index, offsets, scan->view)) {
+			rec_t*	old_vers;
+
+			mem_heap_empty(vers_heap);
+			err = row_vers_build_for_consistent_read(
+				rec, &mtr, index, &offsets, scan->view,
+				&heap, vers_heap, &old_vers, NULL);
+
+			if (err != DB_SUCCESS) {
+				break;
+			}
+
+			if (!old_vers) {
+				/* The record did not exist in the
+				read view. */
+				continue;
+			}
+
+			rec = old_vers;
+		}
+
+		if (rec_get_deleted_flag(rec, comp)) {
+			continue;
+		}
+
+		range->n_rows++;
+
+		if (!scan->check) {
+			continue;
+		}
+
+		if (prev_entry) {
+			row_scan_check_order(index, prev_entry, rec, offsets);
+			mem_heap_empty(range->last_heap);
+		} else {
+			/* Remember the first record, so that the caller
+			can check the order across the range boundary. */
+			range->first_heap = mem_heap_create(
+				rec_offs_size(offsets)
+				+ rec_offs_get_n_alloc(offsets)
+				* sizeof *offsets);
+			byte*	buf = static_cast<byte*>(mem_heap_alloc(
+				range->first_heap, rec_offs_size(offsets)));
+			range->first = rec_copy(buf, rec, offsets);
+			range->first_offsets = rec_get_offsets(
+				range->first, index, NULL,
+				index->n_core_fields, ULINT_UNDEFINED,
+				&range->first_heap);
+			range->last_heap = mem_heap_create(100);
+		}
+
+		prev_entry = row_rec_to_index_entry(
+			rec, index, offsets, range->last_heap);
+	}
+
+	mtr.commit();
+	btr_pcur_close(&pcur);
+
+	range->last = prev_entry;
+
+	mem_heap_free(vers_heap);
+
+	if (heap) {
+		mem_heap_free(heap);
+	}
+
+	return(err);
+}
+
+/** Scan key ranges of a clustered index until all of them have been
+assigned to a thread.
+@param[in,out]	scan	scan state */
+static
+void
+row_scan_ranges(row_scan_t* scan)
+{
+	while (!scan->n_failed) {
+		ulint	i = scan->next++;
+
+		if (i >= scan->n_ranges) {
+			break;
+		}
+
+		row_scan_range_t*	range = &scan->ranges[i];
+
+		range->err = row_scan_range(scan, range);
+
+		if (range->err != DB_SUCCESS) {
+			scan->n_failed++;
+		}
+	}
+}
+
+/** Thread that scans key ranges of a clustered index on behalf of
+row_scan_clust_index_parallel().
+@param[in]	arg	row_scan_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_scan_thread)(void* arg)
+{
+	my_thread_init();
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(row_scan_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	row_scan_ranges(static_cast<row_scan_t*>(arg));
+
+	my_thread_end();
+	/* row_scan_clust_index_parallel() will join this thread. */
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Count the records of a clustered index that are visible in the read
+view of a transaction. The index is divided into key ranges by sampling
+the upper levels of the B-tree, and the ranges are scanned by up to
+innodb_parallel_scan_threads threads.
+@param[in]	trx	transaction whose read view is being used
+@param[in]	index	clustered index
+@param[in]	check	whether to check the order and uniqueness
+			of the records (CHECK TABLE)
+@param[out]	n_rows	number of records seen in the consistent read
+@return DB_SUCCESS or error code */
+dberr_t
+row_scan_clust_index_parallel(
+	const trx_t*	trx,
+	dict_index_t*	index,
+	bool		check,
+	ulint*		n_rows)
+{
+	ut_ad(index->is_primary());
+
+	*n_rows = 0;
+
+	ulint		n_threads	= srv_parallel_scan_threads;
+	mem_heap_t*	heap		= mem_heap_create(1024);
+	std::vector<const dtuple_t*>	bounds;
+
+	row_scan_sample_bounds(index, n_threads * ROW_SCAN_RANGES_PER_THREAD,
+			       heap, bounds);
+
+	row_scan_t	scan;
+	scan.index = index;
+	scan.trx = trx;
+	scan.view = trx->isolation_level == TRX_ISO_READ_UNCOMMITTED
+		|| index->table->no_rollback()
+		? NULL
+		: const_cast<ReadView*>(&trx->read_view);
+	scan.check = check;
+	scan.next = 0;
+	scan.n_failed = 0;
+	scan.n_ranges = bounds.size() + 1;
+	scan.ranges = static_cast<row_scan_range_t*>(
+		mem_heap_zalloc(heap, scan.n_ranges * sizeof *scan.ranges));
+
+	for (ulint i = 0; i < scan.n_ranges; i++) {
+		row_scan_range_t&	range = scan.ranges[i];
+		range.low = i ? bounds[i - 1] : NULL;
+		range.high = i < bounds.size() ? bounds[i] : NULL;
+		range.err = DB_SUCCESS;
+	}
+
+	n_threads = ut_min(n_threads, scan.n_ranges);
+
+	std::vector<os_thread_id_t>	threads(n_threads);
+
+	for (ulint i = 1; i < n_threads; i++) {
+		os_thread_create(row_scan_thread, &scan, &threads[i]);
+	}
+
+	row_scan_ranges(&scan);
+
+	for (ulint i = 1; i < n_threads; i++) {
+		os_thread_join(threads[i]);
+	}
+
+	dberr_t			err	= DB_SUCCESS;
+	const row_scan_range_t*	prev	= NULL;
+
+	for (ulint i = 0; i < scan.n_ranges; i++) {
+		row_scan_range_t&	range = scan.ranges[i];
+
+		if (err == DB_SUCCESS) {
+			err = range.err;
+		}
+
+		*n_rows += range.n_rows;
+
+		if (range.first) {
+			if (prev && err == DB_SUCCESS) {
+				row_scan_check_order(index, prev->last,
+						     range.first,
+						     range.first_offsets);
+			}
+
+			prev = &range;
+		}
+	}
+
+	for (ulint i = 0; i < scan.n_ranges; i++) {
+		if (scan.ranges[i].first_heap) {
+			mem_heap_free(scan.ranges[i].first_heap);
+			mem_heap_free(scan.ranges[i].last_heap);
+		}
+	}
+
+	mem_heap_free(heap);
+
+	return(err);
+}
+
 /*********************************************************************//**
 Initialize this module */
 void
@@ -3806,7 +3806,7 @@ row_sel_dequeue_cached_row_for_mysql(
 }
 
 /********************************************************************//**
-Initialise the prefetch cache. */
+Initialise the prefetch cache for prebuilt->fetch_cache_size rows. */
 UNIV_INLINE
 void
 row_sel_prefetch_cache_init(
@@ -3817,11 +3817,23 @@ row_sel_prefetch_cache_init(
 	ulint	sz;
 	byte*	ptr;
 
-	/* Reserve space for the magic number. */
-	sz = UT_ARR_SIZE(prebuilt->fetch_cache) * (prebuilt->mysql_row_len + 8);
-	ptr = static_cast<byte*>(ut_malloc_nokey(sz));
+	ut_ad(prebuilt->n_fetch_cached == 0);
 
-	for (i = 0; i < UT_ARR_SIZE(prebuilt->fetch_cache); i++) {
+	if (prebuilt->fetch_cache) {
+		row_mysql_prebuilt_free_fetch_cache(prebuilt);
+	}
+
+	prebuilt->fetch_cache_alloc = prebuilt->fetch_cache_size;
+
+	/* Reserve space for the pointers and the magic numbers. */
+	sz = prebuilt->fetch_cache_alloc
+		* (sizeof *prebuilt->fetch_cache
+		   + prebuilt->mysql_row_len + 8);
+	prebuilt->fetch_cache = static_cast<byte**>(ut_malloc_nokey(sz));
+	ptr = reinterpret_cast<byte*>(
+		prebuilt->fetch_cache + prebuilt->fetch_cache_alloc);
+
+	for (i = 0; i < prebuilt->fetch_cache_alloc; i++) {
 
 		/* A user has reported memory corruption in these
 		buffers in Linux. Put magic numbers there to help
@@ -3838,6 +3850,25 @@ row_sel_prefetch_cache_init(
 	}
 }
 
+/** Double the number of rows to prefetch in the next batch, after
+the current batch filled up the prefetch cache. The cache is reallocated
+in row_sel_fetch_last_buf() once the current batch has been consumed.
+@param[in,out]	prebuilt	prebuilt struct */
+static void row_sel_prefetch_cache_grow(row_prebuilt_t* prebuilt)
+{
+	ulint	max_size = MYSQL_FETCH_CACHE_MAX_BYTES
+		/ (prebuilt->mysql_row_len + 8);
+
+	if (max_size > MYSQL_FETCH_CACHE_MAX_SIZE) {
+		max_size = MYSQL_FETCH_CACHE_MAX_SIZE;
+	}
+
+	if (prebuilt->fetch_cache_size < max_size) {
+		prebuilt->fetch_cache_size = std::min(
+			prebuilt->fetch_cache_size * 2, max_size);
+	}
+}
+
 /********************************************************************//**
 Get the last fetch cache buffer from the queue.
 @return pointer to buffer. */
@@ -3848,10 +3879,11 @@ row_sel_fetch_last_buf(
 	row_prebuilt_t*	prebuilt)	/*!< in/out: prebuilt struct */
 {
 	ut_ad(!prebuilt->templ_contains_blob);
-	ut_ad(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+	ut_ad(prebuilt->n_fetch_cached < prebuilt->fetch_cache_size);
 
-	if (prebuilt->fetch_cache[0] == NULL) {
-		/* Allocate memory for the fetch cache */
+	if (prebuilt->fetch_cache_alloc < prebuilt->fetch_cache_size) {
+		/* Allocate memory for the fetch cache, or grow it
+		before starting a new batch */
 		ut_ad(prebuilt->n_fetch_cached == 0);
 
 		row_sel_prefetch_cache_init(prebuilt);
@@ -4361,6 +4393,7 @@ row_search_mvcc(
 		prebuilt->n_rows_fetched = 0;
 		prebuilt->n_fetch_cached = 0;
 		prebuilt->fetch_cache_first = 0;
+		prebuilt->fetch_cache_size = MYSQL_FETCH_CACHE_SIZE;
 
 		if (prebuilt->sel_graph == NULL) {
 			/* Build a dummy select query graph */
@@ -4385,18 +4418,22 @@ row_search_mvcc(
 			prebuilt->n_rows_fetched = 0;
 			prebuilt->n_fetch_cached = 0;
 			prebuilt->fetch_cache_first = 0;
+			prebuilt->fetch_cache_size = MYSQL_FETCH_CACHE_SIZE;
 
 		} else if (UNIV_LIKELY(prebuilt->n_fetch_cached > 0)) {
 			row_sel_dequeue_cached_row_for_mysql(buf, prebuilt);
 
 			prebuilt->n_rows_fetched++;
+			trx->n_prefetch_hits++;
+			srv_stats.n_prefetch_hits.inc();
 
 			err = DB_SUCCESS;
 			goto func_exit;
 		}
 
 		if (prebuilt->fetch_cache_first > 0
-		    && prebuilt->fetch_cache_first < MYSQL_FETCH_CACHE_SIZE) {
+		    && prebuilt->fetch_cache_first
+		    < prebuilt->fetch_cache_size) {
 
 			/* The previous returned row was popped from the fetch
 			cache, but the cache was not full at the time of the
@@ -5505,7 +5542,7 @@ row_search_mvcc(
 		not cache rows because there the cursor is a scrollable
 		cursor. */
 
-		ut_a(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+		ut_a(prebuilt->n_fetch_cached < prebuilt->fetch_cache_size);
 
 		/* We only convert from InnoDB row format to MySQL row
 		format when ICP is disabled. */
@@ -5557,10 +5594,14 @@ row_search_mvcc(
 			row_sel_enqueue_cache_row_for_mysql(buf, prebuilt);
 		}
 
-		if (prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE) {
+		if (prebuilt->n_fetch_cached < prebuilt->fetch_cache_size) {
 			goto next_rec;
 		}
 
+		/* The batch filled up the cache. If the caller keeps
+		consuming it, prefetch more rows in the next batch. */
+		row_sel_prefetch_cache_grow(prebuilt);
+
 	} else {
 		if (UNIV_UNLIKELY
 		    (prebuilt->template_type == ROW_MYSQL_DUMMY_TEMPLATE)) {
@@ -5855,6 +5896,13 @@ row_search_mvcc(
 		err = DB_SUCCESS;
 	}
 
+	/* The scan started with an empty cache. Whatever is left in it
+	was fetched ahead of the row that is being returned. */
+	if (ulint n = prebuilt->n_fetch_cached) {
+		trx->n_rows_prefetched += n;
+		srv_stats.n_rows_prefetched.add(n);
+	}
+
 #ifdef UNIV_DEBUG
 	if (dict_index_is_spatial(index) && err != DB_SUCCESS
 	    && err != DB_END_OF_INDEX && err != DB_INTERRUPTED) {
@@ -404,6 +404,7 @@ static bool row_undo_ins_parse_undo_rec(undo_node_t* node, bool dict_locked)
 		goto close_table;
 	case TRX_UNDO_INSERT_METADATA:
 	case TRX_UNDO_INSERT_REC:
+	case TRX_UNDO_EMPTY:
 		break;
 	case TRX_UNDO_RENAME_TABLE:
 		dict_table_t* table = node->table;
@@ -440,7 +441,11 @@ static bool row_undo_ins_parse_undo_rec(undo_node_t* node, bool dict_locked)
 		clust_index = dict_table_get_first_index(node->table);
 
 		if (clust_index != NULL) {
-			if (node->rec_type == TRX_UNDO_INSERT_REC) {
+			if (node->rec_type == TRX_UNDO_EMPTY) {
+				/* All indexes will be emptied. */
+				ut_ad(!node->table->is_temporary());
+				return true;
+			} else if (node->rec_type == TRX_UNDO_INSERT_REC) {
 				ptr = trx_undo_rec_get_row_ref(
 					ptr, clust_index, &node->ref,
 					node->heap);
@@ -616,6 +621,25 @@ row_undo_ins(
 		log_free_check();
 		ut_ad(!node->table->is_temporary());
 		err = row_undo_ins_remove_clust_rec(node);
+		break;
+
+	case TRX_UNDO_EMPTY:
+		/* The table was empty when this transaction started
+		inserting into it under an exclusive table lock, and
+		the inserts were not undo logged. Empty all indexes. */
+		for (; node->index; node->index = dict_table_get_next_index(
+			     node->index)) {
+			if (!(node->index->type & DICT_FTS)
+			    && !node->index->is_corrupted()) {
+				log_free_check();
+				btr_clear(node->index);
+			}
+		}
+
+		if (node->table->stat_initialized) {
+			node->table->stat_n_rows = 0;
+		}
+		err = DB_SUCCESS;
 	}
 
 	dict_table_close(node->table, dict_locked, FALSE);
@@ -2468,6 +2468,8 @@ row_upd_sec_index_entry(
 			if (err != DB_SUCCESS) {
 				break;
 			}
+
+			index->stat_modified_counter++;
 #ifdef WITH_WSREP
 			if (!referenced && foreign
 			    && wsrep_must_process_fk(node, trx)
@@ -3071,6 +3073,10 @@ row_upd_del_mark_clust_rec(
 		btr_cur_get_block(btr_cur), rec,
 		index, offsets, thr, node->row, mtr);
 
+	if (err == DB_SUCCESS) {
+		index->stat_modified_counter++;
+	}
+
 	if (err != DB_SUCCESS) {
 	} else if (referenced) {
 		/* NOTE that the following call loses the position of pcur ! */
@@ -154,6 +154,8 @@ ibool	srv_locks_unsafe_for_binlog;
 ulong	srv_sort_buf_size;
 /** Maximum modification log file size for online index creation */
 unsigned long long	srv_online_max_size;
+/** innodb_ddl_threads */
+ulong	srv_ddl_threads = 4;
 
 /* If this flag is TRUE, then we will use the native aio of the
 OS (provided we compiled Innobase with it in), otherwise we will
@@ -245,6 +247,12 @@ ulint	srv_lock_table_size	= ULINT_MAX;
 ulong	srv_n_read_io_threads;
 /** innodb_write_io_threads */
 ulong	srv_n_write_io_threads;
+/** innodb_recovery_threads */
+ulong	srv_n_recovery_threads = 4;
+/** innodb_parallel_scan_threads */
+ulong	srv_parallel_scan_threads = 1;
+/** innodb_stats_analyze_threads */
+ulong	srv_stats_analyze_threads = 4;
 
 /** innodb_random_read_ahead */
 my_bool	srv_random_read_ahead;
@@ -364,6 +372,12 @@ number of pages to use in LRU and flush_list batch flushing.
 The rest of the doublewrite buffer is used for single-page flushing. */
 ulong	srv_doublewrite_batch_size = 120;
 
+/** innodb_doublewrite_files: number of doublewrite files per buffer pool
+instance, or 0 to use the doublewrite buffer in the system tablespace */
+ulong	srv_doublewrite_files;
+/** innodb_doublewrite_pages: number of pages in each doublewrite file */
+ulong	srv_doublewrite_pages = 256;
+
 /** innodb_replication_delay */
 ulong	srv_replication_delay;
 
@@ -615,6 +629,10 @@ os_event_t	srv_buf_resize_event;
 
 /** The buffer pool dump/load file name */
 char*	srv_buf_dump_filename;
+/** innodb_buffer_pool_dump_format */
+ulong	srv_buf_dump_format;
+/** innodb_buffer_pool_load_threads */
+ulong	srv_buf_load_threads = 4;
 
 /** Boolean config knobs that tell InnoDB to dump the buffer pool at shutdown
 and/or load it during startup. */
@@ -1602,6 +1620,8 @@ srv_export_innodb_status(void)
 		crypt_stat.pages_modified;
 	export_vars.innodb_encryption_rotation_pages_flushed =
 		crypt_stat.pages_flushed;
+	export_vars.innodb_encryption_rotation_pages_skipped =
+		crypt_stat.pages_skipped;
 	export_vars.innodb_encryption_rotation_estimated_iops =
 		crypt_stat.estimated_iops;
 	export_vars.innodb_encryption_key_requests =
@@ -2543,16 +2563,23 @@ static size_t srv_do_purge(ulint* n_total_purged
 	}
 
 	do {
-		if (trx_sys.rseg_history_len > rseg_history_len
-		    || (srv_max_purge_lag > 0
-			&& rseg_history_len > srv_max_purge_lag)) {
+		if (srv_max_purge_lag > 0
+		    && trx_sys.rseg_history_len > srv_max_purge_lag) {
+
+			/* Use all threads before trx_purge_dml_delay()
+			starts to delay DML. */
+
+			n_use_threads = n_threads;
+
+		} else if (trx_sys.rseg_history_len > rseg_history_len) {
 
 			/* History length is now longer than what it was
-			when we took the last snapshot. Use more threads. */
+			when we took the last snapshot. Double the number
+			of threads, so that a burst of history (typically
+			for a single hot table) is caught up quickly. */
 
-			if (n_use_threads < n_threads) {
-				++n_use_threads;
-			}
+			n_use_threads = std::min(2 * n_use_threads,
+						 n_threads);
 
 		} else if (srv_check_activity(old_activity_count)
 			   && n_use_threads > 1) {
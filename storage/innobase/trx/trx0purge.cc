@@ -172,6 +172,7 @@ void purge_sys_t::create()
   offset= 0;
   hdr_page_no= 0;
   hdr_offset= 0;
+  heap= mem_heap_create(srv_page_size);
   rw_lock_create(trx_purge_latch_key, &latch, SYNC_PURGE_LATCH);
   mutex_create(LATCH_ID_PURGE_SYS_PQ, &pq_mutex);
   truncate.current= NULL;
@@ -192,6 +193,7 @@ void purge_sys_t::close()
   ut_ad(trx->state == TRX_STATE_ACTIVE);
   trx->state= TRX_STATE_NOT_STARTED;
   trx->free();
+  mem_heap_free(heap);
   rw_lock_free(&latch);
   mutex_free(&pq_mutex);
   os_event_destroy(event);
@@ -1076,19 +1078,75 @@ trx_purge_fetch_next_rec(
 	return(trx_purge_get_next_rec(n_pages_handled, heap));
 }
 
+/** Determine which purge thread should process an undo log record.
+The records are partitioned by table and by the first column of the
+PRIMARY KEY, so that the history of a single table can be purged by
+all purge threads, while all records that refer to the same clustered
+index record are processed by the same thread.
+@param[in]	undo_rec	undo log record
+@param[in]	n_purge_threads	number of purge threads
+@return purge thread number, less than n_purge_threads */
+static ulint trx_purge_rec_partition(trx_undo_rec_t* undo_rec,
+				     ulint n_purge_threads)
+{
+	ulint		type;
+	ulint		cmpl_info;
+	bool		updated_extern;
+	undo_no_t	undo_no;
+	table_id_t	table_id;
+	trx_id_t	trx_id;
+	roll_ptr_t	roll_ptr;
+	ulint		info_bits;
+
+	const byte*	ptr = trx_undo_rec_get_pars(
+		undo_rec, &type, &cmpl_info, &updated_extern,
+		&undo_no, &table_id);
+	ulint		fold = ut_fold_ull(table_id);
+
+	switch (type) {
+	case TRX_UNDO_INSERT_METADATA:
+		/* The record ends after the table_id,
+		see trx_undo_page_report_insert(). */
+	case TRX_UNDO_RENAME_TABLE:
+	case TRX_UNDO_EMPTY:
+		return(fold % n_purge_threads);
+	case TRX_UNDO_INSERT_REC:
+		break;
+	default:
+		ptr = trx_undo_update_rec_get_sys_cols(
+			ptr, &trx_id, &roll_ptr, &info_bits);
+	}
+
+	const byte*	field;
+	ulint		len;
+	ulint		orig_len;
+
+	trx_undo_rec_get_col_val(ptr, &field, &len, &orig_len);
+
+	if (len != UNIV_SQL_NULL) {
+		fold = ut_fold_ulint_pair(fold, ut_fold_binary(field, len));
+	}
+
+	return(fold % n_purge_threads);
+}
+
 /** Run a purge batch.
 @param n_purge_threads	number of purge threads
+@param heap		memory heap for the copies of the undo log records,
+which must not be freed before the batch has been completed
 @return number of undo log pages handled in the batch */
 static
 ulint
-trx_purge_attach_undo_recs(ulint n_purge_threads)
+trx_purge_attach_undo_recs(ulint n_purge_threads, mem_heap_t* heap)
 {
 	que_thr_t*	thr;
+	que_thr_t*	thrs[srv_max_purge_threads];
 	ulint		i;
 	ulint		n_pages_handled = 0;
 	ulint		n_thrs = UT_LIST_GET_LEN(purge_sys.query->thrs);
 
 	ut_a(n_purge_threads > 0);
+	ut_a(n_purge_threads <= srv_max_purge_threads);
 
 	purge_sys.head = purge_sys.tail;
 
@@ -1120,6 +1178,13 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 	thr = UT_LIST_GET_FIRST(purge_sys.query->thrs);
 	ut_a(n_thrs > 0 && thr != NULL);
 
+	for (i = 0; i < n_purge_threads; i++) {
+		ut_a(thr != NULL);
+		ut_a(!thr->is_active);
+		thrs[i] = thr;
+		thr = UT_LIST_GET_NEXT(thrs, thr);
+	}
+
 	ut_ad(purge_sys.head <= purge_sys.tail);
 
 	i = 0;
@@ -1127,17 +1192,8 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 	const ulint batch_size = srv_purge_batch_size;
 
 	while (UNIV_LIKELY(srv_undo_sources) || !srv_fast_shutdown) {
-		purge_node_t*		node;
-		trx_purge_rec_t*	purge_rec;
-
-		ut_a(!thr->is_active);
-
-		/* Get the purge node. */
-		node = (purge_node_t*) thr->child;
-		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
-
-		purge_rec = static_cast<trx_purge_rec_t*>(
-			mem_heap_zalloc(node->heap, sizeof(*purge_rec)));
+		roll_ptr_t		roll_ptr;
+		trx_undo_rec_t*		undo_rec;
 
 		/* Track the max {trx_id, undo_no} for truncating the
 		UNDO logs once we have purged the records. */
@@ -1147,37 +1203,43 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 		}
 
 		/* Fetch the next record, and advance the purge_sys.tail. */
-		purge_rec->undo_rec = trx_purge_fetch_next_rec(
-			&purge_rec->roll_ptr, &n_pages_handled, node->heap);
-
-		if (purge_rec->undo_rec != NULL) {
-
-			if (node->undo_recs == NULL) {
-				node->undo_recs = ib_vector_create(
-					ib_heap_allocator_create(node->heap),
-					sizeof(trx_purge_rec_t),
-					batch_size);
-			} else {
-				ut_a(!ib_vector_is_empty(node->undo_recs));
-			}
+		undo_rec = trx_purge_fetch_next_rec(
+			&roll_ptr, &n_pages_handled, heap);
 
-			ib_vector_push(node->undo_recs, purge_rec);
+		if (undo_rec == NULL) {
+			break;
+		}
 
-			if (n_pages_handled >= batch_size) {
+		/* Skipped undo logs can be handled by any thread. */
+		thr = thrs[undo_rec == &trx_purge_dummy_rec
+			   ? i++ % n_purge_threads
+			   : trx_purge_rec_partition(undo_rec,
+						     n_purge_threads)];
 
-				break;
-			}
+		/* Get the purge node. */
+		purge_node_t*	node = (purge_node_t*) thr->child;
+		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
+
+		trx_purge_rec_t*	purge_rec = static_cast<trx_purge_rec_t*>(
+			mem_heap_zalloc(node->heap, sizeof(*purge_rec)));
+
+		purge_rec->undo_rec = undo_rec;
+		purge_rec->roll_ptr = roll_ptr;
+
+		if (node->undo_recs == NULL) {
+			node->undo_recs = ib_vector_create(
+				ib_heap_allocator_create(node->heap),
+				sizeof(trx_purge_rec_t),
+				batch_size);
 		} else {
-			break;
+			ut_a(!ib_vector_is_empty(node->undo_recs));
 		}
 
-		thr = UT_LIST_GET_NEXT(thrs, thr);
+		ib_vector_push(node->undo_recs, purge_rec);
 
-		if (!(++i % n_purge_threads)) {
-			thr = UT_LIST_GET_FIRST(purge_sys.query->thrs);
+		if (n_pages_handled >= batch_size) {
+			break;
 		}
-
-		ut_a(thr != NULL);
 	}
 
 	ut_ad(purge_sys.head <= purge_sys.tail);
@@ -1185,13 +1247,14 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 	return(n_pages_handled);
 }
 
-/*******************************************************************//**
-Calculate the DML delay required.
-@return delay in microseconds or ULINT_MAX */
+/** Calculate the DML delay required. As the history grows,
+srv_do_purge() will first use more purge threads; DML statements
+are only delayed when all innodb_purge_threads are already in use.
+@param[in]	n_purge_threads	number of purge threads for the batch
+@return delay in microseconds */
 static
 ulint
-trx_purge_dml_delay(void)
-/*=====================*/
+trx_purge_dml_delay(ulint n_purge_threads)
 {
 	/* Determine how much data manipulation language (DML) statements
 	need to be delayed in order to reduce the lagging of the purge
@@ -1207,7 +1270,7 @@ trx_purge_dml_delay(void)
 
 		ratio = float(trx_sys.rseg_history_len) / srv_max_purge_lag;
 
-		if (ratio > 1.0) {
+		if (ratio > 1.0 && n_purge_threads >= srv_n_purge_threads) {
 			/* If the history list length exceeds the
 			srv_max_purge_lag, the data manipulation
 			statements are delayed by at least 5000
@@ -1265,7 +1328,7 @@ trx_purge(
 
 	ut_a(n_purge_threads > 0);
 
-	srv_dml_needed_delay = trx_purge_dml_delay();
+	srv_dml_needed_delay = trx_purge_dml_delay(n_purge_threads);
 
 	/* All submitted tasks should be completed. */
 	ut_ad(purge_sys.n_tasks.load(std::memory_order_relaxed) == 0);
@@ -1281,7 +1344,8 @@ trx_purge(
 #endif /* UNIV_DEBUG */
 
 	/* Fetch the UNDO recs that need to be purged. */
-	n_pages_handled = trx_purge_attach_undo_recs(n_purge_threads);
+	n_pages_handled = trx_purge_attach_undo_recs(n_purge_threads,
+						     purge_sys.heap);
 	purge_sys.n_tasks.store(n_purge_threads - 1, std::memory_order_relaxed);
 
 	/* Submit tasks to workers queue if using multi-threaded purge. */
@@ -1300,6 +1364,8 @@ trx_purge(
 
 	ut_ad(purge_sys.n_tasks.load(std::memory_order_relaxed) == 0);
 
+	mem_heap_empty(purge_sys.heap);
+
 	if (truncate) {
 		trx_purge_truncate_history();
 	}
@@ -480,7 +480,8 @@ trx_undo_page_report_insert(
 	trx_t*		trx,		/*!< in: transaction */
 	dict_index_t*	index,		/*!< in: clustered index */
 	const dtuple_t*	clust_entry,	/*!< in: index entry which will be
-					inserted to the clustered index */
+					inserted to the clustered index,
+					or NULL to write TRX_UNDO_EMPTY */
 	mtr_t*		mtr)		/*!< in: mtr */
 {
 	ulint		first_free;
@@ -514,6 +515,11 @@ trx_undo_page_report_insert(
 	/*----------------------------------------*/
 	/* Store then the fields required to uniquely determine the record
 	to be inserted in the clustered index */
+	if (UNIV_UNLIKELY(!clust_entry)) {
+		undo_block->frame[first_free + 2] = TRX_UNDO_EMPTY;
+		goto done;
+	}
+
 	if (UNIV_UNLIKELY(clust_entry->info_bits != 0)) {
 		ut_ad(clust_entry->is_metadata());
 		ut_ad(index->is_instant());
@@ -1886,7 +1892,9 @@ trx_undo_report_row_operation(
 	dict_index_t*	index,		/*!< in: clustered index */
 	const dtuple_t*	clust_entry,	/*!< in: in the case of an insert,
 					index entry to insert into the
-					clustered index; in updates,
+					clustered index, or NULL to write
+					TRX_UNDO_EMPTY before a bulk insert
+					into an empty table; in updates,
 					may contain a clustered index
 					record tuple that also contains
 					virtual columns of the table;
@@ -1919,10 +1927,23 @@ trx_undo_report_row_operation(
 	ut_ad(trx_state_eq(trx, TRX_STATE_ACTIVE));
 	ut_ad(!trx->in_rollback);
 
+	const bool	is_temp	= index->table->is_temporary();
+
+	if (!rec && !is_temp && clust_entry) {
+		trx_mod_tables_t::const_iterator t
+			= trx->mod_tables.find(index->table);
+		if (t != trx->mod_tables.end() && t->second.is_bulk_insert()) {
+			/* The table was empty when the current statement
+			started inserting into it. Any rollback will empty
+			the table by TRX_UNDO_EMPTY. */
+			*roll_ptr = roll_ptr_t(1) << ROLL_PTR_INSERT_FLAG_POS;
+			return DB_SUCCESS;
+		}
+	}
+
 	mtr.start();
 	trx_undo_t**	pundo;
 	trx_rseg_t*	rseg;
-	const bool	is_temp	= index->table->is_temporary();
 
 	if (is_temp) {
 		mtr.set_log_mode(MTR_LOG_NO_REDO);
@@ -2007,6 +2028,10 @@ trx_undo_report_row_operation(
 					.first->second;
 				ut_ad(time.valid(limit));
 
+				if (!clust_entry && !rec) {
+					time.start_bulk_insert();
+				}
+
 				if (!time.is_versioned()
 				    && index->table->versioned_by_id()
 				    && (!rec /* INSERT */
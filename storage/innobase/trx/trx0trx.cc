@@ -37,6 +37,7 @@ Created 3/26/1996 Heikki Tuuri
 #include "log0log.h"
 #include "os0proc.h"
 #include "que0que.h"
+#include "row0merge.h"
 #include "srv0mon.h"
 #include "srv0srv.h"
 #include "srv0start.h"
@@ -125,6 +126,8 @@ trx_init(
 
 	trx->check_unique_secondary = true;
 
+	trx->bulk_insert = false;
+
 	trx->lock.n_rec_locks = 0;
 
 	trx->dict_operation = TRX_DICT_OP_NONE;
@@ -371,6 +374,9 @@ trx_t *trx_create()
 
 	trx->autoinc_locks = ib_vector_create(alloc, sizeof(void**), 4);
 
+	trx->n_rows_prefetched = 0;
+	trx->n_prefetch_hits = 0;
+
 	ut_ad(trx->mod_tables.empty());
 	ut_ad(trx->lock.n_rec_locks == 0);
 	ut_ad(trx->lock.table_cached == 0);
@@ -442,6 +448,7 @@ void trx_t::free()
   MEM_NOACCESS(&flush_log_later, sizeof flush_log_later);
   MEM_NOACCESS(&must_flush_log_later, sizeof must_flush_log_later);
   MEM_NOACCESS(&duplicates, sizeof duplicates);
+  MEM_NOACCESS(&bulk_insert, sizeof bulk_insert);
   MEM_NOACCESS(&dict_operation, sizeof dict_operation);
   MEM_NOACCESS(&declared_to_be_inside_innodb, sizeof declared_to_be_inside_innodb);
   MEM_NOACCESS(&n_tickets_to_enter_innodb, sizeof n_tickets_to_enter_innodb);
@@ -594,6 +601,8 @@ trx_resurrect_table_locks(
 	page_t*			undo_page;
 	trx_undo_rec_t*		undo_rec;
 	table_id_set		tables;
+	/** tables for which TRX_UNDO_EMPTY was written */
+	table_id_set		emptied;
 
 	ut_ad(trx_state_eq(trx, TRX_STATE_ACTIVE) ||
 	      trx_state_eq(trx, TRX_STATE_PREPARED));
@@ -631,6 +640,9 @@ trx_resurrect_table_locks(
 			undo_rec, &type, &cmpl_info,
 			&updated_extern, &undo_no, &table_id);
 		tables.insert(table_id);
+		if (type == TRX_UNDO_EMPTY) {
+			emptied.insert(table_id);
+		}
 
 		undo_rec = trx_undo_get_prev_rec(
 			undo_rec, undo->hdr_page_no,
@@ -656,11 +668,14 @@ trx_resurrect_table_locks(
 					trx_mod_tables_t::value_type(table,
 								     0));
 			}
-			lock_table_ix_resurrect(table, trx);
+			const bool empty = emptied.count(*i) != 0;
+			lock_table_resurrect(table, trx,
+					     empty ? LOCK_X : LOCK_IX);
 
 			DBUG_LOG("ib_trx",
 				 "resurrect " << ib::hex(trx->id)
-				 << " IX lock on " << table->name);
+				 << (empty ? " X" : " IX") << " lock on "
+				 << table->name);
 
 			dict_table_close(table, FALSE, FALSE);
 		}
@@ -921,6 +936,49 @@ void trx_t::remove_flush_observer()
 	flush_observer = NULL;
 }
 
+/** Resume undo logging after the bulk insert statement,
+discarding any buffered index entries */
+void trx_mod_table_time_t::end_bulk_insert()
+{
+	UT_DELETE(bulk_store);
+	bulk_store = NULL;
+	bulk_insert = false;
+}
+
+/** Load the buffered bulk inserts into the indexes and resume
+undo logging for the tables. Besides the table of the statement,
+other tables may have been bulk inserted into by triggers.
+@param[in]	table		table whose MySQL handle is mysql_table,
+				or NULL
+@param[in,out]	mysql_table	MySQL table for reporting duplicate
+				keys, or NULL
+@return error code */
+dberr_t trx_t::bulk_insert_apply(const dict_table_t* table,
+				 struct TABLE* mysql_table)
+{
+	dberr_t	err = DB_SUCCESS;
+
+	for (trx_mod_tables_t::iterator t = mod_tables.begin();
+	     t != mod_tables.end(); t++) {
+		if (!t->second.is_bulk_insert()) {
+			continue;
+		}
+
+		if (row_merge_bulk_t* store = t->second.bulk_store) {
+			if (err == DB_SUCCESS) {
+				err = store->write_to_table(
+					t->first, this,
+					t->first == table
+					? mysql_table : NULL);
+			}
+		}
+
+		t->second.end_bulk_insert();
+	}
+
+	return err;
+}
+
 /** Assign a rollback segment for modifying temporary tables.
 @return the assigned rollback segment */
 trx_rseg_t *trx_t::assign_temp_rseg()
@@ -0,0 +1,143 @@
+#include "my_global.h"
+#include "my_sys.h"
+#include "lf.h"
+#include "tap.h"
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+/*
+  Microbenchmark for read view creation.
+
+  Mimics trx_sys_t::snapshot_ids(): active transaction identifiers are kept
+  in a lock-free hash, and a snapshot either iterates the hash and sorts the
+  collected identifiers, or reuses the identifiers of the previous snapshot
+  when the change counter has not moved since they were collected.
+  The timings are reported as diagnostics. The visibility of the reused
+  identifiers is covered by the test innodb.read_view_reuse.
+*/
+
+typedef ulonglong trx_id_t;
+typedef std::vector<trx_id_t> trx_ids_t;
+
+struct element_t
+{
+  trx_id_t id; /* lf_hash_init() relies on this to be first in the struct */
+  trx_id_t no;
+};
+
+static LF_HASH hash;
+static std::atomic<trx_id_t> max_trx_id;
+static std::atomic<trx_id_t> changes;
+
+struct view_t
+{
+  trx_ids_t ids;
+  trx_id_t low_limit_id= 0;
+  trx_id_t low_limit_no= 0;
+  trx_id_t version= ~trx_id_t(0);
+};
+
+struct copy_arg
+{
+  trx_ids_t *ids;
+  trx_id_t id;
+  trx_id_t no;
+};
+
+static my_bool copy_one_id(void *el, void *a)
+{
+  const element_t *element= static_cast<const element_t*>(el);
+  copy_arg *arg= static_cast<copy_arg*>(a);
+  if (element->id < arg->id)
+  {
+    arg->ids->push_back(element->id);
+    if (element->no < arg->no)
+      arg->no= element->no;
+  }
+  return 0;
+}
+
+static void snapshot(LF_PINS *pins, view_t *view, bool reuse)
+{
+  const trx_id_t id= max_trx_id.load(std::memory_order_acquire);
+  const trx_id_t c= changes.load(std::memory_order_acquire);
+  if (reuse && c == view->version)
+  {
+    if (view->low_limit_no >= view->low_limit_id)
+      view->low_limit_no= id;
+    view->low_limit_id= id;
+    return;
+  }
+  copy_arg arg= {&view->ids, id, id};
+  view->ids.clear();
+  view->ids.reserve(lf_hash_size(&hash) + 32);
+  lf_hash_iterate(&hash, pins, copy_one_id, &arg);
+  std::sort(view->ids.begin(), view->ids.end());
+  view->low_limit_id= id;
+  view->low_limit_no= arg.no;
+  view->version= c;
+}
+
+static void add_trx(LF_PINS *pins)
+{
+  element_t e= {max_trx_id++, ~trx_id_t(0)};
+  lf_hash_insert(&hash, pins, &e);
+  changes.fetch_add(1, std::memory_order_release);
+}
+
+static void remove_trx(LF_PINS *pins, trx_id_t id)
+{
+  lf_hash_delete(&hash, pins, &id, sizeof id);
+  changes.fetch_add(1, std::memory_order_release);
+}
+
+static ulonglong bench(LF_PINS *pins, bool reuse, uint rounds)
+{
+  view_t view;
+  ulonglong start= my_interval_timer();
+  for (uint i= rounds; i--; )
+    snapshot(pins, &view, reuse);
+  return (my_interval_timer() - start) / rounds;
+}
+
+int main(int, char **argv)
+{
+  static const uint n_active[]= {0, 16, 256, 4096};
+  static const uint rounds= 1000;
+
+  MY_INIT(argv[0]);
+  plan(1);
+
+  lf_hash_init(&hash, sizeof(element_t), LF_HASH_UNIQUE, 0,
+               sizeof(trx_id_t), 0, &my_charset_bin);
+  LF_PINS *pins= lf_hash_get_pins(&hash);
+  max_trx_id= 1;
+
+  uint n= 0;
+  for (uint i= 0; i < array_elements(n_active); i++)
+  {
+    while (n < n_active[i])
+    {
+      add_trx(pins);
+      n++;
+    }
+    ulonglong iterate= bench(pins, false, rounds);
+    ulonglong reused= bench(pins, true, rounds);
+    diag("%u active transactions: %llu ns per view (iterate), "
+         "%llu ns per view (reuse)", n, iterate, reused);
+  }
+
+  /* A reused snapshot must notice transactions that ended meanwhile. */
+  view_t view;
+  snapshot(pins, &view, true);
+  const size_t before= view.ids.size();
+  remove_trx(pins, view.ids.front());
+  snapshot(pins, &view, true);
+  ok(view.ids.size() == before - 1, "snapshot invalidated by commit");
+
+  lf_hash_put_pins(pins);
+  lf_hash_destroy(&hash);
+  my_end(0);
+  return exit_status();
+}
@@ -0,0 +1,165 @@
+/*
+   Copyright (c) 2024, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA */
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <tap.h>
+#include "filesort_utils.h"
+
+/*
+  Tests and a benchmark of radixsort_for_sort_keys().
+
+  The keys are stored in one buffer like the keys of a sort buffer, and
+  sorted through an array of pointers. The result is compared with that
+  of my_qsort2(), which Filesort_buffer::sort_buffer() uses otherwise.
+  The benchmark times both methods and reports the results as
+  diagnostics.
+*/
+
+enum key_kind
+{
+  KEYS_RANDOM,         /* distinct keys with random bytes */
+  KEYS_FEW_DISTINCT,   /* many duplicates */
+  KEYS_COMMON_PREFIX   /* distinct keys after 12 equal bytes */
+};
+
+static const char *key_kind_name[]=
+{ "random", "few distinct", "common prefix" };
+
+static ulonglong rnd_state= 1;
+
+static uint rnd()
+{
+  rnd_state= rnd_state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return (uint) (rnd_state >> 33);
+}
+
+static uchar *make_keys(uint count, size_t length, key_kind kind)
+{
+  uchar *data= (uchar*) my_malloc(count * length, MYF(MY_FAE));
+  for (uint i= 0; i < count; i++)
+  {
+    uchar *key= data + i * length;
+    uint value= kind == KEYS_FEW_DISTINCT ? rnd() % 100 : rnd();
+    for (size_t j= 0; j < length; j++)
+      key[j]= kind == KEYS_COMMON_PREFIX && j < 12 ? 'a' :
+              kind == KEYS_FEW_DISTINCT ? (uchar) (value >> (j % 4 * 2)) :
+              (uchar) rnd();
+  }
+  return data;
+}
+
+static void init_pointers(uchar **keys, uchar *data, uint count,
+                          size_t length)
+{
+  for (uint i= 0; i < count; i++)
+    keys[i]= data + i * length;
+}
+
+static void qsort_keys(uchar **keys, uint count, size_t length)
+{
+  my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(length), &length);
+}
+
+/* Sort the keys both ways and check that the order is the same */
+static void test_sort(uint count, size_t length, key_kind kind)
+{
+  uchar *data= make_keys(count, length, kind);
+  uchar **expected= (uchar**) my_malloc(count * sizeof(uchar*), MYF(MY_FAE));
+  uchar **keys= (uchar**) my_malloc(count * sizeof(uchar*), MYF(MY_FAE));
+  Sort_key_ref *buffer= (Sort_key_ref*) my_malloc(count * sizeof *buffer,
+                                                  MYF(MY_FAE));
+
+  init_pointers(expected, data, count, length);
+  qsort_keys(expected, count, length);
+  init_pointers(keys, data, count, length);
+  radixsort_for_sort_keys(keys, count, length, buffer);
+
+  bool sorted= true;
+  for (uint i= 0; sorted && i < count; i++)
+    sorted= !memcmp(keys[i], expected[i], length);
+
+  /* Every key must occur once. */
+  bool permutation= true;
+  bzero(buffer, count * sizeof *buffer);
+  for (uint i= 0; permutation && i < count; i++)
+  {
+    size_t pos= (keys[i] - data) / length;
+    permutation= !buffer[pos].key;
+    buffer[pos].key= keys[i];
+  }
+
+  ok(sorted && permutation, "%u %s keys of length %u", count,
+     key_kind_name[kind], (uint) length);
+
+  my_free(buffer);
+  my_free(keys);
+  my_free(expected);
+  my_free(data);
+}
+
+static void bench_sort(uint count, size_t length)
+{
+  uchar *data= make_keys(count, length, KEYS_RANDOM);
+  uchar **keys= (uchar**) my_malloc(count * sizeof(uchar*), MYF(MY_FAE));
+  Sort_key_ref *buffer= (Sort_key_ref*) my_malloc(count * sizeof *buffer,
+                                                  MYF(MY_FAE));
+
+  init_pointers(keys, data, count, length);
+  ulonglong start= my_interval_timer();
+  qsort_keys(keys, count, length);
+  ulonglong qsort_time= my_interval_timer() - start;
+
+  init_pointers(keys, data, count, length);
+  start= my_interval_timer();
+  radixsort_for_sort_keys(keys, count, length, buffer);
+  ulonglong radix_time= my_interval_timer() - start;
+
+  diag("%u keys of length %u: %llu ns per key (my_qsort2), "
+       "%llu ns per key (radixsort_for_sort_keys)", count, (uint) length,
+       qsort_time / count, radix_time / count);
+
+  my_free(buffer);
+  my_free(keys);
+  my_free(data);
+}
+
+int main(int, char **argv)
+{
+  static const size_t lengths[]= {3, 8, 16, 40};
+  static const key_kind kinds[]=
+  { KEYS_RANDOM, KEYS_FEW_DISTINCT, KEYS_COMMON_PREFIX };
+  static const uint bench_counts[]= {100000, 1000000, 4000000};
+  static const size_t bench_lengths[]= {8, 40};
+
+  MY_INIT(argv[0]);
+  plan(array_elements(lengths) * array_elements(kinds) + 2);
+
+  for (uint i= 0; i < array_elements(lengths); i++)
+    for (uint j= 0; j < array_elements(kinds); j++)
+      test_sort(200000, lengths[i], kinds[j]);
+
+  /* Buckets that are sorted by insertion sort only */
+  test_sort(20, 16, KEYS_RANDOM);
+  test_sort(1000, 16, KEYS_FEW_DISTINCT);
+
+  for (uint i= 0; i < array_elements(bench_counts); i++)
+    for (uint j= 0; j < array_elements(bench_lengths); j++)
+      bench_sort(bench_counts[i], bench_lengths[j]);
+
+  my_end(0);
+  return exit_status();
+}